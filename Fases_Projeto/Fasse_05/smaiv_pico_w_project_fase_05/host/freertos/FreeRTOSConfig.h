@@ -0,0 +1,76 @@
+/**
+ * @file FreeRTOSConfig.h
+ * @brief Configuração do kernel para a variante SMAIV_FREERTOS no host (port POSIX).
+ * @details Usado pelo alvo smaiv_sim_rtos (host/CMakeLists.txt), no lugar de
+ *          src/FreeRTOSConfig.h. O port POSIX tem um único núcleo e executa cada
+ *          tarefa em uma thread; o tick vem de um temporizador do sistema, em tempo
+ *          real. Sem SMP, a afinidade das tarefas pedida pelo firmware é ignorada.
+ */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+// --- Escalonador ---
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    8
+#define configMINIMAL_STACK_SIZE                ((configSTACK_DEPTH_TYPE)4096)
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TIME_SLICING                  1
+#define configNUMBER_OF_CORES                   1
+
+// --- Sincronização ---
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    0
+#define configUSE_APPLICATION_TASK_TAG          0
+#define configENABLE_BACKWARD_COMPATIBILITY     1
+
+// --- Memória (heap_4: o firmware consulta o heap livre no log de saúde) ---
+#define configSTACK_DEPTH_TYPE                  uint32_t
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   ((size_t)(8 * 1024 * 1024))
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+// --- Depuração ---
+#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+#define configGENERATE_RUN_TIME_STATS           0
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+// --- Temporizadores de software ---
+#define configUSE_CO_ROUTINES                   0
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+#include <assert.h>
+#define configASSERT(x)                         assert(x)
+
+// --- Funções da API incluídas ---
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+
+/**
+ * @brief Um núcleo só: a afinidade pedida pelo firmware (Core 0/Core 1) não se aplica.
+ */
+#define vTaskCoreAffinitySet(task, mask)        ((void)(task), (void)(mask))
+
+#endif
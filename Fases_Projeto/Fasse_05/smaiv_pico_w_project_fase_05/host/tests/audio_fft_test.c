@@ -0,0 +1,60 @@
+/**
+ * @file audio_fft_test.c
+ * @brief Teste da FFT em ponto fixo: escala de potência e saturação da entrada.
+ * @details Um tom no centro de um bin deve aparecer nesse bin com a potência A^2/2
+ *          (via AUDIO_FFT_POWER_TO_LSB2). Um tom que passa de 12 bits deve ser
+ *          ceifado, e não ter o sinal invertido: a fundamental não pode cair abaixo
+ *          da de um tom dentro da faixa.
+ */
+#include <math.h>
+#include "modules/audio_processing/audio_fft.h"
+#include "test_util.h"
+
+#define TONE_BIN 16
+
+static int16_t samples[AUDIO_FFT_SIZE];
+static uint32_t power[AUDIO_FFT_BINS];
+
+static void tone(float amplitude) {
+    for (int n = 0; n < AUDIO_FFT_SIZE; n++) {
+        float v = amplitude * sinf(6.28318530718f * TONE_BIN * n / AUDIO_FFT_SIZE);
+        samples[n] = (int16_t)lroundf(v);
+    }
+    audio_fft_power(samples, power);
+}
+
+static uint32_t peak_bin(void) {
+    uint32_t best = 0;
+    for (uint32_t k = 1; k < AUDIO_FFT_BINS; k++) {
+        if (power[k] > power[best]) best = k;
+    }
+    return best;
+}
+
+static float tone_power_lsb2(void) {
+    // A janela de Hann espalha o tom pelo bin central e os dois vizinhos.
+    uint64_t sum = (uint64_t)power[TONE_BIN - 1] + power[TONE_BIN] + power[TONE_BIN + 1];
+    return sum * AUDIO_FFT_POWER_TO_LSB2;
+}
+
+int main(void) {
+    audio_fft_init();
+
+    tone(2000.0f);
+    CHECK_EQ_INT(peak_bin(), TONE_BIN);
+    CHECK_NEAR(tone_power_lsb2(), 2000.0 * 2000.0 / 2, 2000.0 * 2000.0 / 2 * 0.02);
+    uint32_t in_range = power[TONE_BIN];
+
+    tone(4000.0f);
+    CHECK_EQ_INT(peak_bin(), TONE_BIN);
+    CHECK(power[TONE_BIN] >= in_range);
+
+    // Fundo de escala negativo exato (-2048) não satura.
+    for (int n = 0; n < AUDIO_FFT_SIZE; n++) {
+        samples[n] = (n & 1) ? -2048 : 0;
+    }
+    audio_fft_power(samples, power);
+    CHECK(power[AUDIO_FFT_BINS - 1] > 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,24 @@
+/* Gerado por tools/pack_sound_model.py - nao editar. */
+#include <stdint.h>
+
+__attribute__((aligned(4))) const uint8_t sound_model_blob[208] = {
+    0x53, 0x4d, 0x4e, 0x4e, 0x01, 0x03, 0x04, 0x80, 0x08, 0x00, 0x03, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x03, 0x01, 0x08, 0x00, 0x03, 0x00,
+    0x06, 0x00, 0x03, 0x00, 0xec, 0x06, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
+    0x70, 0x00, 0x00, 0x00, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x02, 0x02, 0x06, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00,
+    0x04, 0xe2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x88, 0x00, 0x00, 0x00,
+    0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x03, 0x00, 0x01, 0x00, 0x04, 0x00, 0xfd, 0x09, 0x00, 0x00,
+    0x67, 0x44, 0x69, 0x6f, 0x9c, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0c, 0xd8, 0x7f, 0x80, 0x21, 0x05, 0x46, 0x5a,
+    0xbe, 0x00, 0x00, 0x00, 0x2c, 0xea, 0xff, 0xff, 0xd0, 0x24, 0x00, 0x00,
+    0x32, 0x21, 0x00, 0x00, 0x01, 0xff, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00,
+    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00,
+    0x0a, 0xec, 0x1e, 0xd8, 0x32, 0xc4, 0x46, 0xb0, 0x5a, 0x81, 0x7f, 0x81,
+    0x7f, 0x81, 0x7f, 0x81, 0x7f, 0x81, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64,
+    0x20, 0x03, 0x00, 0x00, 0x74, 0xee, 0xff, 0xff, 0x4c, 0xff, 0xff, 0xff,
+    0x6a, 0xff, 0xff, 0xff,
+};
+const uint32_t sound_model_blob_size = 208;
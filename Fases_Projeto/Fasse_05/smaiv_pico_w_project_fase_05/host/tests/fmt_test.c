@@ -0,0 +1,108 @@
+/**
+ * @file fmt_test.c
+ * @brief Teste da formatação sem printf contra o snprintf da libc do host.
+ * @details fmt_float() tem de produzir o mesmo texto que "%.Nf" para qualquer float
+ *          finito: padrões de bits aleatórios cobrem subnormais, frações e inteiros
+ *          acima de 2^63, além de casos escolhidos (empates de arredondamento, -0,
+ *          FLT_MAX). Os inteiros com largura, o ponto fixo e o truncamento do buffer
+ *          são conferidos com valores conhecidos.
+ */
+#include <float.h>
+#include <string.h>
+#include "modules/fmt/fmt.h"
+#include "test_util.h"
+
+#define RANDOM_FLOATS 200000
+
+static uint32_t seed = 5;
+
+static uint32_t rnd32(void) {
+    seed = seed * 1664525u + 1013904223u;
+    uint32_t hi = seed >> 16;
+    seed = seed * 1664525u + 1013904223u;
+    return (hi << 16) | (seed >> 16);
+}
+
+static int mismatches;
+
+static void check_float(float x, uint8_t decimals) {
+    char got[64], expected[64];
+    fmt_t f;
+    fmt_init(&f, got, sizeof(got));
+    fmt_float(&f, x, decimals);
+    snprintf(expected, sizeof(expected), "%.*f", decimals, (double)x);
+    test_checks++;
+    if (strcmp(got, expected) != 0 || f.truncated) {
+        test_failures++;
+        if (++mismatches <= 10) {
+            printf("fmt_float(%.9g, %u) = \"%s\", esperado \"%s\"\n", (double)x, decimals, got, expected);
+        }
+    }
+}
+
+static void check_text(const char *got, const char *expected) {
+    test_checks++;
+    if (strcmp(got, expected) != 0) {
+        test_failures++;
+        printf("\"%s\", esperado \"%s\"\n", got, expected);
+    }
+}
+
+int main(void) {
+    static const float cases[] = {
+        0.0f, -0.0f, 0.5f, 1.5f, 2.5f, -0.5f, 0.05f, 0.125f, 0.0625f, -0.04f, 999.95f,
+        1e-45f, 1.17549435e-38f, 16777216.0f, 4294967296.0f, 9.22337204e18f,
+        1.8446744e19f, -3.0e25f, 1e38f, FLT_MAX, -FLT_MAX,
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        for (uint8_t d = 0; d <= 6; d++) {
+            check_float(cases[i], d);
+        }
+    }
+    for (int i = 0; i < RANDOM_FLOATS; i++) {
+        uint32_t bits = rnd32();
+        float x;
+        memcpy(&x, &bits, sizeof(x));
+        if (((bits >> 23) & 0xFFu) == 0xFFu) {
+            continue;                       // NaN/inf: conferidos abaixo.
+        }
+        check_float(x, (uint8_t)(rnd32() % 7));
+    }
+    printf("fmt_float: %d divergencias do snprintf\n", mismatches);
+
+    char buf[64];
+    fmt_t f;
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_float(&f, 1.0f / 0.0f, 1);
+    fmt_char(&f, ' ');
+    fmt_float(&f, -1.0f / 0.0f, 1);
+    fmt_char(&f, ' ');
+    fmt_float(&f, 0.0f / 0.0f, 1);
+    check_text(buf, "inf -inf nan");
+
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_i32_pad(&f, -42, 5, '0');
+    fmt_char(&f, '|');
+    fmt_i32_pad(&f, -42, 5, ' ');
+    fmt_char(&f, '|');
+    fmt_i32(&f, INT32_MIN);
+    fmt_char(&f, '|');
+    fmt_u32_pad(&f, UINT32_MAX, 3, ' ');
+    check_text(buf, "-0042|  -42|-2147483648|4294967295");
+
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_fixed(&f, -1234, 2);
+    fmt_char(&f, ' ');
+    fmt_fixed(&f, 5, 1);
+    fmt_char(&f, ' ');
+    fmt_fixed(&f, -5, 3);
+    check_text(buf, "-12.34 0.5 -0.005");
+
+    // O que não cabe é descartado, e o buffer continua terminado em zero.
+    fmt_init(&f, buf, 6);
+    fmt_str(&f, "abcdefgh");
+    check_text(buf, "abcde");
+    CHECK(f.truncated);
+
+    return TEST_RESULT();
+}
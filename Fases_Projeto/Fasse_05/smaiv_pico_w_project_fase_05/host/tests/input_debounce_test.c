@@ -0,0 +1,154 @@
+/**
+ * @file input_debounce_test.c
+ * @brief Teste da máquina de debounce: sequências de bordas com repique.
+ * @details Cada caso é um roteiro de bordas brutas aplicado a um relógio de 1 ms,
+ *          com input_debounce_poll() chamado a cada passo (como a tarefa de entrada,
+ *          só que mais fino). Os eventos produzidos, com o instante em que saíram,
+ *          são comparados com a lista esperada.
+ */
+#include <stddef.h>
+#include "config.h"
+#include "modules/input_events/input_debounce.h"
+#include "test_util.h"
+
+#define MAX_EVENTS 16
+
+typedef struct {
+    uint32_t at_ms;     ///< Instante da borda bruta.
+    bool pressed;
+} edge_t;
+
+typedef struct {
+    uint8_t type;
+    uint32_t time_ms;   ///< Carimbo do evento.
+    uint32_t held_ms;
+    uint32_t seen_ms;   ///< Instante do poll que o produziu.
+} expected_t;
+
+/**
+ * @brief Executa um roteiro de `start_ms` a `end_ms` e confere os eventos.
+ */
+static void run(const char *name, bool initial, uint32_t long_ms, uint32_t repeat_ms,
+                uint32_t start_ms, uint32_t end_ms,
+                const edge_t *edges, size_t edge_count,
+                const expected_t *expected, size_t expected_count) {
+    input_debounce_t d;
+    expected_t got[MAX_EVENTS];
+    size_t count = 0;
+    size_t next_edge = 0;
+
+    input_debounce_init(&d, initial, long_ms, repeat_ms);
+    for (uint32_t now = start_ms; now != end_ms; now++) {
+        while (next_edge < edge_count && edges[next_edge].at_ms == now) {
+            input_debounce_edge(&d, edges[next_edge].pressed, now);
+            next_edge++;
+        }
+        input_event_t evt;
+        while (input_debounce_poll(&d, now, &evt) && count < MAX_EVENTS) {
+            got[count++] = (expected_t){ evt.type, evt.time_ms, evt.held_ms, now };
+        }
+    }
+
+    printf("%s: %zu eventos\n", name, count);
+    CHECK_EQ_INT(count, expected_count);
+    for (size_t i = 0; i < count && i < expected_count; i++) {
+        CHECK_EQ_INT(got[i].type, expected[i].type);
+        CHECK_EQ_INT(got[i].time_ms, expected[i].time_ms);
+        CHECK_EQ_INT(got[i].held_ms, expected[i].held_ms);
+        CHECK_EQ_INT(got[i].seen_ms, expected[i].seen_ms);
+    }
+}
+
+#define RUN(name, initial, long_ms, repeat_ms, start, end, edges, expected) \
+    run(name, initial, long_ms, repeat_ms, start, end, edges, sizeof(edges) / sizeof(edges[0]), \
+        expected, sizeof(expected) / sizeof(expected[0]))
+
+int main(void) {
+    const uint32_t db = INPUT_DEBOUNCE_MS;
+
+    // Pressionamento com repique na descida e na subida, mantido por 800 ms: PRESS com
+    // o instante da primeira borda, LONG_PRESS, uma REPEAT e RELEASE com o tempo total.
+    {
+        static const edge_t edges[] = {
+            { 100, true }, { 101, false }, { 103, true }, { 104, false }, { 106, true },
+            { 900, false }, { 902, true }, { 903, false },
+        };
+        const expected_t expected[] = {
+            { INPUT_EVT_PRESS, 100, 0, 106 + db },
+            { INPUT_EVT_LONG_PRESS, 700, 600, 700 },
+            { INPUT_EVT_REPEAT, 820, 720, 820 },
+            { INPUT_EVT_RELEASE, 900, 800, 903 + db },
+        };
+        RUN("repique", false, 600, 120, 0, 1200, edges, expected);
+    }
+
+    // Pulso mais curto que o debounce e repique que termina no nível anterior: nada.
+    {
+        static const edge_t edges[] = {
+            { 50, true }, { 55, false },
+            { 300, true }, { 302, false }, { 310, true }, { 315, false },
+        };
+        run("falso", false, 600, 120, 0, 1000, edges, sizeof(edges) / sizeof(edges[0]), NULL, 0);
+    }
+
+    // Repique mais longo que o debounce entre bordas: duas mudanças aceitas.
+    {
+        static const edge_t edges[] = { { 100, true }, { 100 + 2 * INPUT_DEBOUNCE_MS, false } };
+        const expected_t expected[] = {
+            { INPUT_EVT_PRESS, 100, 0, 100 + db },
+            { INPUT_EVT_RELEASE, 100 + 2 * db, 2 * db, 100 + 3 * db },
+        };
+        RUN("lento", false, 600, 120, 0, 400, edges, expected);
+    }
+
+    // Sem pressionamento longo (botões): só PRESS e RELEASE, mesmo mantido por 2 s.
+    {
+        static const edge_t edges[] = { { 10, true }, { 2010, false } };
+        const expected_t expected[] = {
+            { INPUT_EVT_PRESS, 10, 0, 10 + db },
+            { INPUT_EVT_RELEASE, 2010, 2000, 2010 + db },
+        };
+        RUN("sem longo", false, 0, 0, 0, 2100, edges, expected);
+    }
+
+    // Pressionamento longo sem repetição.
+    {
+        static const edge_t edges[] = { { 10, true }, { 1500, false } };
+        const expected_t expected[] = {
+            { INPUT_EVT_PRESS, 10, 0, 10 + db },
+            { INPUT_EVT_LONG_PRESS, 610, 600, 610 },
+            { INPUT_EVT_RELEASE, 1500, 1490, 1500 + db },
+        };
+        RUN("sem repeticao", false, 600, 0, 0, 1600, edges, expected);
+    }
+
+    // Pressionada desde o boot: não gera LONG_PRESS até ser solta e pressionada de novo.
+    {
+        static const edge_t edges[] = { { 1000, false }, { 1100, true } };
+        const expected_t expected[] = {
+            { INPUT_EVT_RELEASE, 1000, 1000, 1000 + db },
+            { INPUT_EVT_PRESS, 1100, 0, 1100 + db },
+            { INPUT_EVT_LONG_PRESS, 1700, 600, 1700 },
+        };
+        RUN("boot", true, 600, 0, 0, 2000, edges, expected);
+    }
+
+    // Estouro do contador de ms durante o pressionamento.
+    {
+        static const edge_t edges[] = {
+            { 0xFFFFFF00u, true }, { 0xFFFFFF02u, false }, { 0xFFFFFF03u, true },
+            { 0x00000300u, false },
+        };
+        const expected_t expected[] = {
+            { INPUT_EVT_PRESS, 0xFFFFFF00u, 0, 0xFFFFFF03u + db },
+            { INPUT_EVT_LONG_PRESS, 0x00000158u, 600, 0x00000158u },
+            { INPUT_EVT_REPEAT, 0x000001D0u, 720, 0x000001D0u },
+            { INPUT_EVT_REPEAT, 0x00000248u, 840, 0x00000248u },
+            { INPUT_EVT_REPEAT, 0x000002C0u, 960, 0x000002C0u },
+            { INPUT_EVT_RELEASE, 0x00000300u, 1024, 0x00000300u + db },
+        };
+        RUN("estouro", false, 600, 120, 0xFFFFFE00u, 0x00000400u, edges, expected);
+    }
+
+    return TEST_RESULT();
+}
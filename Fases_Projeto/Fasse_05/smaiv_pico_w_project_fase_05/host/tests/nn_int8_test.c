@@ -0,0 +1,80 @@
+/**
+ * @file nn_int8_test.c
+ * @brief Teste do runtime int8: modelo empacotado, entradas fixas e saídas esperadas.
+ * @details O modelo data/nn_test_model.c é gerado por tools/pack_sound_model.py a
+ *          partir de data/nn_test_model.json (dwconv1d com ReLU, dwconv1d com escala
+ *          2^29, que satura a requantização, e dense). As saídas esperadas foram
+ *          calculadas com aritmética inteira exata, fora do runtime; como o runtime
+ *          é puramente inteiro, a comparação é bit a bit.
+ *
+ *   python3 tools/pack_sound_model.py host/tests/data/nn_test_model.json \
+ *       -o host/tests/data/nn_test_model.c
+ */
+#include <stdint.h>
+#include "modules/sound_classifier/nn_int8.h"
+#include "test_util.h"
+
+extern const uint8_t sound_model_blob[];
+extern const uint32_t sound_model_blob_size;
+
+#define TEST_LEN 8
+#define TEST_CH  3
+#define TEST_CLASSES 4
+
+typedef struct {
+    int8_t input[TEST_LEN][TEST_CH];
+    int8_t expected[TEST_CLASSES];
+} nn_test_case_t;
+
+static const nn_test_case_t cases[] = {
+    { { { -128, -128, -128 }, { -128, -128, -128 }, { -128, -128, -128 }, { -128, -128, -128 },
+        { -128, -128, -128 }, { -128, -128, -128 }, { -128, -128, -128 }, { -128, -128, -128 } },
+      { 20, -65, 3, 18 } },
+    { { { 127, 127, 127 }, { 127, 127, 127 }, { 127, 127, 127 }, { 127, 127, 127 },
+        { 127, 127, 127 }, { 127, 127, 127 }, { 127, 127, 127 }, { 127, 127, 127 } },
+      { 11, -38, 1, 18 } },
+    { { { -128, -37, 54 }, { -91, 0, 91 }, { -54, 37, -128 }, { -17, 74, -91 },
+        { 20, 111, -54 }, { 57, -108, -17 }, { 94, -71, 20 }, { -125, -34, 57 } },
+      { -2, -36, 0, 18 } },
+    { { { 0, -29, 58 }, { -13, 42, -71 }, { 26, -55, 84 }, { -39, 68, -97 },
+        { 52, -81, 110 }, { -65, 94, -123 }, { 78, -107, 8 }, { -91, 120, -21 } },
+      { -12, 15, 4, -3 } },
+};
+
+static void test_requantize(void) {
+    // Escala 0,5: arredondamento "meio para cima".
+    CHECK_EQ_INT(nn_requantize(3, 1 << 30, 0), 2);
+    CHECK_EQ_INT(nn_requantize(-3, 1 << 30, 0), -1);
+    // Escala 2^29: o produto passa de 32 bits e deve saturar.
+    CHECK_EQ_INT(nn_requantize(3, 1 << 30, -30), 3 << 29);
+    CHECK_EQ_INT(nn_requantize(1000, 1 << 30, -30), INT32_MAX);
+    CHECK_EQ_INT(nn_requantize(-1000, 1 << 30, -30), INT32_MIN);
+    CHECK_EQ_INT(nn_requantize(INT32_MIN, INT32_MAX, -30), INT32_MIN);
+}
+
+static void test_model(void) {
+    static nn_model_t model;
+    static int8_t arena[64] __attribute__((aligned(4)));
+
+    CHECK_EQ_INT(nn_model_load(&model, sound_model_blob, sound_model_blob_size), NN_OK);
+    CHECK_EQ_INT(model.num_classes, TEST_CLASSES);
+    CHECK_EQ_INT(model.input_len, TEST_LEN);
+    CHECK_EQ_INT(model.input_ch, TEST_CH);
+    CHECK(model.arena_required <= sizeof(arena));
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        int8_t out[TEST_CLASSES];
+        CHECK_EQ_INT(nn_model_invoke(&model, &cases[i].input[0][0], arena, sizeof(arena), out), NN_OK);
+        for (int c = 0; c < TEST_CLASSES; c++) {
+            CHECK_EQ_INT(out[c], cases[i].expected[c]);
+        }
+    }
+    CHECK_EQ_INT(nn_model_invoke(&model, &cases[0].input[0][0], arena, model.arena_required - 1,
+                                 (int8_t[TEST_CLASSES]){0}), NN_ERR_ARENA);
+}
+
+int main(void) {
+    test_requantize();
+    test_model();
+    return TEST_RESULT();
+}
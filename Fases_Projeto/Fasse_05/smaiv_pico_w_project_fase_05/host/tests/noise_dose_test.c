@@ -0,0 +1,104 @@
+/**
+ * @file noise_dose_test.c
+ * @brief Teste do dosímetro: dose e TWA contra as fórmulas da NR-15 e da OSHA.
+ * @details As referências são calculadas aqui, independentemente de noise_dose.c:
+ *          - dose (NR-15, Anexo 1): D = 100 * sum(C_i / T_i), com tempo permitido
+ *            T_i = 8 h / 2^((L_i - Lc) / q);
+ *          - TWA (forma da OSHA, 29 CFR 1910.95): TWA = 16,61 * log10(D / 100) + Lc,
+ *            em que 16,61 = q / log10(2) para q = 5 dB.
+ *          Os níveis são alimentados em registros de 1 s, como faz o main.c com os
+ *          quadros de áudio (que duram AUDIO_FRAME_MS).
+ */
+#include <math.h>
+#include "config.h"
+#include "hal/hal.h"
+#include "modules/noise_dose/noise_dose.h"
+#include "test_util.h"
+
+#define STEP_MS 1000u
+
+/**
+ * @brief Um trecho da jornada: nível constante durante `minutes`.
+ */
+typedef struct {
+    float level_db;
+    float minutes;
+} exposure_t;
+
+static void expose(const exposure_t *e) {
+    uint32_t total_ms = (uint32_t)(e->minutes * 60000.0f);
+    for (uint32_t t = 0; t < total_ms; t += STEP_MS) {
+        noise_dose_update(e->level_db, STEP_MS);
+    }
+}
+
+/**
+ * @brief Dose de referência (%) pela soma C/T da NR-15.
+ */
+static double nr15_dose(const exposure_t *list, int count) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        if (list[i].level_db < DOSE_THRESHOLD_DB) continue;
+        double allowed_min = DOSE_SHIFT_HOURS * 60.0 /
+                             pow(2.0, (list[i].level_db - DOSE_CRITERION_DB) / DOSE_EXCHANGE_RATE_DB);
+        sum += list[i].minutes / allowed_min;
+    }
+    return 100.0 * sum;
+}
+
+static double osha_twa(double dose_percent) {
+    return 16.61 * log10(dose_percent / 100.0) + DOSE_CRITERION_DB;
+}
+
+static void check_shift(const exposure_t *list, int count) {
+    noise_dose_reset();
+    double minutes = 0;
+    for (int i = 0; i < count; i++) {
+        expose(&list[i]);
+        minutes += list[i].minutes;
+    }
+
+    noise_dose_status_t st;
+    noise_dose_get_status(&st);
+    double dose = nr15_dose(list, count);
+    double projected = dose * DOSE_SHIFT_HOURS * 60.0 / minutes;
+    printf("dose %.3f%% (ref %.3f%%), TWA %.2f dB (ref %.2f), projetada %.1f%% / %.2f dB\n",
+           st.dose_percent, dose, st.twa_db, osha_twa(dose), st.projected_percent, st.projected_twa_db);
+
+    CHECK_EQ_INT(st.exposure_ms, (uint32_t)(minutes * 60000.0));
+    CHECK_NEAR(st.dose_percent, dose, dose * 1e-3 + 1e-3);
+    CHECK_NEAR(st.projected_percent, projected, projected * 1e-3 + 1e-3);
+    if (dose > 0) {
+        CHECK_NEAR(st.twa_db, osha_twa(dose), 0.02);
+        CHECK_NEAR(st.projected_twa_db, osha_twa(projected), 0.02);
+    } else {
+        CHECK_NEAR(st.twa_db, DOSE_THRESHOLD_DB, 0);
+    }
+}
+
+int main(void) {
+    noise_dose_init();
+
+    // Nível critério durante a jornada inteira: 100%, TWA = Lc.
+    check_shift((const exposure_t[]){ { 85.0f, 480 } }, 1);
+    // Cada 5 dB acima do critério reduz o tempo permitido pela metade.
+    check_shift((const exposure_t[]){ { 90.0f, 240 } }, 1);
+    check_shift((const exposure_t[]){ { 95.0f, 60 } }, 1);
+    // Abaixo do limiar de integração não há dose.
+    check_shift((const exposure_t[]){ { 79.9f, 480 } }, 1);
+    // Jornada mista (7 h), com trechos fora dos múltiplos de 5 dB e abaixo do limiar.
+    check_shift((const exposure_t[]){ { 82.0f, 120 }, { 88.0f, 90 }, { 70.0f, 60 },
+                                      { 93.5f, 45 }, { 101.0f, 10 }, { 86.0f, 95 } }, 6);
+
+    // Jornada em andamento: o acumulado gravado na flash é restaurado por noise_dose_init().
+    noise_dose_status_t before, after, report;
+    noise_dose_get_status(&before);
+    hal_sleep_ms(DOSE_PERSIST_INTERVAL_MS);
+    CHECK(noise_dose_service(&report));
+    noise_dose_init();
+    noise_dose_get_status(&after);
+    CHECK_EQ_INT(after.exposure_ms, before.exposure_ms);
+    CHECK_NEAR(after.dose_percent, before.dose_percent, 0);
+
+    return TEST_RESULT();
+}
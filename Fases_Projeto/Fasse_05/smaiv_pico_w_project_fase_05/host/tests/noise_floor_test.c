@@ -0,0 +1,81 @@
+/**
+ * @file noise_floor_test.c
+ * @brief Teste da subtração espectral: zumbido estacionário com ruído e tom transitório.
+ * @details Os quadros passam pela mesma cadeia do Core 1 (audio_fft_power() e
+ *          noise_floor_process()). Depois de estabilizado, um zumbido de 120 Hz com
+ *          ruído branco deve ficar pelo menos 12 dB abaixo do seu RMS bruto (sobram
+ *          só picos do próprio ruído acima de 2x o piso); um tom de 1,5 kHz
+ *          sobreposto deve aparecer com o seu próprio RMS, e o piso não pode subir
+ *          de forma apreciável durante o tom.
+ */
+#include <math.h>
+#include "modules/audio_processing/audio_fft.h"
+#include "modules/audio_processing/noise_floor.h"
+#include "test_util.h"
+
+#define HUM_HZ        120.0f
+#define HUM_AMPLITUDE 400.0f
+#define NOISE_SPAN    200     ///< Ruído uniforme em [-NOISE_SPAN/2, NOISE_SPAN/2) LSB.
+#define TONE_HZ       1500.0f
+#define TONE_AMPLITUDE 500.0f
+
+#define SETTLE_FRAMES 250     ///< ~8 s: o piso sobe 1/256 da diferença por quadro.
+#define TONE_FRAMES   31      ///< ~1 s de tom.
+#define MAX_RESIDUAL  0.25f   ///< Nível de evento máximo do fundo, relativo ao RMS bruto.
+
+static int16_t samples[AUDIO_FFT_SIZE];
+static uint32_t power[AUDIO_FFT_BINS];
+static uint32_t sample_index;
+static uint32_t seed = 1;
+
+static float frame(float tone_amplitude) {
+    for (int n = 0; n < AUDIO_FFT_SIZE; n++, sample_index++) {
+        float t = (float)sample_index / AUDIO_SAMPLE_RATE_HZ;
+        seed = seed * 1664525u + 1013904223u;
+        float v = HUM_AMPLITUDE * sinf(6.28318530718f * HUM_HZ * t) +
+                  tone_amplitude * sinf(6.28318530718f * TONE_HZ * t) +
+                  (float)((seed >> 16) % NOISE_SPAN) - NOISE_SPAN / 2;
+        samples[n] = (int16_t)lroundf(v);
+    }
+    audio_fft_power(samples, power);
+    return noise_floor_process(power);
+}
+
+int main(void) {
+    audio_fft_init();
+    noise_floor_init();
+
+    // RMS do fundo: zumbido (A/sqrt 2) e ruído uniforme (span/sqrt 12).
+    const float background_rms = sqrtf(HUM_AMPLITUDE * HUM_AMPLITUDE / 2 +
+                                       NOISE_SPAN * NOISE_SPAN / 12.0f);
+
+    float level = 0;
+    float worst = 0;
+    for (int i = 0; i < SETTLE_FRAMES; i++) {
+        level = frame(0);
+        if (i >= SETTLE_FRAMES - 60 && level > worst) worst = level;
+    }
+    float floor_before = noise_floor_level();
+    printf("fundo: rms %.1f, piso %.1f, evento max %.1f\n", background_rms, floor_before, worst);
+    CHECK(worst < MAX_RESIDUAL * background_rms);
+    CHECK(floor_before > 0.5f * background_rms && floor_before < 1.2f * background_rms);
+
+    float tone_min = 1e9f, tone_max = 0;
+    for (int i = 0; i < TONE_FRAMES; i++) {
+        level = frame(TONE_AMPLITUDE);
+        if (level < tone_min) tone_min = level;
+        if (level > tone_max) tone_max = level;
+    }
+    float floor_after = noise_floor_level();
+    const float tone_rms = TONE_AMPLITUDE / sqrtf(2.0f);
+    printf("tom: rms %.1f, evento %.1f..%.1f, piso %.1f\n", tone_rms, tone_min, tone_max, floor_after);
+    CHECK_NEAR(tone_min, tone_rms, 0.15f * tone_rms);
+    CHECK_NEAR(tone_max, tone_rms, 0.15f * tone_rms);
+    CHECK(floor_after < 1.2f * floor_before);
+
+    // O tom some: o nível volta ao do fundo no quadro seguinte.
+    level = frame(0);
+    CHECK(level < MAX_RESIDUAL * background_rms);
+
+    return TEST_RESULT();
+}
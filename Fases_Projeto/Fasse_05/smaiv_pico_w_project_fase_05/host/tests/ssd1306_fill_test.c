@@ -0,0 +1,222 @@
+/**
+ * @file ssd1306_fill_test.c
+ * @brief Teste das rotinas de preenchimento do driver SSD1306 contra as de pixel.
+ * @details ssd1306_draw_square(), ssd1306_clear_square() e as linhas horizontais e
+ *          verticais (ssd1306_draw_line(), ssd1306_draw_hline()/_vline() e
+ *          ssd1306_draw_empty_square()) escrevem uma máscara por página, e
+ *          ssd1306_draw_image() copia ou soma (OR) colunas inteiras, deslocadas entre
+ *          duas páginas quando y não é múltiplo de 8. Texto em linhas alinhadas às
+ *          páginas (escalas 1 e 2) passa pelo caminho rápido de glifos, comparado com
+ *          ssd1306_draw_char_with_font_pixels(). As referências aqui são as versões
+ *          antigas do driver, um pixel de cada vez, aplicadas a um segundo display. Operações aleatórias (parte fora da tela, largura ou
+ *          altura zero) são feitas nos dois, sobre um fundo aleatório, e os
+ *          framebuffers têm de ficar iguais byte a byte.
+ */
+#include <string.h>
+#include "config.h"
+#include "hal/hal.h"
+#include "ssd1306/ssd1306.h"
+#include "test_util.h"
+
+#define ITERATIONS      50000
+#define BACKGROUND_EVERY 50     ///< Operações entre fundos aleatórios novos.
+#define IMAGE_MAX       40      ///< Largura e altura máximas das imagens aleatórias.
+#define TEXT_MAX        8       ///< Caracteres por texto aleatório.
+
+extern const uint8_t font_8x5[];    ///< Fonte padrão do driver (lib/ssd1306/font.h).
+
+static uint32_t seed = 11;
+
+static uint32_t rnd(uint32_t n) {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) % n;
+}
+
+static void ref_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t w, uint32_t h, bool set) {
+    for (uint32_t i = 0; i < w; i++) {
+        for (uint32_t j = 0; j < h; j++) {
+            if (set) {
+                ssd1306_draw_pixel(p, x + i, y + j);
+            } else {
+                ssd1306_clear_pixel(p, x + i, y + j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Linha horizontal ou vertical pixel a pixel (coordenadas negativas viram
+ *        valores enormes em uint32_t e ficam fora da tela, como no driver antigo).
+ */
+static void ref_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    if (x1 > x2) { int32_t t = x1; x1 = x2; x2 = t; }
+    if (y1 > y2) { int32_t t = y1; y1 = y2; y2 = t; }
+    for (int32_t x = x1; x <= x2; x++) {
+        for (int32_t y = y1; y <= y2; y++) {
+            ssd1306_draw_pixel(p, (uint32_t)x, (uint32_t)y);
+        }
+    }
+}
+
+static void ref_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    ref_line(p, x, y, x + w, y);
+    ref_line(p, x, y + h, x + w, y + h);
+    ref_line(p, x, y, x, y + h);
+    ref_line(p, x + w, y, x + w, y + h);
+}
+
+/**
+ * @brief Imagem empacotada pixel a pixel: acende os bits ligados e, com copy, apaga os
+ *        desligados. Os bits da última página além da altura não são lidos.
+ */
+static void ref_image(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *image, bool copy) {
+    uint32_t w = image[0], h = image[1];
+    for (uint32_t i = 0; i < w; i++) {
+        for (uint32_t j = 0; j < h; j++) {
+            if ((image[2 + (j / 8) * w + i] >> (j % 8)) & 1u) {
+                ssd1306_draw_pixel(p, x + i, y + j);
+            } else if (copy) {
+                ssd1306_clear_pixel(p, x + i, y + j);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Texto pixel a pixel, com o mesmo avanço de ssd1306_draw_string_with_font().
+ */
+static void ref_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const char *s) {
+    for (; *s; s++, x += (font_8x5[1] + font_8x5[2]) * scale) {
+        if (*s >= font_8x5[3] && *s <= font_8x5[4]) {
+            ssd1306_draw_char_with_font_pixels(p, x, y, scale, font_8x5, *s);
+        }
+    }
+}
+
+int main(void) {
+    hal_i2c_t *i2c = hal_i2c_init(OLED_I2C_BUS, OLED_SDA_PIN, OLED_SCL_PIN, OLED_I2C_HZ);
+    ssd1306_t fast = { 0 }, ref = { 0 };
+    CHECK(ssd1306_init(&fast, 128, 64, OLED_I2C_ADDR, i2c));
+    CHECK(ssd1306_init(&ref, 128, 64, OLED_I2C_ADDR, i2c));
+
+    static const char *const names[] = {
+        "draw_square", "clear_square", "vline", "hline", "draw_line v", "draw_line h", "empty_square",
+        "image", "string",
+    };
+    const uint32_t op_count = sizeof(names) / sizeof(names[0]);
+    uint32_t done[sizeof(names) / sizeof(names[0])] = { 0 };
+    // Casos de imagem: y fora do múltiplo de 8, altura parcial na última página,
+    // cortada à direita, cortada embaixo e com copy.
+    uint32_t image_cases[5] = { 0 };
+    static uint8_t image[2 + ((IMAGE_MAX + 7) / 8) * IMAGE_MAX];
+    // Textos: escala 1 e 2 no caminho rápido, e caracteres que passam da borda
+    // direita (ou de baixo, na escala 2) e voltam ao desenho por pixel.
+    uint32_t text_cases[3] = { 0 };
+    char text[TEXT_MAX + 1];
+    for (int it = 0; it < ITERATIONS; it++) {
+        if (it % BACKGROUND_EVERY == 0) {
+            for (uint32_t i = 0; i < fast.bufsize; i++) {
+                fast.buffer[i] = ref.buffer[i] = (uint8_t)rnd(256);
+            }
+        }
+
+        uint32_t op = rnd(op_count);
+        uint32_t x = rnd(150), y = rnd(80), w = rnd(140), h = rnd(80);
+        int32_t x1 = (int32_t)rnd(170) - 20, y1 = (int32_t)rnd(100) - 20;
+        int32_t x2 = (int32_t)rnd(170) - 20, y2 = (int32_t)rnd(100) - 20;
+        switch (op) {
+        case 0:
+            ssd1306_draw_square(&fast, x, y, w, h);
+            ref_square(&ref, x, y, w, h, true);
+            break;
+        case 1:
+            ssd1306_clear_square(&fast, x, y, w, h);
+            ref_square(&ref, x, y, w, h, false);
+            break;
+        case 2:
+            ssd1306_draw_vline(&fast, x, y, h);
+            ref_square(&ref, x, y, 1, h, true);
+            break;
+        case 3:
+            ssd1306_draw_hline(&fast, x, y, w);
+            ref_square(&ref, x, y, w, 1, true);
+            break;
+        case 4:
+            ssd1306_draw_line(&fast, x1, y1, x1, y2);
+            ref_line(&ref, x1, y1, x1, y2);
+            break;
+        case 5:
+            ssd1306_draw_line(&fast, x1, y1, x2, y1);
+            ref_line(&ref, x1, y1, x2, y1);
+            break;
+        case 6:
+            ssd1306_draw_empty_square(&fast, x, y, w, h);
+            ref_empty_square(&ref, x, y, w, h);
+            break;
+        case 7: {
+            image[0] = (uint8_t)(1 + rnd(IMAGE_MAX));
+            image[1] = (uint8_t)(1 + rnd(IMAGE_MAX));
+            for (uint32_t i = 2; i < sizeof(image); i++) {
+                image[i] = (uint8_t)rnd(256);
+            }
+            x = rnd(136);
+            y = rnd(72);
+            bool copy = rnd(2);
+            ssd1306_draw_image(&fast, x, y, image, copy);
+            ref_image(&ref, x, y, image, copy);
+            if (x < 128 && y < 64) {
+                image_cases[0] += (y % 8) != 0;
+                image_cases[1] += (image[1] % 8) != 0;
+                image_cases[2] += x + image[0] > 128;
+                image_cases[3] += y + image[1] > 64;
+                image_cases[4] += copy;
+            }
+            w = image[0];
+            h = image[1];
+            break;
+        }
+        default: {
+            uint32_t n = 1 + rnd(TEXT_MAX);
+            for (uint32_t i = 0; i < n; i++) {
+                text[i] = (char)(32 + rnd(95));
+            }
+            text[n] = '\0';
+            uint32_t scale = 1 + rnd(2);
+            x = rnd(128);
+            y = 8 * rnd(8);
+            ssd1306_draw_string(&fast, x, y, scale, text);
+            ref_string(&ref, x, y, scale, text);
+            text_cases[scale - 1]++;
+            text_cases[2] += x + n * 6 * scale > 128 || y + 8 * scale > 64;
+            w = scale;
+            h = n;
+            break;
+        }
+        }
+        done[op]++;
+
+        if (memcmp(fast.buffer, ref.buffer, fast.bufsize) != 0) {
+            printf("iteracao %d: %s(%lu, %lu, %lu, %lu) / linha (%ld, %ld)-(%ld, %ld) diverge\n",
+                   it, names[op], (unsigned long)x, (unsigned long)y, (unsigned long)w,
+                   (unsigned long)h, (long)x1, (long)y1, (long)x2, (long)y2);
+            CHECK(false);
+            break;
+        }
+    }
+
+    for (uint32_t op = 0; op < op_count; op++) {
+        printf("%-13s %lu operacoes\n", names[op], (unsigned long)done[op]);
+    }
+    printf("imagens: %lu com y%%8 != 0, %lu com altura parcial, %lu cortadas a direita, "
+           "%lu embaixo, %lu com copy\n", (unsigned long)image_cases[0], (unsigned long)image_cases[1],
+           (unsigned long)image_cases[2], (unsigned long)image_cases[3], (unsigned long)image_cases[4]);
+    for (int i = 0; i < 5; i++) {
+        CHECK(image_cases[i] > 0);
+    }
+    printf("textos: %lu na escala 1, %lu na escala 2, %lu passando da borda\n",
+           (unsigned long)text_cases[0], (unsigned long)text_cases[1], (unsigned long)text_cases[2]);
+    for (int i = 0; i < 3; i++) {
+        CHECK(text_cases[i] > 0);
+    }
+    return TEST_RESULT();
+}
@@ -0,0 +1,46 @@
+/**
+ * @file test_util.h
+ * @brief Verificações mínimas dos testes de host (executados pelo ctest).
+ * @details Cada teste é um executável próprio: as verificações que falham são
+ *          impressas com arquivo e linha, e TEST_RESULT() devolve o código de saída
+ *          (0 se todas passaram).
+ */
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <math.h>
+#include <stdio.h>
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+        test_checks++; \
+        if (!(cond)) { \
+            test_failures++; \
+            printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+        } \
+    } while (0)
+
+#define CHECK_EQ_INT(actual, expected) do { \
+        long long a_ = (long long)(actual), e_ = (long long)(expected); \
+        test_checks++; \
+        if (a_ != e_) { \
+            test_failures++; \
+            printf("%s:%d: %s = %lld, esperado %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tol) do { \
+        double a_ = (double)(actual), e_ = (double)(expected); \
+        test_checks++; \
+        if (!(fabs(a_ - e_) <= (tol))) { \
+            test_failures++; \
+            printf("%s:%d: %s = %.6g, esperado %.6g (+-%g)\n", __FILE__, __LINE__, #actual, a_, e_, (double)(tol)); \
+        } \
+    } while (0)
+
+#define TEST_RESULT() \
+    (printf("%d verificacoes, %d falhas\n", test_checks, test_failures), test_failures ? 1 : 0)
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file ui_frame_bytes_test.c
+ * @brief Teste dos bytes enviados ao display por quadro, nas telas existentes.
+ * @details A UI roda sobre a HAL POSIX (display simulado) e cada passo muda um valor
+ *          visível, espera o intervalo de 1/UI_MAX_FPS e chama ui_draw(). Os bytes do
+ *          quadro (diferença de ui_stats_t.i2c_bytes) são comparados com a conta das
+ *          janelas que mudaram: cada janela custa 8 bytes de endereçamento (controle,
+ *          SET_COL_ADDR e SET_PAGE_ADDR com argumentos, controle de dados) mais uma
+ *          coluna por página. Um quadro inteiro seriam 8 + 1024 bytes.
+ */
+#include <string.h>
+#include "config.h"
+#include "hal/hal.h"
+#include "modules/audio_processing/audio_features.h"
+#include "modules/ui_manager/ui_manager.h"
+#include "test_util.h"
+
+#define WINDOW(cols, pages) (8 + (cols) * (pages))  ///< Bytes de uma janela.
+#define FULL_FRAME          WINDOW(128, 8)
+
+static system_state_t state;
+static uint32_t now_ms;
+
+/**
+ * @brief Desenha um quadro e confere os bytes enviados.
+ * @details Avança o relógio além do limite de quadros antes de chamar ui_draw(), para
+ *          que nenhuma mudança seja adiada.
+ */
+static void frame(const char *name, uint32_t expected) {
+    ui_stats_t before, after;
+    ui_get_stats(&before);
+    hal_sleep_ms(1000u / UI_MAX_FPS);
+    now_ms += 1000u / UI_MAX_FPS;
+    ui_draw(&state);
+    ui_get_stats(&after);
+    uint32_t bytes = after.i2c_bytes - before.i2c_bytes;
+    printf("%-18s %4lu bytes (quadro inteiro: %d)\n", name, (unsigned long)bytes, FULL_FRAME);
+    CHECK_EQ_INT(bytes, expected);
+    CHECK_EQ_INT(after.frames_sent - before.frames_sent, expected ? 1 : 0);
+    CHECK_EQ_INT(after.frames_unchanged - before.frames_unchanged, expected ? 0 : 1);
+    CHECK_EQ_INT(after.frames_deferred, before.frames_deferred);
+}
+
+static void advance(uint32_t ms) {
+    hal_sleep_ms(ms);
+    now_ms += ms;
+}
+
+/**
+ * @brief Uma medição com o nível e todas as bandas em `db` (quantizado em 0,5 dB).
+ */
+static void push(float db) {
+    measurement_t m;
+    memset(&m, 0, sizeof(m));
+    m.timestamp_ms = now_ms;
+    for (int i = 0; i < AUDIO_FEATURE_COUNT; i++) {
+        m.features[i] = (int8_t)(2 * db - 128);
+    }
+    ui_push_measurement(&m);
+}
+
+int main(void) {
+    // O splash vai inteiro (a cópia do painel ainda não é válida); daí em diante,
+    // só as janelas que mudaram.
+    ui_init();
+
+    // Tela principal sobre o splash: título (páginas 0-1), linha do nível (página 3) e
+    // status MQTT (página 6); a página 2 e a 5 são as sobras do splash que se apagam.
+    state.current_screen = SCREEN_MAIN;
+    state.current_sound_level = 42.0f;
+    state.sound_threshold = 70.0f;
+    frame("principal", WINDOW(58, 2) + WINDOW(84, 1) + WINDOW(104, 1) + WINDOW(93, 1) + WINDOW(53, 1));
+    frame("igual", 0);
+
+    // Dois dígitos do nível (fonte de 6 colunas): 11 colunas de uma página.
+    state.current_sound_level = 57.0f;
+    frame("nivel", WINDOW(11, 1));
+    state.mqtt_connected = true;
+    frame("mqtt", WINDOW(17, 1));
+    // "ALERTA!" em escala 2 e o ícone ocupam as páginas 6-7.
+    state.alert_active = true;
+    frame("alerta", WINDOW(116, 2));
+
+    // Troca de tela: título, valor e rodapé, cada um em escala 2 ou em duas páginas.
+    state.current_screen = SCREEN_SETTINGS;
+    frame("ajustes", WINDOW(82, 2) + WINDOW(118, 2) + WINDOW(125, 2));
+    // Um dígito do limiar em escala 2.
+    state.sound_threshold = 75.0f;
+    frame("limiar", WINDOW(10, 2));
+    state.current_screen = SCREEN_MAIN;
+    frame("principal, volta", WINDOW(82, 2) + WINDOW(118, 2) + WINDOW(125, 2));
+
+    // Histórico em rampa (20..59 dB), uma coluna por segundo, além da largura da tela.
+    for (int i = 0; i < 130; i++) {
+        advance(UI_HISTORY_COLUMN_MS);
+        push(20.0f + (i % 40));
+    }
+
+    // Entrada no gráfico: desenho completo, mas as páginas que já coincidem com a tela
+    // anterior (colunas das pontas) não vão ao barramento. As páginas 3-5 são
+    // unidas em uma janela.
+    state.current_screen = SCREEN_GRAPH;
+    frame("grafico", WINDOW(99, 1) + WINDOW(119, 1) + WINDOW(100, 1) + WINDOW(128, 3) +
+                     WINDOW(112, 1) + WINDOW(127, 1));
+    frame("grafico, igual", 0);
+
+    // Medição na mesma coluna: número do cabeçalho e barras das bandas (páginas 6-7).
+    push(40.0f);
+    frame("grafico, barras", WINDOW(11, 1) + WINDOW(126, 2));
+
+    // Coluna nova: as páginas 1-5 deslocadas uma coluna; na rampa, as páginas de cima
+    // só mudam onde as colunas as alcançam.
+    advance(UI_HISTORY_COLUMN_MS);
+    push(40.0f);
+    frame("grafico, coluna", WINDOW(88, 1) + WINDOW(110, 1) + WINDOW(127, 2));
+
+    return TEST_RESULT();
+}
@@ -7,104 +7,126 @@
  * <first ascii char>, <last ascii char>,
  * <data>
  */
+
+// glyph columns of font_8x5, one byte per column (bit 0 = top row), as an x-macro
+// so that the pre-scaled table below is generated by the compiler from the same data
+#define FONT_8X5_COLUMNS(C) \
+			C(0x00), C(0x00), C(0x00), C(0x00), C(0x00), \
+			C(0x00), C(0x00), C(0x5F), C(0x00), C(0x00), \
+			C(0x00), C(0x07), C(0x00), C(0x07), C(0x00), \
+			C(0x14), C(0x7F), C(0x14), C(0x7F), C(0x14), \
+			C(0x24), C(0x2A), C(0x7F), C(0x2A), C(0x12), \
+			C(0x23), C(0x13), C(0x08), C(0x64), C(0x62), \
+			C(0x36), C(0x49), C(0x56), C(0x20), C(0x50), \
+			C(0x00), C(0x08), C(0x07), C(0x03), C(0x00), \
+			C(0x00), C(0x1C), C(0x22), C(0x41), C(0x00), \
+			C(0x00), C(0x41), C(0x22), C(0x1C), C(0x00), \
+			C(0x2A), C(0x1C), C(0x7F), C(0x1C), C(0x2A), \
+			C(0x08), C(0x08), C(0x3E), C(0x08), C(0x08), \
+			C(0x00), C(0x80), C(0x70), C(0x30), C(0x00), \
+			C(0x08), C(0x08), C(0x08), C(0x08), C(0x08), \
+			C(0x00), C(0x00), C(0x60), C(0x60), C(0x00), \
+			C(0x20), C(0x10), C(0x08), C(0x04), C(0x02), \
+			C(0x3E), C(0x51), C(0x49), C(0x45), C(0x3E), \
+			C(0x00), C(0x42), C(0x7F), C(0x40), C(0x00), \
+			C(0x72), C(0x49), C(0x49), C(0x49), C(0x46), \
+			C(0x21), C(0x41), C(0x49), C(0x4D), C(0x33), \
+			C(0x18), C(0x14), C(0x12), C(0x7F), C(0x10), \
+			C(0x27), C(0x45), C(0x45), C(0x45), C(0x39), \
+			C(0x3C), C(0x4A), C(0x49), C(0x49), C(0x31), \
+			C(0x41), C(0x21), C(0x11), C(0x09), C(0x07), \
+			C(0x36), C(0x49), C(0x49), C(0x49), C(0x36), \
+			C(0x46), C(0x49), C(0x49), C(0x29), C(0x1E), \
+			C(0x00), C(0x00), C(0x14), C(0x00), C(0x00), \
+			C(0x00), C(0x40), C(0x34), C(0x00), C(0x00), \
+			C(0x00), C(0x08), C(0x14), C(0x22), C(0x41), \
+			C(0x14), C(0x14), C(0x14), C(0x14), C(0x14), \
+			C(0x00), C(0x41), C(0x22), C(0x14), C(0x08), \
+			C(0x02), C(0x01), C(0x59), C(0x09), C(0x06), \
+			C(0x3E), C(0x41), C(0x5D), C(0x59), C(0x4E), \
+			C(0x7C), C(0x12), C(0x11), C(0x12), C(0x7C), \
+			C(0x7F), C(0x49), C(0x49), C(0x49), C(0x36), \
+			C(0x3E), C(0x41), C(0x41), C(0x41), C(0x22), \
+			C(0x7F), C(0x41), C(0x41), C(0x41), C(0x3E), \
+			C(0x7F), C(0x49), C(0x49), C(0x49), C(0x41), \
+			C(0x7F), C(0x09), C(0x09), C(0x09), C(0x01), \
+			C(0x3E), C(0x41), C(0x41), C(0x51), C(0x73), \
+			C(0x7F), C(0x08), C(0x08), C(0x08), C(0x7F), \
+			C(0x00), C(0x41), C(0x7F), C(0x41), C(0x00), \
+			C(0x20), C(0x40), C(0x41), C(0x3F), C(0x01), \
+			C(0x7F), C(0x08), C(0x14), C(0x22), C(0x41), \
+			C(0x7F), C(0x40), C(0x40), C(0x40), C(0x40), \
+			C(0x7F), C(0x02), C(0x1C), C(0x02), C(0x7F), \
+			C(0x7F), C(0x04), C(0x08), C(0x10), C(0x7F), \
+			C(0x3E), C(0x41), C(0x41), C(0x41), C(0x3E), \
+			C(0x7F), C(0x09), C(0x09), C(0x09), C(0x06), \
+			C(0x3E), C(0x41), C(0x51), C(0x21), C(0x5E), \
+			C(0x7F), C(0x09), C(0x19), C(0x29), C(0x46), \
+			C(0x26), C(0x49), C(0x49), C(0x49), C(0x32), \
+			C(0x03), C(0x01), C(0x7F), C(0x01), C(0x03), \
+			C(0x3F), C(0x40), C(0x40), C(0x40), C(0x3F), \
+			C(0x1F), C(0x20), C(0x40), C(0x20), C(0x1F), \
+			C(0x3F), C(0x40), C(0x38), C(0x40), C(0x3F), \
+			C(0x63), C(0x14), C(0x08), C(0x14), C(0x63), \
+			C(0x03), C(0x04), C(0x78), C(0x04), C(0x03), \
+			C(0x61), C(0x59), C(0x49), C(0x4D), C(0x43), \
+			C(0x00), C(0x7F), C(0x41), C(0x41), C(0x41), \
+			C(0x02), C(0x04), C(0x08), C(0x10), C(0x20), \
+			C(0x00), C(0x41), C(0x41), C(0x41), C(0x7F), \
+			C(0x04), C(0x02), C(0x01), C(0x02), C(0x04), \
+			C(0x40), C(0x40), C(0x40), C(0x40), C(0x40), \
+			C(0x00), C(0x03), C(0x07), C(0x08), C(0x00), \
+			C(0x20), C(0x54), C(0x54), C(0x78), C(0x40), \
+			C(0x7F), C(0x28), C(0x44), C(0x44), C(0x38), \
+			C(0x38), C(0x44), C(0x44), C(0x44), C(0x28), \
+			C(0x38), C(0x44), C(0x44), C(0x28), C(0x7F), \
+			C(0x38), C(0x54), C(0x54), C(0x54), C(0x18), \
+			C(0x00), C(0x08), C(0x7E), C(0x09), C(0x02), \
+			C(0x18), C(0xA4), C(0xA4), C(0x9C), C(0x78), \
+			C(0x7F), C(0x08), C(0x04), C(0x04), C(0x78), \
+			C(0x00), C(0x44), C(0x7D), C(0x40), C(0x00), \
+			C(0x20), C(0x40), C(0x40), C(0x3D), C(0x00), \
+			C(0x7F), C(0x10), C(0x28), C(0x44), C(0x00), \
+			C(0x00), C(0x41), C(0x7F), C(0x40), C(0x00), \
+			C(0x7C), C(0x04), C(0x78), C(0x04), C(0x78), \
+			C(0x7C), C(0x08), C(0x04), C(0x04), C(0x78), \
+			C(0x38), C(0x44), C(0x44), C(0x44), C(0x38), \
+			C(0xFC), C(0x18), C(0x24), C(0x24), C(0x18), \
+			C(0x18), C(0x24), C(0x24), C(0x18), C(0xFC), \
+			C(0x7C), C(0x08), C(0x04), C(0x04), C(0x08), \
+			C(0x48), C(0x54), C(0x54), C(0x54), C(0x24), \
+			C(0x04), C(0x04), C(0x3F), C(0x44), C(0x24), \
+			C(0x3C), C(0x40), C(0x40), C(0x20), C(0x7C), \
+			C(0x1C), C(0x20), C(0x40), C(0x20), C(0x1C), \
+			C(0x3C), C(0x40), C(0x30), C(0x40), C(0x3C), \
+			C(0x44), C(0x28), C(0x10), C(0x28), C(0x44), \
+			C(0x4C), C(0x90), C(0x90), C(0x90), C(0x7C), \
+			C(0x44), C(0x64), C(0x54), C(0x4C), C(0x44), \
+			C(0x00), C(0x08), C(0x36), C(0x41), C(0x00), \
+			C(0x00), C(0x00), C(0x77), C(0x00), C(0x00), \
+			C(0x00), C(0x41), C(0x36), C(0x08), C(0x00), \
+			C(0x02), C(0x01), C(0x02), C(0x04), C(0x02),
+
+#define FONT_COLUMN(b) (b)
+
 const uint8_t font_8x5[] =
 {
 			8, 5, 1, 32, 126,
-			0x00, 0x00, 0x00, 0x00, 0x00,
-			0x00, 0x00, 0x5F, 0x00, 0x00,
-			0x00, 0x07, 0x00, 0x07, 0x00,
-			0x14, 0x7F, 0x14, 0x7F, 0x14,
-			0x24, 0x2A, 0x7F, 0x2A, 0x12,
-			0x23, 0x13, 0x08, 0x64, 0x62,
-			0x36, 0x49, 0x56, 0x20, 0x50,
-			0x00, 0x08, 0x07, 0x03, 0x00,
-			0x00, 0x1C, 0x22, 0x41, 0x00,
-			0x00, 0x41, 0x22, 0x1C, 0x00,
-			0x2A, 0x1C, 0x7F, 0x1C, 0x2A,
-			0x08, 0x08, 0x3E, 0x08, 0x08,
-			0x00, 0x80, 0x70, 0x30, 0x00,
-			0x08, 0x08, 0x08, 0x08, 0x08,
-			0x00, 0x00, 0x60, 0x60, 0x00,
-			0x20, 0x10, 0x08, 0x04, 0x02,
-			0x3E, 0x51, 0x49, 0x45, 0x3E,
-			0x00, 0x42, 0x7F, 0x40, 0x00,
-			0x72, 0x49, 0x49, 0x49, 0x46,
-			0x21, 0x41, 0x49, 0x4D, 0x33,
-			0x18, 0x14, 0x12, 0x7F, 0x10,
-			0x27, 0x45, 0x45, 0x45, 0x39,
-			0x3C, 0x4A, 0x49, 0x49, 0x31,
-			0x41, 0x21, 0x11, 0x09, 0x07,
-			0x36, 0x49, 0x49, 0x49, 0x36,
-			0x46, 0x49, 0x49, 0x29, 0x1E,
-			0x00, 0x00, 0x14, 0x00, 0x00,
-			0x00, 0x40, 0x34, 0x00, 0x00,
-			0x00, 0x08, 0x14, 0x22, 0x41,
-			0x14, 0x14, 0x14, 0x14, 0x14,
-			0x00, 0x41, 0x22, 0x14, 0x08,
-			0x02, 0x01, 0x59, 0x09, 0x06,
-			0x3E, 0x41, 0x5D, 0x59, 0x4E,
-			0x7C, 0x12, 0x11, 0x12, 0x7C,
-			0x7F, 0x49, 0x49, 0x49, 0x36,
-			0x3E, 0x41, 0x41, 0x41, 0x22,
-			0x7F, 0x41, 0x41, 0x41, 0x3E,
-			0x7F, 0x49, 0x49, 0x49, 0x41,
-			0x7F, 0x09, 0x09, 0x09, 0x01,
-			0x3E, 0x41, 0x41, 0x51, 0x73,
-			0x7F, 0x08, 0x08, 0x08, 0x7F,
-			0x00, 0x41, 0x7F, 0x41, 0x00,
-			0x20, 0x40, 0x41, 0x3F, 0x01,
-			0x7F, 0x08, 0x14, 0x22, 0x41,
-			0x7F, 0x40, 0x40, 0x40, 0x40,
-			0x7F, 0x02, 0x1C, 0x02, 0x7F,
-			0x7F, 0x04, 0x08, 0x10, 0x7F,
-			0x3E, 0x41, 0x41, 0x41, 0x3E,
-			0x7F, 0x09, 0x09, 0x09, 0x06,
-			0x3E, 0x41, 0x51, 0x21, 0x5E,
-			0x7F, 0x09, 0x19, 0x29, 0x46,
-			0x26, 0x49, 0x49, 0x49, 0x32,
-			0x03, 0x01, 0x7F, 0x01, 0x03,
-			0x3F, 0x40, 0x40, 0x40, 0x3F,
-			0x1F, 0x20, 0x40, 0x20, 0x1F,
-			0x3F, 0x40, 0x38, 0x40, 0x3F,
-			0x63, 0x14, 0x08, 0x14, 0x63,
-			0x03, 0x04, 0x78, 0x04, 0x03,
-			0x61, 0x59, 0x49, 0x4D, 0x43,
-			0x00, 0x7F, 0x41, 0x41, 0x41,
-			0x02, 0x04, 0x08, 0x10, 0x20,
-			0x00, 0x41, 0x41, 0x41, 0x7F,
-			0x04, 0x02, 0x01, 0x02, 0x04,
-			0x40, 0x40, 0x40, 0x40, 0x40,
-			0x00, 0x03, 0x07, 0x08, 0x00,
-			0x20, 0x54, 0x54, 0x78, 0x40,
-			0x7F, 0x28, 0x44, 0x44, 0x38,
-			0x38, 0x44, 0x44, 0x44, 0x28,
-			0x38, 0x44, 0x44, 0x28, 0x7F,
-			0x38, 0x54, 0x54, 0x54, 0x18,
-			0x00, 0x08, 0x7E, 0x09, 0x02,
-			0x18, 0xA4, 0xA4, 0x9C, 0x78,
-			0x7F, 0x08, 0x04, 0x04, 0x78,
-			0x00, 0x44, 0x7D, 0x40, 0x00,
-			0x20, 0x40, 0x40, 0x3D, 0x00,
-			0x7F, 0x10, 0x28, 0x44, 0x00,
-			0x00, 0x41, 0x7F, 0x40, 0x00,
-			0x7C, 0x04, 0x78, 0x04, 0x78,
-			0x7C, 0x08, 0x04, 0x04, 0x78,
-			0x38, 0x44, 0x44, 0x44, 0x38,
-			0xFC, 0x18, 0x24, 0x24, 0x18,
-			0x18, 0x24, 0x24, 0x18, 0xFC,
-			0x7C, 0x08, 0x04, 0x04, 0x08,
-			0x48, 0x54, 0x54, 0x54, 0x24,
-			0x04, 0x04, 0x3F, 0x44, 0x24,
-			0x3C, 0x40, 0x40, 0x20, 0x7C,
-			0x1C, 0x20, 0x40, 0x20, 0x1C,
-			0x3C, 0x40, 0x30, 0x40, 0x3C,
-			0x44, 0x28, 0x10, 0x28, 0x44,
-			0x4C, 0x90, 0x90, 0x90, 0x7C,
-			0x44, 0x64, 0x54, 0x4C, 0x44,
-			0x00, 0x08, 0x36, 0x41, 0x00,
-			0x00, 0x00, 0x77, 0x00, 0x00,
-			0x00, 0x41, 0x36, 0x08, 0x00,
-			0x02, 0x01, 0x02, 0x04, 0x02,
+			FONT_8X5_COLUMNS(FONT_COLUMN)
+};
+
+// every bit doubled vertically: a 2x column is 16 bits, low byte on the upper page
+#define FONT_X2_BIT(b, i) ((((b)>>(i))&1u)*(3u<<(2*(i))))
+#define FONT_COLUMN_X2(b) (uint16_t)(FONT_X2_BIT(b, 0)|FONT_X2_BIT(b, 1)|FONT_X2_BIT(b, 2)|FONT_X2_BIT(b, 3)| \
+                                     FONT_X2_BIT(b, 4)|FONT_X2_BIT(b, 5)|FONT_X2_BIT(b, 6)|FONT_X2_BIT(b, 7))
+
+/*
+ * font_8x5 at scale 2, without the header: one 16-bit column per source column
+ * (each is drawn twice horizontally)
+ */
+const uint16_t font_8x5_x2[] =
+{
+			FONT_8X5_COLUMNS(FONT_COLUMN_X2)
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -23,9 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <pico/stdlib.h>
-#include <hardware/i2c.h>
-#include <pico/binary_info.h>
+#include "hal/hal.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -34,22 +32,22 @@ SOFTWARE.
 #include "font.h"
 
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
+    int32_t t=*a;
     *a=*b;
-    *b=*t;
+    *b=t;
 }
 
-inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
-    switch(i2c_write_blocking(i2c, addr, src, len, false)) {
-    case PICO_ERROR_GENERIC:
+inline static bool fancy_write(hal_i2c_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
+    switch(hal_i2c_write(i2c, addr, src, len)) {
+    case HAL_I2C_ERR_NACK:
         printf("[%s] addr not acknowledged!\n", name);
-        break;
-    case PICO_ERROR_TIMEOUT:
+        return false;
+    case HAL_I2C_ERR_TIMEOUT:
         printf("[%s] timeout!\n", name);
-        break;
+        return false;
     default:
         //printf("[%s] wrote successfully %lu bytes!\n", name, len);
-        break;
+        return true;
     }
 }
 
@@ -58,7 +56,21 @@ inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
     fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
 }
 
-bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
+// several commands after one control byte, in a single transaction
+static bool ssd1306_write_cmds(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    uint8_t d[32];
+    if(len>=sizeof(d)) return false;
+    d[0]=0x00;
+    memcpy(d+1, cmds, len);
+    return fancy_write(p->i2c_i, p->address, d, len+1, "ssd1306_write_cmds");
+}
+
+bool ssd1306_probe(hal_i2c_t *i2c_instance, uint8_t address) {
+    uint8_t d[2]= {0x00, SET_DISP};
+    return hal_i2c_write(i2c_instance, address, d, 2)==2;
+}
+
+bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, hal_i2c_t *i2c_instance) {
     p->width=width;
     p->height=height;
     p->pages=height/8;
@@ -75,6 +87,13 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
     ++(p->buffer);
 
+    // without the shadow every show is a full refresh
+    p->shadow=malloc(p->bufsize);
+    p->shadow_valid=false;
+    p->sending=false;
+    p->tx_bytes=0;
+    p->tx_us=0;
+
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
         SET_DISP,
@@ -109,14 +128,12 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
-    for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
-
-    return true;
+    return ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
     free(p->buffer-1);
+    free(p->shadow);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -128,8 +145,8 @@ inline void ssd1306_poweron(ssd1306_t *p) {
 }
 
 inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+    uint8_t cmds[]= {SET_CONTRAST, val};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
@@ -152,6 +169,46 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
 }
 
+/**
+	@brief set or clear a rectangle with one mask per page
+
+	Pages entirely inside the rectangle are a memset of the column span; the top and
+	bottom pages (or a single page) are ORed/ANDed with a byte mask.
+*/
+static void ssd1306_fill_rect(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool set) {
+    if(x>=p->width || y>=p->height || !width || !height)
+        return;
+    if(width>p->width-x)
+        width=p->width-x;
+    if(height>p->height-y)
+        height=p->height-y;
+
+    uint32_t last=y+height-1;
+    for(uint32_t pg=y>>3; pg<=last>>3; ++pg) {
+        uint32_t top=pg==(y>>3)?(y&7):0;
+        uint32_t bottom=pg==(last>>3)?(last&7):7;
+        uint8_t mask=(uint8_t)((0xFFu<<top)&(0xFFu>>(7-bottom)));
+        uint8_t *b=p->buffer+pg*p->width+x;
+
+        if(mask==0xFF)
+            memset(b, set?0xFF:0x00, width);
+        else if(set)
+            for(uint32_t i=0; i<width; ++i)
+                b[i]|=mask;
+        else
+            for(uint32_t i=0; i<width; ++i)
+                b[i]&=(uint8_t)~mask;
+    }
+}
+
+void ssd1306_draw_hline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width) {
+    ssd1306_fill_rect(p, x, y, width, 1, true);
+}
+
+void ssd1306_draw_vline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t height) {
+    ssd1306_fill_rect(p, x, y, 1, height, true);
+}
+
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
     if(x1>x2) {
         swap(&x1, &x2);
@@ -161,8 +218,20 @@ void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t
     if(x1==x2) {
         if(y1>y2)
             swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+        if(x1<0 || y2<0)
+            return;
+        if(y1<0)
+            y1=0;
+        ssd1306_draw_vline(p, x1, y1, y2-y1+1);
+        return;
+    }
+
+    if(y1==y2) {
+        if(y1<0 || x2<0)
+            return;
+        if(x1<0)
+            x1=0;
+        ssd1306_draw_hline(p, x1, y1, x2-x1+1);
         return;
     }
 
@@ -174,16 +243,22 @@ void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t
     }
 }
 
+void ssd1306_scroll_left(ssd1306_t *p, uint8_t pg0, uint8_t pg1, uint32_t n) {
+    if(n>p->width)
+        n=p->width;
+    for(uint8_t pg=pg0; pg<=pg1 && pg<p->pages; ++pg) {
+        uint8_t *row=p->buffer+pg*p->width;
+        memmove(row, row+n, p->width-n);
+        memset(row+p->width-n, 0, n);
+    }
+}
+
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, x, y, width, height, false);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, x, y, width, height, true);
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -193,7 +268,7 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
     ssd1306_draw_line(p, x+width, y, x+width, y+height);
 }
 
-void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
+void ssd1306_draw_char_with_font_pixels(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
@@ -204,7 +279,11 @@ void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t
             uint8_t line=font[pp];
 
             for(int8_t j=0; j<8; ++j, line>>=1) {
-                if(line & 1)
+                if(!(line & 1))
+                    continue;
+                if(scale==1)
+                    ssd1306_draw_pixel(p, x+w, y+(lp<<3)+j);
+                else
                     ssd1306_draw_square(p, x+w*scale, y+((lp<<3)+j)*scale, scale, scale);
             }
 
@@ -213,6 +292,50 @@ void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t
     }
 }
 
+/**
+	@brief OR whole glyph columns into the framebuffer
+
+	Only for 8 pixel high fonts on a page boundary, fully on screen. Scale 1 is one
+	byte per column; scale 2 of font_8x5 comes from the pre-scaled font_8x5_x2 (two
+	bytes per column, each column written twice).
+
+	@return false if the glyph does not qualify (use the pixel path)
+*/
+static bool ssd1306_blit_char(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
+    if((y&7) || font[0]!=8 || x+font[1]*scale>p->width || y+8*scale>p->height)
+        return false;
+
+    uint32_t first=(uint32_t)(c-font[3])*font[1];
+    uint8_t *col=p->buffer+(y>>3)*p->width+x;
+    if(scale==1) {
+        const uint8_t *glyph=font+5+first;
+        for(uint8_t w=0; w<font[1]; ++w)
+            col[w]|=glyph[w];
+        return true;
+    }
+    if(scale==2 && font==font_8x5) {
+        const uint16_t *glyph=font_8x5_x2+first;
+        uint8_t *col_hi=col+p->width;
+        for(uint8_t w=0; w<font[1]; ++w) {
+            uint8_t lo=(uint8_t)glyph[w], hi=(uint8_t)(glyph[w]>>8);
+            col[2*w]|=lo;
+            col[2*w+1]|=lo;
+            col_hi[2*w]|=hi;
+            col_hi[2*w+1]|=hi;
+        }
+        return true;
+    }
+    return false;
+}
+
+void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
+    if(c<font[3]||c>font[4])
+        return;
+
+    if(!ssd1306_blit_char(p, x, y, scale, font, c))
+        ssd1306_draw_char_with_font_pixels(p, x, y, scale, font, c);
+}
+
 void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, const char *s) {
     for(int32_t x_n=x; *s; x_n+=(font[1]+font[2])*scale) {
         ssd1306_draw_char_with_font(p, x_n, y, scale, font, *(s++));
@@ -227,80 +350,151 @@ void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, c
     ssd1306_draw_string_with_font(p, x, y, scale, font_8x5, s);
 }
 
-static inline uint32_t ssd1306_bmp_get_val(const uint8_t *data, const size_t offset, uint8_t size) {
-    switch(size) {
-    case 1:
-        return data[offset];
-    case 2:
-        return data[offset]|(data[offset+1]<<8);
-    case 4:
-        return data[offset]|(data[offset+1]<<8)|(data[offset+2]<<16)|(data[offset+3]<<24);
-    default:
-        __builtin_unreachable();
+void ssd1306_draw_image(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *image, bool copy) {
+    const uint32_t width=image[0], height=image[1];
+    const uint8_t *data=image+2;
+    if(x>=p->width || y>=p->height || !width || !height) return;
+
+    const uint32_t cols=x+width>p->width?p->width-x:width;
+    const uint32_t shift=y&7;
+    uint8_t *row=p->buffer+(y>>3)*p->width+x;
+
+    for(uint32_t sp=0; sp<(height+7)>>3; ++sp, data+=width, row+=p->width) {
+        // rows of the image in this source page, moved down by shift: the low byte
+        // lands on page y/8+sp, the high byte on the next one
+        const uint32_t rows=height-sp*8<8?height-sp*8:8;
+        const uint16_t mask=(uint16_t)(((1u<<rows)-1)<<shift);
+        const uint32_t pg=(y>>3)+sp;
+
+        if(pg>=p->pages) break;
+        if(!shift && copy && mask==0xff) {
+            memcpy(row, data, cols);
+            continue;
+        }
+        for(uint32_t half=0; half<2; ++half) {
+            const uint8_t m=(uint8_t)(mask>>(half*8));
+            if(!m || pg+half>=p->pages) continue;
+            uint8_t *dst=row+half*p->width;
+            for(uint32_t i=0; i<cols; ++i) {
+                const uint8_t v=(uint8_t)(((uint16_t)data[i]<<shift)>>(half*8))&m;
+                dst[i]=copy?(uint8_t)((dst[i]&~m)|v):(uint8_t)(dst[i]|v);
+            }
+        }
     }
-    __builtin_unreachable();
 }
 
-void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const long size, uint32_t x_offset, uint32_t y_offset) {
-    if(size<54) // data smaller than header
-        return;
+// cost of a separate window: address + control byte 0x00 + 6 command bytes, then
+// address + control byte 0x40 for its data
+#define SSD1306_WINDOW_COST 10
 
-    const uint32_t bfOffBits=ssd1306_bmp_get_val(data, 10, 4);
-    const uint32_t biSize=ssd1306_bmp_get_val(data, 14, 4);
-    const uint32_t biWidth=ssd1306_bmp_get_val(data, 18, 4);
-    const int32_t biHeight=(int32_t) ssd1306_bmp_get_val(data, 22, 4);
-    const uint16_t biBitCount=(uint16_t) ssd1306_bmp_get_val(data, 28, 2);
-    const uint32_t biCompression=ssd1306_bmp_get_val(data, 30, 4);
+/**
+	@brief append columns c0..c1 of pages pg0..pg1 to the i2c batch
 
-    if(biBitCount!=1) // image not monochrome
-        return;
+	One command transaction sets the address window and one data transaction fills
+	it: in horizontal mode the controller wraps to the next page of the window by
+	itself, so the rows of all pages follow each other in the same transaction.
+	The batch copies the bytes, so the buffer may be redrawn right away.
+*/
+static bool ssd1306_add_window(ssd1306_t *p, uint8_t c0, uint8_t c1, uint8_t pg0, uint8_t pg1) {
+    static const uint8_t data_ctrl=0x40;
+    uint8_t offset=p->width==64?32:0;
+    uint8_t cmds[]= {0x00, SET_COL_ADDR, c0+offset, c1+offset, SET_PAGE_ADDR, pg0, pg1};
+    bool ok=hal_i2c_batch_add(cmds, sizeof(cmds), true);
+
+    size_t n=c1-c0+1;
+    p->tx_bytes+=sizeof(cmds)+1+n*(pg1-pg0+1);
+    ok=ok && hal_i2c_batch_add(&data_ctrl, 1, false);
+    if(c0==0 && n==p->width) // full rows are contiguous in the buffer
+        return ok && hal_i2c_batch_add(p->buffer+pg0*p->width, n*(pg1-pg0+1), true);
+    for(uint8_t pg=pg0; pg<=pg1; ++pg)
+        ok=ok && hal_i2c_batch_add(p->buffer+pg*p->width+c0, n, pg==pg1);
+    return ok;
+}
 
-    if(biCompression!=0) // image compressed
-        return;
+inline void ssd1306_invalidate(ssd1306_t *p) {
+    p->shadow_valid=false;
+}
 
-    const int table_start=14+biSize;
-    uint8_t color_val=0;
+bool ssd1306_busy(ssd1306_t *p) {
+    if(!p->sending)
+        return false;
 
-    for(uint8_t i=0; i<2; ++i) {
-        if(!((data[table_start+i*4]<<16)|(data[table_start+i*4+1]<<8)|data[table_start+i*4+2])) {
-            color_val=i;
-            break;
-        }
-    }
+    int rc=hal_i2c_batch_result();
+    if(rc==HAL_I2C_BUSY)
+        return true;
 
-    uint32_t bytes_per_line=(biWidth/8)+(biWidth&7?1:0);
-    if(bytes_per_line&3)
-        bytes_per_line=(bytes_per_line^(bytes_per_line&3))+4;
+    p->sending=false;
+    p->tx_us=rc<0?0:hal_i2c_batch_duration_us();
+    if(rc<0) {
+        printf("[ssd1306_show] %s!\n", rc==HAL_I2C_ERR_NACK?"addr not acknowledged":rc==HAL_I2C_ERR_TIMEOUT?"timeout":"batch too large");
+        p->shadow_valid=false; // display contents unknown: resend everything next time
+    }
+    return false;
+}
 
-    const uint8_t *img_data=data+bfOffBits;
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(ssd1306_busy(p) || !hal_i2c_batch_begin(p->i2c_i, p->address))
+        return false;
 
-    int32_t step=biHeight>0?-1:1;
-    int32_t border=biHeight>0?-1:-biHeight;
+    p->tx_bytes=0;
+    if(!p->shadow || !p->shadow_valid) {
+        ssd1306_add_window(p, 0, p->width-1, 0, p->pages-1);
+        if(p->shadow) {
+            memcpy(p->shadow, p->buffer, p->bufsize);
+            p->shadow_valid=true;
+        }
+    } else {
+        // changed column range of each page (lo > hi = clean)
+        uint8_t lo[8], hi[8];
+        for(uint8_t pg=0; pg<p->pages; ++pg) {
+            const uint8_t *b=p->buffer+pg*p->width, *s=p->shadow+pg*p->width;
+            lo[pg]=1;
+            hi[pg]=0;
+            if(!memcmp(b, s, p->width))
+                continue;
+            uint8_t l=0, h=p->width-1;
+            while(b[l]==s[l]) ++l;
+            while(b[h]==s[h]) --h;
+            lo[pg]=l;
+            hi[pg]=h;
+        }
 
-    for(uint32_t y=biHeight>0?biHeight-1:0; y!=(uint32_t)border; y+=step) {
-        for(uint32_t x=0; x<biWidth; ++x) {
-            if(((img_data[x>>3]>>(7-(x&7)))&1)==color_val)
-                ssd1306_draw_pixel(p, x_offset+x, y_offset+y);
+        for(uint8_t pg=0; pg<p->pages;) {
+            if(lo[pg]>hi[pg]) {
+                ++pg;
+                continue;
+            }
+            // extend the window to the next dirty page while widening the columns
+            // costs less than a separate address setup
+            uint8_t c0=lo[pg], c1=hi[pg], end=pg;
+            while(end+1<p->pages && lo[end+1]<=hi[end+1]) {
+                uint8_t n0=lo[end+1]<c0?lo[end+1]:c0;
+                uint8_t n1=hi[end+1]>c1?hi[end+1]:c1;
+                uint32_t extra=(uint32_t)(n1-n0+1)*(end-pg+2)-(uint32_t)(c1-c0+1)*(end-pg+1)-(hi[end+1]-lo[end+1]+1);
+                if(extra>=SSD1306_WINDOW_COST)
+                    break;
+                c0=n0;
+                c1=n1;
+                ++end;
+            }
+            ssd1306_add_window(p, c0, c1, pg, end);
+            for(uint8_t i=pg; i<=end; ++i)
+                memcpy(p->shadow+i*p->width+c0, p->buffer+i*p->width+c0, c1-c0+1);
+            pg=end+1;
         }
-        img_data+=bytes_per_line;
     }
-}
 
-inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size) {
-    ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
+    // the shadow already assumes success; ssd1306_busy() invalidates it on error
+    p->sending=true;
+    if(hal_i2c_batch_submit()<0)
+        ssd1306_busy(p);
+    return true;
 }
 
 void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
-    }
-
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
-
-    *(p->buffer-1)=0x40;
-
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
-}
\ No newline at end of file
+    while(ssd1306_busy(p))
+        ;
+    ssd1306_show_async(p);
+    while(ssd1306_busy(p))
+        ;
+}
@@ -30,8 +30,9 @@ SOFTWARE.
 
 #ifndef _inc_ssd1306
 #define _inc_ssd1306
-#include <pico/stdlib.h>
-#include <hardware/i2c.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal/hal.h"
 
 /**
 *	@brief defines commands used in ssd1306
@@ -64,15 +65,22 @@ typedef struct {
     uint8_t height; 	/**< height of display */
     uint8_t pages;		/**< stores pages of display (calculated on initialization*/
     uint8_t address; 	/**< i2c address of display*/
-    i2c_inst_t *i2c_i; 	/**< i2c connection instance */
+    hal_i2c_t *i2c_i; 	/**< i2c connection instance */
     bool external_vcc; 	/**< whether display uses external vcc */ 
     uint8_t *buffer;	/**< display buffer */
     size_t bufsize;		/**< buffer size */
+    uint8_t *shadow;	/**< copy of the display RAM, used to send only what changed (NULL = always full) */
+    bool shadow_valid;	/**< false forces a full refresh on the next show */
+    bool sending;		/**< a transfer started by ssd1306_show_async is in progress */
+    size_t tx_bytes;	/**< bytes queued by the last show (commands and data) */
+    uint32_t tx_us;		/**< bus time of the last completed transfer in us (0 after an error) */
 } ssd1306_t;
 
 /**
 *	@brief initialize display
 *
+*	All initialization commands go out in a single i2c transaction.
+*
 *	@param[in] p : pointer to instance of ssd1306_t
 *	@param[in] width : width of display
 *	@param[in] height : heigth of display
@@ -83,7 +91,20 @@ typedef struct {
 *	@retval true for Success
 *	@retval false if initialization failed
 */
-bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance);
+bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, hal_i2c_t *i2c_instance);
+
+/**
+	@brief check whether a display answers at the current bus speed
+
+	Sends a display off command (harmless before ssd1306_init, which starts with it).
+
+	@param[in] i2c_instance : instance of i2c connection
+	@param[in] address : i2c address of display
+
+	@return bool.
+	@retval true if the address was acknowledged
+*/
+bool ssd1306_probe(hal_i2c_t *i2c_instance, uint8_t address);
 
 /**
 *	@brief deinitialize display
@@ -130,11 +151,51 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	Only the pages that differ from what was last sent are transmitted, each one
+	limited to the range of changed columns; consecutive dirty pages share one
+	address window. An unchanged buffer sends nothing. Blocks until the transfer
+	is done (see ssd1306_show_async).
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief start sending the buffer without waiting for the bus
+
+	The changed windows are copied into the i2c batch (DMA on the RP2040), so the
+	buffer can be cleared and redrawn as soon as this returns. Completion and bus
+	errors are picked up by ssd1306_busy; an error forces a full refresh next time.
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true if the transfer was started
+	@retval false if the previous transfer is still running (nothing was sent)
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief poll the transfer started by ssd1306_show_async
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true while the transfer is in progress
+
+	When the transfer ends, tx_us holds its bus time (hal_i2c_batch_duration_us).
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
+/**
+	@brief force the next ssd1306_show to send the whole buffer
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -161,9 +222,33 @@ void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 */
 void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 
+/**
+	@brief draw horizontal line on buffer
+
+	@param[in] p : instance of display
+	@param[in] x : x position of leftmost pixel
+	@param[in] y : y position
+	@param[in] width : length in pixels (clipped to the display)
+*/
+void ssd1306_draw_hline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width);
+
+/**
+	@brief draw vertical line on buffer
+
+	One masked byte per page touched, instead of one read-modify-write per pixel.
+
+	@param[in] p : instance of display
+	@param[in] x : x position
+	@param[in] y : y position of topmost pixel
+	@param[in] height : length in pixels (clipped to the display)
+*/
+void ssd1306_draw_vline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t height);
+
 /**
 	@brief draw line on buffer
 
+	Horizontal and vertical lines go through ssd1306_draw_hline/ssd1306_draw_vline.
+
 	@param[in] p : instance of display
 	@param[in] x1 : x position of starting point
 	@param[in] y1 : y position of starting point
@@ -172,9 +257,23 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 */
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 
+/**
+	@brief shift whole pages of the buffer left, clearing the columns freed on the right
+
+	Used for scrolling graphs: only the new columns have to be drawn afterwards.
+
+	@param[in] p : instance of display
+	@param[in] pg0 : first page
+	@param[in] pg1 : last page
+	@param[in] n : columns to shift
+*/
+void ssd1306_scroll_left(ssd1306_t *p, uint8_t pg0, uint8_t pg1, uint32_t n);
+
 /**
 	@brief clear square at given position with given size
 
+	Rows that cover a whole page are cleared with memset, partial pages with a mask.
+
 	@param[in] p : instance of display
 	@param[in] x : x position of starting point
 	@param[in] y : y position of starting point
@@ -186,6 +285,8 @@ void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width,
 /**
 	@brief draw filled square at given position with given size
 
+	Rows that cover a whole page are filled with memset, partial pages with a mask.
+
 	@param[in] p : instance of display
 	@param[in] x : x position of starting point
 	@param[in] y : y position of starting point
@@ -206,36 +307,51 @@ void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, u
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 
 /**
-	@brief draw monochrome bitmap with offset
+	@brief draw packed image at given position
+
+	The image is stored in the controller's memory layout, as written by
+	tools/pack_image.py: one width byte and one height byte, then (height+7)/8 pages
+	of width column bytes each, bit 0 on top. At a y multiple of 8 the column bytes
+	go straight into the buffer; elsewhere each byte is split over two pages. Parts
+	beyond the right or bottom edge are clipped.
 
 	@param[in] p : instance of display
-	@param[in] data : image data (whole file)
-	@param[in] size : size of image data in bytes
-	@param[in] x_offset : offset of horizontal coordinate
-	@param[in] y_offset : offset of vertical coordinate
+	@param[in] x : x position of top left corner
+	@param[in] y : y position of top left corner
+	@param[in] image : packed image
+	@param[in] copy : true replaces the pixels under the image, false only sets its lit pixels
 */
-void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const long size, uint32_t x_offset, uint32_t y_offset);
+void ssd1306_draw_image(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *image, bool copy);
 
 /**
-	@brief draw monochrome bitmap
+	@brief draw char with given font
+
+	8 pixel high glyphs at a y multiple of 8 (scale 1, or scale 2 with the default
+	font) are ORed into the buffer a column byte at a time; anything else, including
+	glyphs that would be clipped, goes pixel by pixel.
 
 	@param[in] p : instance of display
-	@param[in] data : image data (whole file)
-	@param[in] size : size of image data in bytes
+	@param[in] x : x starting position of char
+	@param[in] y : y starting position of char
+	@param[in] scale : scale font to n times of original size (default should be 1)
+	@param[in] font : pointer to font
+	@param[in] c : character to draw
 */
-void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
+void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c);
 
 /**
-	@brief draw char with given font
+	@brief draw char with given font, always pixel by pixel
+
+	Same result as ssd1306_draw_char_with_font; any position, scale and font height.
 
 	@param[in] p : instance of display
 	@param[in] x : x starting position of char
 	@param[in] y : y starting position of char
-	@param[in] scale : scale font to n times of original size (default should be 1)
+	@param[in] scale : scale font to n times of original size
 	@param[in] font : pointer to font
 	@param[in] c : character to draw
 */
-void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c);
+void ssd1306_draw_char_with_font_pixels(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c);
 
 /**
 	@brief draw char with builtin font
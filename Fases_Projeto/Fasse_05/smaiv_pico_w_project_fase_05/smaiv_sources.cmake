@@ -0,0 +1,33 @@
+# Fontes portáveis do SMAIV: usam apenas a HAL (src/hal/hal.h) e são compiladas
+# tanto no firmware (CMakeLists.txt) quanto na simulação de host (host/CMakeLists.txt).
+set(SMAIV_ROOT ${CMAKE_CURRENT_LIST_DIR})
+# Kernels de DSP do Core 1 (também usados pelo benchmark, src/bench/dsp_bench.c).
+set(SMAIV_DSP_SOURCES
+    ${SMAIV_ROOT}/src/modules/audio_processing/audio_features.c
+    ${SMAIV_ROOT}/src/modules/audio_processing/audio_fft.c
+    ${SMAIV_ROOT}/src/modules/audio_processing/noise_floor.c
+    ${SMAIV_ROOT}/src/modules/sound_classifier/nn_int8.c
+    ${SMAIV_ROOT}/src/modules/sound_classifier/sound_classifier.c
+    ${SMAIV_ROOT}/src/modules/sound_classifier/sound_model_default.c
+)
+set(SMAIV_PORTABLE_SOURCES
+    ${SMAIV_DSP_SOURCES}
+    ${SMAIV_ROOT}/src/main.c
+    ${SMAIV_ROOT}/src/modules/audio_processing/audio_processing.c
+    ${SMAIV_ROOT}/src/modules/input_events/input_debounce.c
+    ${SMAIV_ROOT}/src/modules/input_events/input_events.c
+    ${SMAIV_ROOT}/src/modules/scheduler/scheduler.c
+    ${SMAIV_ROOT}/src/modules/profiler/profiler.c
+    ${SMAIV_ROOT}/src/modules/console/console.c
+    ${SMAIV_ROOT}/src/modules/fmt/fmt.c
+    ${SMAIV_ROOT}/src/modules/supervisor/supervisor.c
+    ${SMAIV_ROOT}/src/modules/recorder/recorder.c
+    ${SMAIV_ROOT}/src/modules/local_alerts/local_alerts.c
+    ${SMAIV_ROOT}/src/modules/mqtt_comm/mqtt_comm.c
+    ${SMAIV_ROOT}/src/modules/ui_manager/ui_manager.c
+    ${SMAIV_ROOT}/src/modules/ui_manager/ui_images.c
+    ${SMAIV_ROOT}/src/modules/feature_upload/feature_upload.c
+    ${SMAIV_ROOT}/src/modules/event_segmenter/event_segmenter.c
+    ${SMAIV_ROOT}/src/modules/noise_dose/noise_dose.c
+    ${SMAIV_ROOT}/lib/ssd1306/ssd1306.c
+)
@@ -0,0 +1,374 @@
+/**
+ * @file dsp_bench.c
+ * @brief Benchmark dos kernels de DSP do Core 1 (firmware smaiv_bench e host).
+ * @details Executa cada kernel da cadeia de áudio sobre um conjunto fixo de blocos
+ *          sintéticos, gerados só com aritmética inteira para que as entradas sejam
+ *          idênticas no RP2040 e no host, e mede cada chamada com o contador de
+ *          ciclos da HAL (SysTick no RP2040, relógio monotônico no host). O custo
+ *          do quadro completo, como no loop do Core 1, é comparado com o orçamento
+ *          de AUDIO_FRAME_MS.
+ *
+ *          A saída é uma linha JSON por kernel, seguida de um resumo; a ferramenta
+ *          tools/bench_compare.py compara duas execuções e acusa regressões. O
+ *          checksum resume as saídas do kernel: deve ser estável entre execuções na
+ *          mesma plataforma (kernels com float podem diferir no último bit entre as
+ *          bibliotecas matemáticas do RP2040 e do host).
+ *
+ *          No RP2040 o benchmark roda no Core 0, sem Wi-Fi nem Core 1, e é repetido
+ *          a cada tecla recebida pelo console USB. O resumo inclui os acertos do cache
+ *          do XIP durante os quadros completos, para comparar builds com e sem
+ *          SMAIV_RAM_HOT_PATH.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal.h"
+#include "config.h"
+#include "modules/audio_processing/audio_features.h"
+#include "modules/audio_processing/audio_fft.h"
+#include "modules/audio_processing/noise_floor.h"
+#include "modules/sound_classifier/sound_classifier.h"
+
+#define BENCH_ITERATIONS    256     ///< Chamadas medidas por kernel.
+#define BENCH_SIGNALS       6       ///< Blocos de entrada distintos (usados em rodízio).
+#define BENCH_OVERHEAD_RUNS 64      ///< Medições vazias para descontar o custo da leitura.
+
+#if SMAIV_HOST
+#define BENCH_PLATFORM      "host"
+#else
+#define BENCH_PLATFORM      "rp2040"
+#endif
+
+/**
+ * @brief Estatísticas de um kernel, em ciclos do contador da HAL.
+ */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t count;
+    uint32_t samples[BENCH_ITERATIONS];    ///< Para a mediana (robusta a interrupções).
+    uint32_t checksum;      ///< FNV-1a das saídas da primeira passada pelos sinais.
+} bench_stats_t;
+
+static uint16_t raw[BENCH_SIGNALS][AUDIO_BLOCK_SIZE];
+static int16_t centered[BENCH_SIGNALS][AUDIO_BLOCK_SIZE];
+static uint32_t power[BENCH_SIGNALS][AUDIO_FFT_BINS];
+static audio_frame_features_t features[BENCH_SIGNALS];
+
+static uint32_t overhead;
+static volatile uint32_t sink;  ///< Impede que o compilador descarte resultados.
+
+// =================================================================================
+// ENTRADAS SINTÉTICAS
+// =================================================================================
+
+static uint32_t lcg_state;
+
+static int32_t lcg_noise(int32_t amplitude) {
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return (int32_t)((lcg_state >> 16) % (uint32_t)(2 * amplitude + 1)) - amplitude;
+}
+
+/**
+ * @brief Onda triangular de amplitude a a partir de uma fase de 16 bits.
+ */
+static int32_t triangle(uint32_t phase, int32_t a) {
+    int32_t p = (int32_t)(phase & 0xFFFF);
+    int32_t v = (p < 0x8000) ? p : 0xFFFF - p;     // 0..0x7FFF
+    return (v - 0x4000) * a / 0x4000;
+}
+
+/**
+ * @brief Gera os blocos de teste no formato do ADC (12 bits, repouso em 2048).
+ * @details Silêncio com ruído leve, tons de 1 kHz e 125 Hz, ruído branco, impulsos e
+ *          uma varredura de frequência.
+ */
+static void generate_signals(void) {
+    lcg_state = 12345u;
+    uint32_t sweep_phase = 0;
+    uint32_t sweep_step = 0x0100;
+
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        int32_t s[BENCH_SIGNALS];
+        s[0] = lcg_noise(4);
+        s[1] = triangle(i * (0x10000 * 1000 / AUDIO_SAMPLE_RATE_HZ), 1000) + lcg_noise(8);
+        s[2] = triangle(i * (0x10000 * 125 / AUDIO_SAMPLE_RATE_HZ), 1500) + lcg_noise(8);
+        s[3] = lcg_noise(1024);
+        s[4] = (i % 64 == 0) ? 1800 : lcg_noise(16);
+        s[5] = triangle(sweep_phase, 1200);
+        sweep_phase += sweep_step;
+        sweep_step += 0x0080;
+
+        for (int k = 0; k < BENCH_SIGNALS; k++) {
+            int32_t v = 2048 + s[k];
+            raw[k][i] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+        }
+    }
+}
+
+// =================================================================================
+// MEDIÇÃO
+// =================================================================================
+
+static void checksum_add(uint32_t *h, const void *data, size_t len) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++) {
+        *h = (*h ^ p[i]) * 16777619u;
+    }
+}
+
+static void stats_reset(bench_stats_t *s) {
+    memset(s, 0, sizeof(*s));
+    s->min = UINT32_MAX;
+    s->checksum = 2166136261u;
+}
+
+static void stats_add(bench_stats_t *s, uint32_t cycles) {
+    cycles = cycles > overhead ? cycles - overhead : 0;
+    if (cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->sum += cycles;
+    if (s->count < BENCH_ITERATIONS) s->samples[s->count] = cycles;
+    s->count++;
+}
+
+/**
+ * @brief Mede uma execução de stmt e acumula em stats.
+ */
+#define BENCH_MEASURE(stats, stmt) do {                         \
+        uint32_t c0_ = hal_cycle_count();                       \
+        stmt;                                                   \
+        uint32_t c1_ = hal_cycle_count();                       \
+        stats_add((stats), hal_cycle_elapsed(c0_, c1_));        \
+    } while (0)
+
+static float cycles_to_us(uint64_t cycles) {
+    return (float)cycles * 1e6f / (float)hal_cycle_hz();
+}
+
+static uint32_t stats_median(bench_stats_t *s) {
+    uint32_t n = s->count < BENCH_ITERATIONS ? s->count : BENCH_ITERATIONS;
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t v = s->samples[i];
+        uint32_t j = i;
+        for (; j > 0 && s->samples[j - 1] > v; j--) {
+            s->samples[j] = s->samples[j - 1];
+        }
+        s->samples[j] = v;
+    }
+    return s->samples[n / 2];
+}
+
+static void report(const char *name, bench_stats_t *s) {
+    uint32_t mean = (uint32_t)(s->sum / s->count);
+    uint32_t median = stats_median(s);
+    printf("{\"bench\":\"%s\",\"platform\":\"%s\",\"iters\":%lu,\"min\":%lu,\"median\":%lu,"
+           "\"mean\":%lu,\"max\":%lu,\"hz\":%lu,\"mean_us\":%.2f,\"max_us\":%.2f,\"checksum\":\"%08lx\"}\n",
+           name, BENCH_PLATFORM, (unsigned long)s->count, (unsigned long)s->min, (unsigned long)median,
+           (unsigned long)mean, (unsigned long)s->max, (unsigned long)hal_cycle_hz(),
+           cycles_to_us(mean), cycles_to_us(s->max), (unsigned long)s->checksum);
+}
+
+static void report_skipped(const char *name, const char *reason) {
+    printf("{\"bench\":\"%s\",\"platform\":\"%s\",\"skipped\":\"%s\"}\n", name, BENCH_PLATFORM, reason);
+}
+
+static void measure_overhead(void) {
+    bench_stats_t s;
+    overhead = 0;
+    stats_reset(&s);
+    for (int i = 0; i < BENCH_OVERHEAD_RUNS; i++) {
+        BENCH_MEASURE(&s, (void)0);
+    }
+    overhead = s.min;
+}
+
+// =================================================================================
+// KERNELS
+// =================================================================================
+
+static void bench_center(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t k = i % BENCH_SIGNALS;
+        BENCH_MEASURE(&s, audio_features_center(raw[k], centered[k]));
+        if (i < BENCH_SIGNALS) checksum_add(&s.checksum, centered[k], sizeof(centered[k]));
+    }
+    report("dc_remove", &s);
+}
+
+static void bench_time_domain(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t k = i % BENCH_SIGNALS;
+        audio_frame_features_t f;
+        BENCH_MEASURE(&s, audio_features_time_domain(centered[k], &f));
+        if (i < BENCH_SIGNALS) {
+            checksum_add(&s.checksum, &f.rms, sizeof(f.rms));
+            checksum_add(&s.checksum, &f.zcr, sizeof(f.zcr));
+        }
+    }
+    report("rms_time_domain", &s);
+}
+
+static void bench_fft(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t k = i % BENCH_SIGNALS;
+        BENCH_MEASURE(&s, audio_fft_power(centered[k], power[k]));
+        if (i < BENCH_SIGNALS) checksum_add(&s.checksum, power[k], sizeof(power[k]));
+    }
+    report("fft_power", &s);
+}
+
+static void bench_features(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    audio_features_init();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t k = i % BENCH_SIGNALS;
+        BENCH_MEASURE(&s, audio_features_compute(centered[k], &features[k]));
+        if (i < BENCH_SIGNALS) checksum_add(&s.checksum, &features[k], sizeof(features[k]));
+    }
+    report("features_compute", &s);
+}
+
+static void bench_quantize(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        int8_t q[AUDIO_FEATURE_COUNT];
+        BENCH_MEASURE(&s, audio_features_quantize(&features[i % BENCH_SIGNALS], q));
+        if (i < BENCH_SIGNALS) checksum_add(&s.checksum, q, sizeof(q));
+    }
+    report("features_quantize", &s);
+}
+
+static void bench_noise_floor(void) {
+    bench_stats_t s;
+    stats_reset(&s);
+    noise_floor_init();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        float level;
+        BENCH_MEASURE(&s, level = noise_floor_process(power[i % BENCH_SIGNALS]));
+        if (i < BENCH_SIGNALS) checksum_add(&s.checksum, &level, sizeof(level));
+    }
+    report("noise_floor", &s);
+}
+
+static void bench_classifier(void) {
+    if (!sound_classifier_ready()) {
+        report_skipped("classifier", "sem modelo (SMAIV_SOUND_MODEL)");
+        return;
+    }
+    bench_stats_t s;
+    stats_reset(&s);
+    int8_t q[AUDIO_FEATURE_COUNT];
+    for (uint32_t i = 0; i < SOUND_CLASSIFIER_MAX_FRAMES; i++) {
+        audio_features_quantize(&features[i % BENCH_SIGNALS], q);
+        sound_classifier_push_frame(q);
+    }
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint8_t cls = 0;
+        int8_t score = 0;
+        audio_features_quantize(&features[i % BENCH_SIGNALS], q);
+        sound_classifier_push_frame(q);
+        BENCH_MEASURE(&s, sound_classifier_run(&cls, &score));
+        if (i < BENCH_SIGNALS) {
+            checksum_add(&s.checksum, &cls, sizeof(cls));
+            checksum_add(&s.checksum, &score, sizeof(score));
+        }
+    }
+    report("classifier", &s);
+}
+
+/**
+ * @brief Quadro completo, na mesma sequência do loop do Core 1 (sem a aquisição).
+ * @return Pior caso em ciclos (inclui os quadros com inferência).
+ */
+static void bench_frame(bench_stats_t *s) {
+    stats_reset(s);
+    audio_features_init();
+    noise_floor_init();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uint32_t k = i % BENCH_SIGNALS;
+        int16_t samples[AUDIO_BLOCK_SIZE];
+        audio_frame_features_t f;
+        int8_t q[AUDIO_FEATURE_COUNT];
+        uint8_t cls = SOUND_CLASS_UNKNOWN;
+        int8_t score = 0;
+        float event_level = 0.0f;
+
+        BENCH_MEASURE(s, {
+            audio_features_center(raw[k], samples);
+            audio_features_compute(samples, &f);
+            audio_features_quantize(&f, q);
+            sound_classifier_push_frame(q);
+            if ((i + 1) % SOUND_CLASSIFIER_HOP_FRAMES == 0) {
+                sound_classifier_run(&cls, &score);
+            }
+#if AUDIO_NOISE_FLOOR_ENABLED
+            event_level = noise_floor_process(audio_features_spectrum());
+#endif
+        });
+        sink = q[0] + cls + (uint32_t)event_level;
+        if (i < BENCH_SIGNALS) checksum_add(&s->checksum, q, sizeof(q));
+    }
+    report("frame_total", s);
+}
+
+static void run_all(void) {
+    bench_stats_t frame;
+    hal_xip_stats_t xip;
+
+    measure_overhead();
+    bench_center();
+    bench_time_domain();
+    bench_fft();
+    bench_features();
+    bench_quantize();
+    bench_noise_floor();
+    bench_classifier();
+    hal_xip_stats_reset();
+    bench_frame(&frame);
+    bool has_xip = hal_xip_stats(&xip);
+
+    float budget_us = AUDIO_FRAME_MS * 1000.0f;
+    float mean_us = cycles_to_us(frame.sum / frame.count);
+    float max_us = cycles_to_us(frame.max);
+    printf("{\"bench\":\"summary\",\"platform\":\"%s\",\"frame_budget_us\":%.0f,"
+           "\"frame_mean_us\":%.2f,\"frame_max_us\":%.2f,\"load_pct\":%.2f,\"worst_pct\":%.2f,"
+           "\"overhead\":%lu,\"xip_acc\":%lu,\"xip_miss\":%lu,\"xip_hit_pct\":%.2f}\n",
+           BENCH_PLATFORM, budget_us, mean_us, max_us, 100.0f * mean_us / budget_us,
+           100.0f * max_us / budget_us, (unsigned long)overhead, (unsigned long)xip.accesses,
+           (unsigned long)(xip.accesses - xip.hits),
+           (has_xip && xip.accesses) ? 100.0f * xip.hits / xip.accesses : -1.0f);
+}
+
+int main(void) {
+    hal_stdio_init();
+    while (!hal_stdio_connected()) {
+        hal_sleep_ms(100);
+    }
+
+    hal_cycle_counter_init();
+    audio_fft_init();
+    audio_features_init();
+    noise_floor_init();
+    sound_classifier_init();
+    generate_signals();
+
+    run_all();
+#if !SMAIV_HOST
+    while (true) {
+        if (hal_console_getc() >= 0) {
+            run_all();
+        }
+        hal_sleep_ms(50);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file fmt_bench.c
+ * @brief Microbenchmark da formatação de números: modules/fmt x snprintf (host).
+ * @details Monta os mesmos textos do firmware das duas formas, para um conjunto de
+ *          valores de nível, limiar e dose: a linha "Nivel:… Lim:…" da tela principal
+ *          e os payloads JSON de alerta e de dose do mqtt_comm. Os textos devem ser
+ *          idênticos; a saída é uma linha JSON por caso com a mediana de cada caminho
+ *          em ns por texto e o ganho.
+ *
+ *          O tamanho de código não é medido aqui: no firmware, compare a saída do
+ *          arm-none-eabi-size com a opção CMake SMAIV_PRINTF_FLOAT em ON e em OFF.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal.h"
+#include "modules/fmt/fmt.h"
+
+#define FMT_BENCH_VALUES        64      ///< Valores distintos formatados por medição.
+#define FMT_BENCH_ITERATIONS    256     ///< Repetições medidas por caso e caminho.
+
+typedef struct {
+    float level;
+    float threshold;
+    float leq;
+    float dose;
+    uint32_t start_ms;
+} fmt_bench_value_t;
+
+static fmt_bench_value_t values[FMT_BENCH_VALUES];
+static char out[2][FMT_BENCH_VALUES][256];
+static uint32_t samples[FMT_BENCH_ITERATIONS];
+
+// ---------------------------------------------------------------------------------
+// Casos: cada um tem a versão com fmt e a versão com snprintf.
+// ---------------------------------------------------------------------------------
+
+static void ui_line_fmt(char *buf, const fmt_bench_value_t *v) {
+    fmt_t f;
+    fmt_init(&f, buf, 256);
+    fmt_str(&f, "Nivel:");
+    fmt_float(&f, v->level, 0);
+    fmt_str(&f, " Lim:");
+    fmt_float(&f, v->threshold, 0);
+}
+
+static void ui_line_printf(char *buf, const fmt_bench_value_t *v) {
+    snprintf(buf, 256, "Nivel:%.0f Lim:%.0f", v->level, v->threshold);
+}
+
+static void alert_fmt(char *buf, const fmt_bench_value_t *v) {
+    fmt_t f;
+    fmt_init(&f, buf, 256);
+    fmt_str(&f, "{\"message\":\"ALERTA DE SOM ALTO DETECTADO!\", \"start_ms\":");
+    fmt_u32(&f, v->start_ms);
+    fmt_str(&f, ", \"end_ms\":");
+    fmt_u32(&f, v->start_ms + 1500);
+    fmt_str(&f, ", \"duration_ms\":");
+    fmt_u32(&f, 1500);
+    fmt_str(&f, ", \"peak\":");
+    fmt_float(&f, v->level, 1);
+    fmt_str(&f, ", \"leq_db\":");
+    fmt_float(&f, v->leq, 1);
+    fmt_str(&f, ", \"band_hz\":[");
+    fmt_u32(&f, 500);
+    fmt_char(&f, ',');
+    fmt_u32(&f, 1000);
+    fmt_str(&f, "], \"threshold\":");
+    fmt_float(&f, v->threshold, 1);
+    fmt_str(&f, ", \"class\":\"");
+    fmt_str(&f, "voz");
+    fmt_str(&f, "\", \"partial\":");
+    fmt_str(&f, "false}");
+}
+
+static void alert_printf(char *buf, const fmt_bench_value_t *v) {
+    snprintf(buf, 256,
+             "{\"message\":\"ALERTA DE SOM ALTO DETECTADO!\", \"start_ms\":%lu, \"end_ms\":%lu, \"duration_ms\":%lu, "
+             "\"peak\":%.1f, \"leq_db\":%.1f, \"band_hz\":[%u,%u], \"threshold\":%.1f, \"class\":\"%s\", \"partial\":%s}",
+             (unsigned long)v->start_ms, (unsigned long)(v->start_ms + 1500), 1500ul,
+             v->level, v->leq, 500u, 1000u, v->threshold, "voz", "false");
+}
+
+static void dose_fmt(char *buf, const fmt_bench_value_t *v) {
+    fmt_t f;
+    fmt_init(&f, buf, 256);
+    fmt_str(&f, "{\"dose_pct\":");
+    fmt_float(&f, v->dose, 2);
+    fmt_str(&f, ", \"projected_pct\":");
+    fmt_float(&f, v->dose * 3.2f, 1);
+    fmt_str(&f, ", \"twa_db\":");
+    fmt_float(&f, v->leq, 1);
+    fmt_str(&f, ", \"projected_twa_db\":");
+    fmt_float(&f, v->leq + 4.9f, 1);
+    fmt_str(&f, ", \"exposure_min\":");
+    fmt_u32(&f, v->start_ms / 60000);
+    fmt_char(&f, '}');
+}
+
+static void dose_printf(char *buf, const fmt_bench_value_t *v) {
+    snprintf(buf, 256,
+             "{\"dose_pct\":%.2f, \"projected_pct\":%.1f, \"twa_db\":%.1f, \"projected_twa_db\":%.1f, \"exposure_min\":%lu}",
+             v->dose, v->dose * 3.2f, v->leq, v->leq + 4.9f, (unsigned long)(v->start_ms / 60000));
+}
+
+typedef void (*fmt_bench_fn_t)(char *buf, const fmt_bench_value_t *v);
+
+typedef struct {
+    const char *name;
+    fmt_bench_fn_t fmt;
+    fmt_bench_fn_t printf;
+} fmt_bench_case_t;
+
+static const fmt_bench_case_t cases[] = {
+    { "ui_line", ui_line_fmt, ui_line_printf },
+    { "alert",   alert_fmt,   alert_printf },
+    { "dose",    dose_fmt,    dose_printf },
+};
+
+// ---------------------------------------------------------------------------------
+
+/**
+ * @brief Valores na faixa do firmware, de um gerador congruencial fixo (repetível).
+ */
+static void values_setup(void) {
+    uint32_t seed = 12345u;
+    for (size_t i = 0; i < FMT_BENCH_VALUES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        values[i].level = (float)(seed >> 8) / (1u << 24) * 4095.0f;
+        values[i].threshold = 40.0f + (float)(seed & 0x3Fu);
+        values[i].leq = 30.0f + (float)(seed >> 20) / 64.0f;
+        values[i].dose = (float)(seed >> 12) / (1u << 20) * 250.0f;
+        values[i].start_ms = seed >> 4;
+    }
+}
+
+static uint32_t median(uint32_t *v, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        size_t j = i;
+        for (; j > 0 && v[j - 1] > x; j--) {
+            v[j] = v[j - 1];
+        }
+        v[j] = x;
+    }
+    return v[n / 2];
+}
+
+static float measure(fmt_bench_fn_t fn, char (*dst)[256]) {
+    for (uint32_t i = 0; i < FMT_BENCH_ITERATIONS; i++) {
+        uint32_t t0 = hal_cycle_count();
+        for (size_t k = 0; k < FMT_BENCH_VALUES; k++) {
+            fn(dst[k], &values[k]);
+        }
+        samples[i] = hal_cycle_elapsed(t0, hal_cycle_count());
+    }
+    return median(samples, FMT_BENCH_ITERATIONS) * 1e9f / hal_cycle_hz() / FMT_BENCH_VALUES;
+}
+
+int main(void) {
+    values_setup();
+    hal_cycle_counter_init();
+
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        float fmt_ns = measure(cases[c].fmt, out[0]);
+        float printf_ns = measure(cases[c].printf, out[1]);
+        bool match = true;
+        for (size_t k = 0; k < FMT_BENCH_VALUES; k++) {
+            match = match && strcmp(out[0][k], out[1][k]) == 0;
+        }
+        failures += !match;
+        printf("{\"bench\":\"fmt\",\"case\":\"%s\",\"fmt_ns\":%.0f,\"snprintf_ns\":%.0f,"
+               "\"speedup\":%.1f,\"match\":%s}\n",
+               cases[c].name, fmt_ns, printf_ns, printf_ns / fmt_ns, match ? "true" : "false");
+    }
+    return failures ? 1 : 0;
+}
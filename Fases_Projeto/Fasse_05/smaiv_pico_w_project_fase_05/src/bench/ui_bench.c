@@ -0,0 +1,113 @@
+/**
+ * @file ui_bench.c
+ * @brief Microbenchmark do desenho de texto no framebuffer do SSD1306 (host).
+ * @details Desenha os textos das telas atuais do ui_manager (splash, principal, alerta e
+ *          ajustes) de duas formas: pelo caminho normal do driver, que copia colunas
+ *          inteiras quando o texto está alinhado a uma página (fonte 2x pré-escalada),
+ *          e pelo caminho pixel a pixel (ssd1306_draw_char_with_font_pixels). Os dois
+ *          framebuffers devem ser idênticos; a saída é uma linha JSON por tela com a
+ *          mediana de cada caminho em ns e o ganho.
+ *
+ *          Só o framebuffer é usado: nada é enviado por I2C.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal.h"
+#include "ssd1306/ssd1306.h"
+
+#define UI_BENCH_ITERATIONS 512     ///< Repetições medidas por tela e caminho.
+
+extern const uint8_t font_8x5[];    ///< Fonte padrão do driver (lib/ssd1306/font.h).
+
+/**
+ * @brief Um texto de uma tela, com a posição e escala usadas pelo ui_manager.
+ */
+typedef struct {
+    uint32_t x;
+    uint32_t y;
+    uint32_t scale;
+    const char *text;
+} ui_bench_text_t;
+
+typedef struct {
+    const char *name;
+    ui_bench_text_t texts[3];
+} ui_bench_screen_t;
+
+static const ui_bench_screen_t screens[] = {
+    { "splash",   { { 20, 16, 2, "SMAIV" }, { 16, 40, 1, "Inicializando..." } } },
+    { "main",     { { 0, 0, 2, "SMAIV" }, { 0, 24, 1, "Nivel:42 Lim:85" }, { 0, 48, 1, "MQTT: OK" } } },
+    { "alert",    { { 0, 0, 2, "SMAIV" }, { 0, 24, 1, "Nivel:120 Lim:85" }, { 0, 48, 2, "ALERTA!" } } },
+    { "settings", { { 0, 0, 2, "Ajustes" }, { 0, 24, 2, "Limiar: 85" }, { 0, 48, 1, "Joy:Muda | BtnA:Salva" } } },
+};
+
+static uint8_t framebuffer[2][128 * 64 / 8 + 1];
+static uint32_t samples[UI_BENCH_ITERATIONS];
+
+/**
+ * @brief Display apenas em memória (sem ssd1306_init, que acessaria o I2C).
+ */
+static void display_setup(ssd1306_t *p, uint8_t *buffer) {
+    memset(p, 0, sizeof(*p));
+    p->width = 128;
+    p->height = 64;
+    p->pages = 8;
+    p->bufsize = 128 * 64 / 8;
+    p->buffer = buffer + 1;     // Como no driver: o byte anterior é do protocolo.
+}
+
+static void draw_screen(ssd1306_t *p, const ui_bench_screen_t *screen, bool pixels) {
+    ssd1306_clear(p);
+    for (size_t i = 0; i < 3 && screen->texts[i].text; i++) {
+        const ui_bench_text_t *t = &screen->texts[i];
+        if (!pixels) {
+            ssd1306_draw_string(p, t->x, t->y, t->scale, t->text);
+            continue;
+        }
+        // Mesmo avanço de ssd1306_draw_string_with_font().
+        uint32_t x = t->x;
+        for (const char *c = t->text; *c; c++, x += (font_8x5[1] + font_8x5[2]) * t->scale) {
+            ssd1306_draw_char_with_font_pixels(p, x, t->y, t->scale, font_8x5, *c);
+        }
+    }
+}
+
+static uint32_t median(uint32_t *v, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        size_t j = i;
+        for (; j > 0 && v[j - 1] > x; j--) {
+            v[j] = v[j - 1];
+        }
+        v[j] = x;
+    }
+    return v[n / 2];
+}
+
+static float measure(ssd1306_t *p, const ui_bench_screen_t *screen, bool pixels) {
+    for (uint32_t i = 0; i < UI_BENCH_ITERATIONS; i++) {
+        uint32_t t0 = hal_cycle_count();
+        draw_screen(p, screen, pixels);
+        samples[i] = hal_cycle_elapsed(t0, hal_cycle_count());
+    }
+    return median(samples, UI_BENCH_ITERATIONS) * 1e9f / hal_cycle_hz();
+}
+
+int main(void) {
+    ssd1306_t fast, pixels;
+    display_setup(&fast, framebuffer[0]);
+    display_setup(&pixels, framebuffer[1]);
+    hal_cycle_counter_init();
+
+    int failures = 0;
+    for (size_t s = 0; s < sizeof(screens) / sizeof(screens[0]); s++) {
+        float fast_ns = measure(&fast, &screens[s], false);
+        float pixels_ns = measure(&pixels, &screens[s], true);
+        bool match = memcmp(fast.buffer, pixels.buffer, fast.bufsize) == 0;
+        failures += !match;
+        printf("{\"bench\":\"ui_text\",\"screen\":\"%s\",\"fast_ns\":%.0f,\"pixels_ns\":%.0f,"
+               "\"speedup\":%.1f,\"match\":%s}\n",
+               screens[s].name, fast_ns, pixels_ns, pixels_ns / fast_ns, match ? "true" : "false");
+    }
+    return failures ? 1 : 0;
+}
@@ -9,15 +9,46 @@
 #define COMMON_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "modules/audio_processing/audio_features.h"
 
 /**
  * @brief Enumeração para os diferentes estados da tela da UI.
  */
 typedef enum {
     SCREEN_MAIN,     ///< Tela principal de monitoramento.
-    SCREEN_SETTINGS  ///< Tela de configuração de parâmetros.
+    SCREEN_SETTINGS, ///< Tela de configuração de parâmetros.
+    SCREEN_GRAPH     ///< Histórico do nível (~2 min) e nível das bandas.
 } screen_t;
 
+/**
+ * @brief Classes de eventos sonoros reconhecidas pelo classificador embarcado.
+ * @details A ordem segue a camada de saída do modelo (índice do logit).
+ */
+typedef enum {
+    SOUND_CLASS_SPEECH = 0,  ///< Voz humana.
+    SOUND_CLASS_MUSIC,       ///< Música.
+    SOUND_CLASS_ALARM,       ///< Sirenes, alarmes e apitos.
+    SOUND_CLASS_IMPACT,      ///< Impactos, batidas e quedas.
+    SOUND_CLASS_MACHINERY,   ///< Máquinas e ruído industrial.
+    SOUND_CLASS_GLASS,       ///< Vidro quebrando.
+    SOUND_CLASS_COUNT,
+    SOUND_CLASS_UNKNOWN = 0xFF ///< Sem classificação (modelo ausente ou janela incompleta).
+} sound_class_t;
+
+/**
+ * @brief Registro de medição produzido pelo Core 1 a cada quadro de áudio.
+ */
+typedef struct {
+    uint32_t timestamp_ms;     ///< Instante (ms desde o boot) do fim do quadro.
+    float rms_level;           ///< Nível RMS do quadro.
+    float event_level;         ///< Nível acima do piso de ruído (igual ao RMS se desabilitado).
+    float la_db;               ///< Nível com ponderação A do quadro em dB (re 1 LSB do ADC).
+    uint8_t sound_class;       ///< Última classe inferida (sound_class_t).
+    int8_t class_score;        ///< Logit quantizado da classe vencedora.
+    int8_t features[AUDIO_FEATURE_COUNT]; ///< Características quantizadas do quadro.
+} measurement_t;
+
 /**
  * @brief Estrutura central que representa o estado completo do sistema SMAIAS.
  * @details Uma única instância desta struct é passada entre os módulos para garantir
@@ -27,6 +58,7 @@ typedef struct {
     // --- Estado do Áudio ---
     float current_sound_level; ///< Valor RMS atual do som ambiente.
     float sound_threshold;     ///< Limiar de ruído para disparo do alarme.
+    uint8_t sound_class;       ///< Classe do som atual segundo o classificador (sound_class_t).
 
     // --- Estado da UI ---
     screen_t current_screen;   ///< Tela atualmente ativa no display OLED.
@@ -25,13 +25,19 @@
 #define MIC_ADC_INPUT   2       ///< Canal do ADC correspondente ao GPIO28.
 
 #define JOYSTICK_Y_PIN  26      ///< GPIO para o eixo Y do joystick (usado para ajustes).
+#define JOYSTICK_Y_ADC_INPUT 0  ///< Canal do ADC correspondente ao GPIO26.
 #define JOYSTICK_SW_PIN 22      ///< GPIO para o botão (switch) do joystick (entrar no menu).
 #define BUTTON_A_PIN    5       ///< GPIO para o botão 'A' (salvar/resetar alarme).
 
 // --- Periféricos de Saída ---
-#define OLED_I2C_PORT   i2c1    ///< Instância do barramento I2C para o display.
+#define OLED_I2C_BUS    1       ///< Controlador I2C (i2c1) do display.
 #define OLED_SDA_PIN    14      ///< Pino de dados (SDA) para o display I2C.
 #define OLED_SCL_PIN    15      ///< Pino de clock (SCL) para o display I2C.
+#define OLED_I2C_ADDR   0x3C    ///< Endereço I2C do display.
+#ifndef OLED_I2C_HZ
+#define OLED_I2C_HZ     400000  ///< Fast-mode; 1000000 (SMAIV_OLED_FMPLUS) exige pull-ups externos.
+#endif
+#define OLED_I2C_FALLBACK_HZ 400000 ///< Usado se o display não responder a OLED_I2C_HZ.
 
 #define RGB_R_PIN       13      ///< Pino para o canal Vermelho do LED RGB.
 #define RGB_G_PIN       11      ///< Pino para o canal Verde do LED RGB.
@@ -63,5 +69,186 @@
 #define MQTT_BROKER_PORT 1883                                    ///< Porta padrão para MQTT não criptografado.
 #define MQTT_CLIENT_ID   "mqtt-smaiv"              ///< ID único para este dispositivo no broker.
 #define MQTT_TOPIC_ALERT "smaiv/alerta"     ///< Tópico onde os alertas serão publicados.
+#define MQTT_TOPIC_FEATURES "smaiv/features" ///< Tópico dos vetores de características (binário).
+#define MQTT_TOPIC_DOSE     "smaiv/dose"     ///< Tópico do resumo periódico de dose de ruído.
+#define MQTT_TOPIC_PROFILE  "smaiv/profile"  ///< Tópico das estatísticas de desempenho (JSON).
+#define MQTT_TOPIC_RESET    "smaiv/reset"    ///< Tópico da causa da última reinicialização (JSON).
+
+/**
+ * @brief Limite de pacotes de características (~1 s cada) enviados por evento.
+ */
+#define FEATURE_UPLOAD_MAX_PACKETS 30
+
+/**
+ * @brief Fila de publicação da tarefa de rede (apenas na variante FreeRTOS).
+ */
+#define MQTT_QUEUE_LEN      8       ///< Mensagens aguardando a tarefa de rede.
+#define MQTT_QUEUE_MSG_MAX  256     ///< Maior payload enfileirável (alerta JSON).
+
+
+// =================================================================================
+// SEÇÃO DE ENTRADAS DO USUÁRIO (BOTÕES E JOYSTICK)
+// =================================================================================
+
+#define INPUT_DEBOUNCE_MS     20      ///< Tempo sem bordas para aceitar uma mudança de nível.
+#define INPUT_LONG_PRESS_MS   600     ///< Tempo mantido para gerar um pressionamento longo.
+#define INPUT_REPEAT_MS       120     ///< Período de repetição do joystick após o pressionamento longo.
+#define INPUT_EDGE_QUEUE_LEN  32      ///< Capacidade da fila de bordas da interrupção de GPIO.
+#define INPUT_JOY_HIGH        3000    ///< Leitura do eixo Y acima da qual o joystick está "para cima".
+#define INPUT_JOY_LOW         1000    ///< Leitura do eixo Y abaixo da qual o joystick está "para baixo".
+#define INPUT_JOY_HYST        200     ///< Histerese aplicada para liberar as direções do joystick.
+
+
+// =================================================================================
+// SEÇÃO DO ESCALONADOR (CORE 0)
+// =================================================================================
+
+#define SCHED_TICK_MS           1       ///< Resolução da roda de temporizadores.
+#define SCHED_WHEEL_SLOTS       64      ///< Posições da roda (uma volta = 64 ms).
+#define SCHED_MAX_TASKS         12      ///< Máximo de tarefas registradas.
+#define SCHED_STATS_WINDOW_MS   1000    ///< Janela de cálculo da fração de tempo ocioso.
+
+#define INPUT_POLL_MS           10      ///< Período da tarefa de entrada (debounce e joystick).
+#define ALERTS_REFRESH_MS       250     ///< Atualização do LED de status (pisca a 2 Hz).
+#define UI_REFRESH_MS           100     ///< Verificação periódica de mudanças na tela.
+#define UI_MAX_FPS              10      ///< Limite de quadros enviados ao display por segundo.
+#define UI_HISTORY_COLUMN_MS    1000    ///< Intervalo por coluna do gráfico de histórico (128 colunas).
+#define DOSE_SERVICE_MS         1000    ///< Verificação da persistência/publicação da dose.
+#define HEALTH_LOG_INTERVAL_MS  10000   ///< Log de integridade do ADC e ocupação do Core 0.
+#define ALARM_SILENCE_MS        5000    ///< Tempo em que o alarme silenciado não pode disparar.
+
+
+// =================================================================================
+// SEÇÃO DE INSTRUMENTAÇÃO E CONSOLE
+// =================================================================================
+
+/**
+ * @brief Habilita os histogramas de tempo por tarefa e de jitter (ver profiler.h).
+ * @details Com 0, as macros PROFILE()/PROF_* não geram código.
+ */
+#ifndef PROFILING_ENABLED
+#define PROFILING_ENABLED       1
+#endif
+#define PROFILER_LINE_MAX       256     ///< Tamanho máximo de uma linha JSON do relatório.
+#define PROFILER_PUBLISH_MS     60000   ///< Período de publicação do relatório via MQTT.
+
+/**
+ * @brief Grava medições, entradas e decisões do Core 0 para reprodução (ver recorder.h).
+ * @details Ligado por cmake -DSMAIV_RECORDER=ON (linhas "REC" no USB, ~2,5 kB/s) e
+ *          sempre na compilação de host. Com 0, as macros REC_* não geram código.
+ */
+#ifndef RECORDER_ENABLED
+#define RECORDER_ENABLED        0
+#endif
+
+#define CONSOLE_POLL_MS         50      ///< Período de leitura do console USB.
+#define CONSOLE_MAX_COMMANDS    8       ///< Comandos registráveis no console.
+#define CONSOLE_LINE_MAX        64      ///< Tamanho máximo de uma linha de comando.
+
+
+// =================================================================================
+// SEÇÃO DO SUPERVISOR (WATCHDOG)
+// =================================================================================
+
+/**
+ * @brief O watchdog só é alimentado se todos os clientes fizeram check-in no prazo.
+ * @details O limite do hardware é ~8,3 s; a supervisão começa após a conexão Wi-Fi.
+ */
+#define SUP_WATCHDOG_MS         3000    ///< Tempo até o reset sem alimentação.
+#define SUP_SERVICE_MS          100     ///< Período da verificação dos clientes.
+#define SUP_MAX_CLIENTS         6       ///< Clientes registráveis.
+#define SUP_CORE0_TIMEOUT_MS    1000    ///< Prazo da tarefa de entrada (Core 0).
+#define SUP_UI_TIMEOUT_MS       2000    ///< Prazo da tarefa do display (I2C).
+#define SUP_DSP_TIMEOUT_MS      1000    ///< Prazo do DSP (Core 1), incluindo pausas de gravação na flash.
+#define SUP_LWIP_HEARTBEAT_MS   1000    ///< Período do temporizador de heartbeat da LwIP.
+#define SUP_LWIP_TIMEOUT_MS     10000   ///< Prazo do contexto da LwIP.
+
+
+// =================================================================================
+// SEÇÃO DA VARIANTE FREERTOS SMP (cmake -DSMAIV_FREERTOS=ON)
+// =================================================================================
+
+#ifndef SMAIV_FREERTOS
+#define SMAIV_FREERTOS          0       ///< Definido como 1 pelo CMake na variante FreeRTOS.
+#endif
+
+#define RTOS_PRIO_AUDIO         6       ///< DSP (fixado no Core 1).
+#define RTOS_PRIO_APP           5       ///< Medições, entrada e alarme (Core 0).
+#define RTOS_PRIO_ALERTS        5       ///< LEDs, buzzer e matriz (Core 0).
+#define RTOS_PRIO_NET           4       ///< Conexão Wi-Fi e publicação MQTT (Core 0).
+#define RTOS_PRIO_UI            2       ///< Display OLED (Core 0).
+#define RTOS_PRIO_BACKGROUND    1       ///< Dose de ruído e log de saúde (Core 0).
+#ifndef RTOS_STACK_WORDS
+#define RTOS_STACK_WORDS        1024    ///< Pilha de cada tarefa (palavras de 32 bits no RP2040).
+#endif
+
+
+// =================================================================================
+// SEÇÃO DE PROCESSAMENTO DE ÁUDIO (CORE 1)
+// =================================================================================
+
+#define AUDIO_SAMPLE_RATE_HZ    8000    ///< Taxa de amostragem do microfone (amostras/s).
+#define AUDIO_BLOCK_SIZE        256     ///< Amostras por bloco (um quadro = 32 ms a 8 kHz).
+#define AUDIO_FRAME_MS          (AUDIO_BLOCK_SIZE * 1000 / AUDIO_SAMPLE_RATE_HZ) ///< Duração de um quadro.
+#define AUDIO_MEAS_QUEUE_LEN    16      ///< Profundidade da fila de medições Core 1 -> Core 0.
+
+/**
+ * @brief Habilita a remoção do piso de ruído estacionário (subtração espectral).
+ * @details Com 1, o nível comparado ao limiar passa a ser apenas a energia acima do
+ *          ruído de fundo estimado (ex.: zumbido de máquinas); com 0, usa o RMS bruto.
+ */
+#define AUDIO_NOISE_FLOOR_ENABLED   1
+#define AUDIO_NOISE_OVERSUBTRACT    2   ///< Fator de sobre-subtração do piso (inteiro).
+#define AUDIO_NOISE_FALL_SHIFT      2   ///< Queda do piso: 1/4 da diferença por quadro.
+#define AUDIO_NOISE_RISE_SHIFT      8   ///< Subida do piso: 1/256 por quadro (~8 s).
+
+
+// =================================================================================
+// SEÇÃO DE SEGMENTAÇÃO DE EVENTOS
+// =================================================================================
+
+#define EVENT_RELEASE_RATIO     0.8f    ///< Evento continua enquanto nível >= limiar * razão.
+#define EVENT_HANGOVER_FRAMES   8       ///< Quadros abaixo da liberação para encerrar (~256 ms).
+#define EVENT_MAX_DURATION_MS   10000   ///< Eventos mais longos são reportados em partes.
+
+
+// =================================================================================
+// SEÇÃO DE DOSIMETRIA DE RUÍDO OCUPACIONAL (NR-15 / OSHA)
+// =================================================================================
+
+/**
+ * @brief Offset que converte o nível ponderado A (dB re 1 LSB do ADC) em dB(A) SPL.
+ * @details Depende do microfone e do ganho da placa; ajuste comparando com um
+ *          medidor de nível sonoro calibrado.
+ */
+#define DOSE_SPL_CALIBRATION_DB     30.0f
+#define DOSE_CRITERION_DB           85.0f   ///< Nível critério (NR-15: 85; OSHA PEL: 90).
+#define DOSE_EXCHANGE_RATE_DB       5.0f    ///< Fator de troca q (NR-15/OSHA: 5; NIOSH: 3).
+#define DOSE_THRESHOLD_DB           80.0f   ///< Nível limiar de integração.
+#define DOSE_SHIFT_HOURS            8       ///< Duração da jornada de referência.
+#define DOSE_PERSIST_INTERVAL_MS    (5 * 60 * 1000) ///< Intervalo entre gravações na flash.
+
+
+// =================================================================================
+// SEÇÃO DO CLASSIFICADOR DE EVENTOS SONOROS
+// =================================================================================
+
+/**
+ * @brief Número de quadros de características que formam a janela de entrada do modelo.
+ * @details 32 quadros de 32 ms correspondem a ~1 s de áudio.
+ */
+#define SOUND_CLASSIFIER_MAX_FRAMES  32
+#define SOUND_CLASSIFIER_HOP_FRAMES  8       ///< Executa a inferência a cada N quadros (~250 ms).
+#define SOUND_CLASSIFIER_ARENA_SIZE  2048    ///< Tamanho (bytes) da arena estática de tensores.
+#define SOUND_CLASSIFIER_MODEL_RAM_SIZE 8192 ///< Modelos até este tamanho são copiados para a SRAM.
+
+/**
+ * @brief Máscara de classes que geram alerta remoto (bit = 1 << sound_class_t).
+ * @details Por padrão apenas alarme, impacto e vidro quebrando são escalados.
+ *          Sem modelo carregado, todos os eventos continuam sendo escalados.
+ */
+#define SOUND_CLASS_ESCALATE_MASK   ((1u << SOUND_CLASS_ALARM) | \
+                                     (1u << SOUND_CLASS_IMPACT) | \
+                                     (1u << SOUND_CLASS_GLASS))
 
 #endif
\ No newline at end of file
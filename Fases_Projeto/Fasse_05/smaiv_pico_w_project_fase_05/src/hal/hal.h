@@ -0,0 +1,304 @@
+/**
+ * @file hal.h
+ * @brief Camada de abstração de hardware (HAL) usada por todos os módulos.
+ * @details Os módulos não chamam a Pico SDK diretamente: tempo, GPIO, PWM, I2C,
+ *          matriz WS2812, flash, watchdog, console e o lançamento do Core 1 passam
+ *          por esta interface. Há duas implementações:
+ *          - hal/pico/hal_pico.c: Pico SDK (firmware);
+ *          - hal/posix/hal_posix.c: simulação no Linux (SMAIV_HOST=1), com tempo
+ *            virtual, uma thread no papel do Core 1 e registro das saídas.
+ *          O ADC é abstraído pela interface do módulo adc_service, a fila entre
+ *          núcleos por hal_queue.h e a rede por hal_net.h.
+ */
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef SMAIV_HOST
+#define SMAIV_HOST 0    ///< Definido como 1 pela compilação de host (host/CMakeLists.txt).
+#endif
+
+#ifndef SMAIV_RAM_HOT_PATH
+#define SMAIV_RAM_HOT_PATH 1    ///< Caminho quente em SRAM (opção CMake SMAIV_RAM_HOT_PATH).
+#endif
+
+// =================================================================================
+// PLATAFORMA E TEMPO
+// =================================================================================
+
+/**
+ * @brief Inicializa o stdio (USB CDC no firmware, stdout na simulação).
+ */
+void hal_stdio_init(void);
+
+/**
+ * @brief Indica se há um terminal conectado ao stdio.
+ */
+bool hal_stdio_connected(void);
+
+/**
+ * @brief Lê um caractere do console sem bloquear.
+ * @return O caractere ou -1 se não houver dados.
+ */
+int hal_console_getc(void);
+
+/**
+ * @brief Tempo desde o boot em microssegundos (virtual na simulação).
+ */
+uint64_t hal_time_us(void);
+
+/**
+ * @brief 32 bits menos significativos de hal_time_us() (para medir durações curtas).
+ */
+uint32_t hal_time_us_32(void);
+
+/**
+ * @brief Tempo desde o boot em milissegundos.
+ */
+uint32_t hal_time_ms(void);
+
+void hal_sleep_us(uint64_t us);
+void hal_sleep_ms(uint32_t ms);
+
+/**
+ * @brief Dorme até o instante indicado ou até um evento (interrupção, SEV do Core 1).
+ * @param deadline_us Instante absoluto (hal_time_us) em que a espera termina.
+ */
+void hal_wait_event_until(uint64_t deadline_us);
+
+/**
+ * @brief Executa a função no Core 1 (na simulação, em uma thread).
+ * @details A função não deve retornar. No firmware, o Core 1 é preparado para ser
+ *          pausado com segurança durante gravações na flash.
+ */
+void hal_core1_launch(void (*entry)(void));
+
+// =================================================================================
+// CONTADOR DE CICLOS (benchmarks)
+// =================================================================================
+
+/**
+ * @brief Liga o contador de ciclos.
+ * @details RP2040: SysTick de 24 bits no clock do processador (intervalos de até
+ *          ~134 ms a 125 MHz). Host: relógio monotônico real em nanossegundos, pois
+ *          o tempo virtual da simulação não mede duração. Não usar na variante
+ *          FreeRTOS, cujo tick do kernel é o próprio SysTick.
+ */
+void hal_cycle_counter_init(void);
+
+/**
+ * @brief Leitura instantânea do contador (usar apenas com hal_cycle_elapsed()).
+ */
+uint32_t hal_cycle_count(void);
+
+/**
+ * @brief Ciclos decorridos entre duas leituras de hal_cycle_count().
+ */
+uint32_t hal_cycle_elapsed(uint32_t start, uint32_t end);
+
+/**
+ * @brief Frequência do contador em Hz (clock do sistema; 1 GHz no host).
+ */
+uint32_t hal_cycle_hz(void);
+
+// =================================================================================
+// POSICIONAMENTO EM SRAM E CACHE DO XIP
+// =================================================================================
+
+/**
+ * @brief Marca uma função ou tabela do caminho quente para execução/leitura na SRAM.
+ * @details No RP2040 o código roda da flash QSPI pelo cache do XIP (16 kB,
+ *          compartilhado pelos dois núcleos); uma falta custa alguns microssegundos e
+ *          o Core 0 (lwIP, display, printf) disputa o mesmo cache. As seções
+ *          ".time_critical.*" são copiadas pelo crt0 para a SRAM striped (como o
+ *          __not_in_flash_func da SDK). Uso: `void HAL_RAM_FUNC(nome)(args)` e
+ *          `const T HAL_RAM_DATA(nome)[N]`. No host, e com SMAIV_RAM_HOT_PATH = 0
+ *          (para comparar builds), não têm efeito.
+ */
+#if SMAIV_RAM_HOT_PATH && !SMAIV_HOST
+#define HAL_RAM_FUNC(name)  __attribute__((noinline, section(".time_critical." #name))) name
+#define HAL_RAM_DATA(name)  __attribute__((section(".time_critical." #name))) name
+#else
+#define HAL_RAM_FUNC(name)  name
+#define HAL_RAM_DATA(name)  name
+#endif
+
+/**
+ * @brief Contadores do cache do XIP (acessos cacheáveis dos dois núcleos somados).
+ */
+typedef struct {
+    uint32_t accesses;
+    uint32_t hits;
+} hal_xip_stats_t;
+
+/**
+ * @brief Lê os contadores desde o último hal_xip_stats_reset().
+ * @return false se a plataforma não tem XIP (host); out é zerado.
+ */
+bool hal_xip_stats(hal_xip_stats_t *out);
+
+void hal_xip_stats_reset(void);
+
+// =================================================================================
+// GPIO E PWM
+// =================================================================================
+
+typedef void (*hal_gpio_edge_cb_t)(uint32_t pin);
+
+void hal_gpio_init_output(uint32_t pin);
+void hal_gpio_init_input_pullup(uint32_t pin);
+void hal_gpio_put(uint32_t pin, bool value);
+bool hal_gpio_get(uint32_t pin);
+
+/**
+ * @brief Habilita a interrupção de bordas (subida e descida) de um pino.
+ * @details Todos os pinos compartilham o mesmo callback, executado em contexto de IRQ.
+ */
+void hal_gpio_enable_edge_irq(uint32_t pin, hal_gpio_edge_cb_t cb);
+
+/**
+ * @brief Configura um pino como saída PWM.
+ * @param clkdiv Divisor do clock do sistema.
+ * @param wrap Valor máximo do contador (período).
+ */
+void hal_pwm_init(uint32_t pin, float clkdiv, uint16_t wrap);
+void hal_pwm_set_level(uint32_t pin, uint16_t level);
+
+// =================================================================================
+// MATRIZ DE LEDS WS2812
+// =================================================================================
+
+void hal_ws2812_init(uint32_t pin, uint32_t num_leds);
+
+/**
+ * @brief Envia uma cor (formato GRB, 24 bits) para o próximo LED da cadeia.
+ */
+void hal_ws2812_put(uint32_t grb);
+
+// =================================================================================
+// I2C
+// =================================================================================
+
+/**
+ * @brief Barramento I2C (opaco; i2c_inst_t no firmware).
+ */
+typedef struct hal_i2c hal_i2c_t;
+
+#define HAL_I2C_ERR_NACK    (-1)    ///< Endereço não reconhecido.
+#define HAL_I2C_ERR_TIMEOUT (-2)    ///< Barramento travado.
+
+/**
+ * @brief Inicializa o barramento e seus pinos (com pull-up).
+ * @param bus Índice do controlador (0 ou 1).
+ * @return O barramento ou NULL se o índice for inválido.
+ */
+hal_i2c_t *hal_i2c_init(uint8_t bus, uint32_t sda_pin, uint32_t scl_pin, uint32_t baud_hz);
+
+/**
+ * @brief Escreve uma transação completa (START, endereço, dados, STOP).
+ * @details Se houver um lote assíncrono em andamento, espera o seu fim antes.
+ * @return Bytes escritos ou HAL_I2C_ERR_*.
+ */
+int hal_i2c_write(hal_i2c_t *bus, uint8_t addr, const uint8_t *src, size_t len);
+
+#define HAL_I2C_BUSY        (-3)    ///< Lote assíncrono ainda em andamento.
+#define HAL_I2C_ERR_SIZE    (-4)    ///< Lote maior que HAL_I2C_BATCH_MAX.
+#define HAL_I2C_BATCH_MAX   1280    ///< Bytes de um lote (somando todas as transações).
+
+/**
+ * @brief Começa a montar um lote de transações para o mesmo endereço.
+ * @details Um lote é enviado sem bloquear o chamador. RP2040: os bytes são copiados
+ *          para um buffer próprio, no formato do registrador IC_DATA_CMD, e um canal
+ *          de DMA alimenta a FIFO de TX do I2C; cada transação termina com STOP e a
+ *          seguinte começa com um novo START. Os dados de origem podem ser alterados
+ *          assim que hal_i2c_batch_add() retorna. Host: o lote é executado no envio.
+ *          Há um único lote por vez no sistema.
+ * @return false se o lote anterior ainda está em andamento.
+ */
+bool hal_i2c_batch_begin(hal_i2c_t *bus, uint8_t addr);
+
+/**
+ * @brief Acrescenta bytes ao lote em montagem.
+ * @param stop Encerra a transação corrente após estes bytes (a última transação do
+ *             lote é sempre encerrada no envio).
+ * @return false se o lote excedeu HAL_I2C_BATCH_MAX (o envio falhará).
+ */
+bool hal_i2c_batch_add(const uint8_t *src, size_t len, bool stop);
+
+/**
+ * @brief Inicia o envio do lote montado.
+ * @return 0 se iniciado ou HAL_I2C_ERR_SIZE.
+ */
+int hal_i2c_batch_submit(void);
+
+/**
+ * @brief Estado do último lote, sem bloquear (também conclui o lote quando pronto).
+ * @return HAL_I2C_BUSY, bytes enviados ou HAL_I2C_ERR_* (NACK em qualquer aborto do
+ *         controlador; TIMEOUT se o lote exceder o dobro do tempo nominal de barramento).
+ */
+int hal_i2c_batch_result(void);
+
+/**
+ * @brief Tempo de barramento do último lote concluído, em microssegundos.
+ * @details RP2040: da submissão ao STOP da última transação, marcado pela interrupção
+ *          STOP_DET do controlador (não depende de quando hal_i2c_batch_result() é
+ *          consultada). Host: tempo nominal na frequência do hal_i2c_init(), com 9 bits
+ *          por byte (8 + ACK) e START/STOP por transação.
+ * @return 0 se o último lote falhou ou nenhum foi concluído.
+ */
+uint32_t hal_i2c_batch_duration_us(void);
+
+// =================================================================================
+// ARMAZENAMENTO PERSISTENTE (FLASH)
+// =================================================================================
+
+#define HAL_STORAGE_PAGE_SIZE       256u
+#define HAL_STORAGE_SECTOR_SIZE     4096u
+#define HAL_STORAGE_SIZE            (2u * HAL_STORAGE_SECTOR_SIZE) ///< Dois últimos setores da flash.
+
+/**
+ * @brief Conteúdo da área persistente (leitura direta; mapeado pelo XIP no firmware).
+ */
+const uint8_t *hal_storage_read(uint32_t offset);
+
+/**
+ * @brief Grava uma página, apagando antes o setor se solicitado.
+ * @details Pausa o outro núcleo durante a operação.
+ * @return true se a gravação foi executada.
+ */
+bool hal_storage_program_page(uint32_t offset, const uint8_t *page, bool erase_sector);
+
+// =================================================================================
+// WATCHDOG
+// =================================================================================
+
+#define HAL_WATCHDOG_SCRATCH_COUNT  4   ///< Registradores de scratch livres (os 4-7 são da SDK).
+
+void hal_watchdog_enable(uint32_t timeout_ms);
+void hal_watchdog_feed(void);
+bool hal_watchdog_caused_reboot(void);
+uint32_t hal_watchdog_scratch_get(uint8_t index);
+void hal_watchdog_scratch_set(uint8_t index, uint32_t value);
+
+/**
+ * @brief Reinicia o sistema imediatamente (os registradores de scratch são mantidos).
+ */
+void hal_reboot(void) __attribute__((noreturn));
+
+// =================================================================================
+// GRAVAÇÃO DO FLUXO DE MEDIÇÕES (modules/recorder)
+// =================================================================================
+
+#define HAL_RECORD_FRAME_MAX    64  ///< Maior registro aceito por hal_record_write().
+
+/**
+ * @brief Transmite um registro codificado.
+ * @details RP2040: uma linha "REC <hex>" no stdio USB (intercalada com o log).
+ *          Host: arquivo binário com um byte de tamanho antes de cada registro.
+ */
+void hal_record_write(const uint8_t *frame, size_t len);
+
+#endif
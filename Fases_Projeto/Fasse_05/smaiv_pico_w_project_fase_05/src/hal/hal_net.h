@@ -0,0 +1,53 @@
+/**
+ * @file hal_net.h
+ * @brief Rede (HAL): Wi-Fi e transporte MQTT.
+ * @details No firmware usa o CYW43 e a LwIP (hal/pico/hal_net_pico.c); na simulação
+ *          a conexão é imediata e cada publicação é registrada em um log
+ *          (hal/posix/hal_net_posix.c). As funções hal_mqtt_* e hal_net_timeout
+ *          devem ser chamadas entre hal_net_lock() e hal_net_unlock(), exceto a
+ *          partir dos próprios callbacks da pilha.
+ */
+#ifndef HAL_NET_H
+#define HAL_NET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Notificação de mudança do estado da sessão MQTT.
+ * @param connected true se o broker aceitou a conexão.
+ * @param code Código de status da pilha (0 = aceito; negativo = falha de DNS).
+ */
+typedef void (*hal_mqtt_status_cb_t)(bool connected, int code);
+
+/**
+ * @brief Inicializa o rádio em modo estação.
+ * @return false se o chip Wi-Fi não pôde ser inicializado.
+ */
+bool hal_net_init(void);
+
+/**
+ * @brief Conecta à rede Wi-Fi (bloqueante).
+ */
+bool hal_net_wifi_connect(const char *ssid, const char *password, uint32_t timeout_ms);
+
+void hal_net_lock(void);
+void hal_net_unlock(void);
+
+/**
+ * @brief Agenda um callback no contexto da pilha de rede (disparo único).
+ */
+void hal_net_timeout(uint32_t ms, void (*cb)(void *arg), void *arg);
+
+/**
+ * @brief Resolve o broker e abre a sessão MQTT (assíncrono; resultado via callback).
+ */
+bool hal_mqtt_connect(const char *host, uint16_t port, const char *client_id, hal_mqtt_status_cb_t cb);
+
+/**
+ * @brief Publica uma mensagem na sessão aberta.
+ * @return false se a pilha recusou a mensagem (sem memória, sem conexão).
+ */
+bool hal_mqtt_publish(const char *topic, const void *payload, uint16_t len, uint8_t qos);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file hal_queue.h
+ * @brief Fila de tamanho fixo segura entre núcleos (HAL).
+ * @details No firmware é a pico/util/queue da SDK (spinlock + SEV ao inserir); na
+ *          simulação, uma fila circular protegida por mutex que também sinaliza o
+ *          evento que acorda hal_wait_event_until().
+ */
+#ifndef HAL_QUEUE_H
+#define HAL_QUEUE_H
+
+#include "hal.h"
+
+#if SMAIV_HOST
+
+#include <pthread.h>
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint8_t *data;
+    uint32_t element_size;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+} hal_queue_t;
+
+void hal_queue_init(hal_queue_t *q, uint32_t element_size, uint32_t capacity);
+bool hal_queue_try_add(hal_queue_t *q, const void *element);
+bool hal_queue_try_remove(hal_queue_t *q, void *element);
+bool hal_queue_is_empty(hal_queue_t *q);
+
+#else
+
+#include "pico/util/queue.h"
+
+typedef queue_t hal_queue_t;
+
+static inline void hal_queue_init(hal_queue_t *q, uint32_t element_size, uint32_t capacity) {
+    queue_init(q, element_size, capacity);
+}
+
+static inline bool hal_queue_try_add(hal_queue_t *q, const void *element) {
+    return queue_try_add(q, element);
+}
+
+static inline bool hal_queue_try_remove(hal_queue_t *q, void *element) {
+    return queue_try_remove(q, element);
+}
+
+static inline bool hal_queue_is_empty(hal_queue_t *q) {
+    return queue_is_empty(q);
+}
+
+#endif
+
+#endif
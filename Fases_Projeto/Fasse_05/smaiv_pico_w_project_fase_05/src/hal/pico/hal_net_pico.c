@@ -0,0 +1,105 @@
+/**
+ * @file hal_net_pico.c
+ * @brief Implementação da rede da HAL com o CYW43 e o cliente MQTT da LwIP.
+ * @details A conexão é assíncrona: o nome do broker é resolvido por DNS e a sessão
+ *          MQTT só é aberta dentro do callback de resolução.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal_net.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/apps/mqtt.h"
+#include "lwip/dns.h"
+#include "lwip/timeouts.h"
+
+/**
+ * @brief Estrutura interna para manter o estado do cliente LwIP MQTT.
+ */
+typedef struct {
+    ip_addr_t remote_addr;      ///< Endereço IP resolvido do broker.
+    mqtt_client_t *mqtt_client; ///< Ponteiro para a instância do cliente MQTT da LwIP.
+    const char *host;
+    const char *client_id;
+    uint16_t port;
+    hal_mqtt_status_cb_t status_cb;
+} mqtt_state_t;
+static mqtt_state_t mqtt_state;
+
+bool hal_net_init(void) {
+    if (cyw43_arch_init()) {
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+    return true;
+}
+
+bool hal_net_wifi_connect(const char *ssid, const char *password, uint32_t timeout_ms) {
+    return cyw43_arch_wifi_connect_timeout_ms(ssid, password, CYW43_AUTH_WPA2_AES_PSK, timeout_ms) == 0;
+}
+
+void hal_net_lock(void) {
+    cyw43_arch_lwip_begin();
+}
+
+void hal_net_unlock(void) {
+    cyw43_arch_lwip_end();
+}
+
+void hal_net_timeout(uint32_t ms, void (*cb)(void *arg), void *arg) {
+    sys_timeout(ms, cb, arg);
+}
+
+/**
+ * @brief Callback invocado pela LwIP quando o estado da conexão MQTT muda.
+ */
+static void mqtt_connection_cb(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
+    (void)client;
+    (void)arg;
+    mqtt_state.status_cb(status == MQTT_CONNECT_ACCEPTED, (int)status);
+}
+
+/**
+ * @brief Callback invocado pela LwIP quando a resolução de DNS é concluída.
+ */
+static void dns_found_cb(const char *name, const ip_addr_t *ipaddr, void *arg) {
+    (void)arg;
+    // Aborta se a resolução de DNS falhar.
+    if (ipaddr == NULL) {
+        printf("DNS: Falha ao resolver o hostname '%s'.\n", name);
+        mqtt_state.status_cb(false, -1);
+        return;
+    }
+
+    // Armazena o IP resolvido e inicia a conexão MQTT.
+    mqtt_state.remote_addr = *ipaddr;
+    struct mqtt_connect_client_info_t client_info;
+    memset(&client_info, 0, sizeof(client_info));
+    client_info.client_id = mqtt_state.client_id;
+    client_info.keep_alive = 60;
+
+    mqtt_client_connect(mqtt_state.mqtt_client, &mqtt_state.remote_addr, mqtt_state.port,
+                        mqtt_connection_cb, NULL, &client_info);
+}
+
+bool hal_mqtt_connect(const char *host, uint16_t port, const char *client_id, hal_mqtt_status_cb_t cb) {
+    mqtt_state.host = host;
+    mqtt_state.port = port;
+    mqtt_state.client_id = client_id;
+    mqtt_state.status_cb = cb;
+
+    mqtt_state.mqtt_client = mqtt_client_new();
+    if (mqtt_state.mqtt_client == NULL) {
+        return false;
+    }
+    // Dispara a requisição de DNS. É uma operação não-bloqueante.
+    err_t err = dns_gethostbyname(host, &mqtt_state.remote_addr, dns_found_cb, NULL);
+    if (err == ERR_OK) {
+        // Endereço já em cache: o callback não será chamado.
+        dns_found_cb(host, &mqtt_state.remote_addr, NULL);
+    }
+    return err == ERR_OK || err == ERR_INPROGRESS;
+}
+
+bool hal_mqtt_publish(const char *topic, const void *payload, uint16_t len, uint8_t qos) {
+    return mqtt_publish(mqtt_state.mqtt_client, topic, payload, len, qos, 0, NULL, NULL) == ERR_OK;
+}
@@ -0,0 +1,457 @@
+/**
+ * @file hal_pico.c
+ * @brief Implementação da HAL sobre a Pico SDK (firmware RP2040).
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal.h"
+#include "config.h"
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/flash.h"
+#include "hardware/watchdog.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "ws2812.pio.h"
+
+#if !SMAIV_FREERTOS
+#include "pico/multicore.h"
+#endif
+
+// =================================================================================
+// PLATAFORMA E TEMPO
+// =================================================================================
+
+void hal_stdio_init(void) {
+    stdio_init_all();
+}
+
+bool hal_stdio_connected(void) {
+    return stdio_usb_connected();
+}
+
+int hal_console_getc(void) {
+    int c = getchar_timeout_us(0);
+    return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+uint64_t hal_time_us(void) {
+    return time_us_64();
+}
+
+uint32_t HAL_RAM_FUNC(hal_time_us_32)(void) {
+    return time_us_32();
+}
+
+void hal_cycle_counter_init(void) {
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = M0PLUS_SYST_CSR_CLKSOURCE_BITS | M0PLUS_SYST_CSR_ENABLE_BITS;
+}
+
+uint32_t hal_cycle_count(void) {
+    return systick_hw->cvr;
+}
+
+uint32_t hal_cycle_elapsed(uint32_t start, uint32_t end) {
+    return (start - end) & 0x00FFFFFF;  // O SysTick conta para baixo.
+}
+
+uint32_t hal_cycle_hz(void) {
+    return clock_get_hz(clk_sys);
+}
+
+bool hal_xip_stats(hal_xip_stats_t *out) {
+    out->accesses = xip_ctrl_hw->ctr_acc;
+    out->hits = xip_ctrl_hw->ctr_hit;
+    return true;
+}
+
+void hal_xip_stats_reset(void) {
+    xip_ctrl_hw->ctr_acc = 0;   // Qualquer escrita zera o contador.
+    xip_ctrl_hw->ctr_hit = 0;
+}
+
+uint32_t hal_time_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+void hal_sleep_us(uint64_t us) {
+    sleep_us(us);
+}
+
+void hal_sleep_ms(uint32_t ms) {
+    sleep_ms(ms);
+}
+
+void hal_wait_event_until(uint64_t deadline_us) {
+    best_effort_wfe_or_timeout(from_us_since_boot(deadline_us));
+}
+
+#if !SMAIV_FREERTOS
+static void (*core1_entry_fn)(void);
+
+/**
+ * @brief Prepara o Core 1 para ser pausado durante gravações na flash e executa a função.
+ */
+static void core1_trampoline(void) {
+    flash_safe_execute_core_init();
+    core1_entry_fn();
+}
+
+void hal_core1_launch(void (*entry)(void)) {
+    core1_entry_fn = entry;
+    multicore_launch_core1(core1_trampoline);
+}
+#endif
+
+// =================================================================================
+// GPIO E PWM
+// =================================================================================
+
+void hal_gpio_init_output(uint32_t pin) {
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_OUT);
+}
+
+void hal_gpio_init_input_pullup(uint32_t pin) {
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
+}
+
+void hal_gpio_put(uint32_t pin, bool value) {
+    gpio_put(pin, value);
+}
+
+bool HAL_RAM_FUNC(hal_gpio_get)(uint32_t pin) {
+    return gpio_get(pin);
+}
+
+static hal_gpio_edge_cb_t gpio_edge_cb;
+
+static void HAL_RAM_FUNC(gpio_irq_dispatch)(uint gpio, uint32_t events) {
+    (void)events;
+    gpio_edge_cb(gpio);
+}
+
+void hal_gpio_enable_edge_irq(uint32_t pin, hal_gpio_edge_cb_t cb) {
+    gpio_edge_cb = cb;
+    gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, gpio_irq_dispatch);
+}
+
+void hal_pwm_init(uint32_t pin, float clkdiv, uint16_t wrap) {
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv(&config, clkdiv);
+    pwm_config_set_wrap(&config, wrap);
+    pwm_init(pwm_gpio_to_slice_num(pin), &config, true);
+}
+
+void hal_pwm_set_level(uint32_t pin, uint16_t level) {
+    pwm_set_gpio_level(pin, level);
+}
+
+// =================================================================================
+// MATRIZ DE LEDS WS2812 (PIO)
+// =================================================================================
+
+static PIO ws2812_pio = pio0;
+static uint ws2812_sm = 0;
+
+void hal_ws2812_init(uint32_t pin, uint32_t num_leds) {
+    (void)num_leds;
+    uint offset = pio_add_program(ws2812_pio, &ws2812_program);
+
+    pio_gpio_init(ws2812_pio, pin);
+    pio_sm_set_consecutive_pindirs(ws2812_pio, ws2812_sm, pin, 1, true);
+    pio_sm_config c = ws2812_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_out_shift(&c, false, true, 24);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    int cycles_per_bit = ws2812_T1 + ws2812_T2 + ws2812_T3;
+    float div = clock_get_hz(clk_sys) / (800000.0f * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+    pio_sm_init(ws2812_pio, ws2812_sm, offset, &c);
+    pio_sm_set_enabled(ws2812_pio, ws2812_sm, true);
+}
+
+void hal_ws2812_put(uint32_t grb) {
+    pio_sm_put_blocking(ws2812_pio, ws2812_sm, grb << 8u);
+}
+
+// =================================================================================
+// I2C
+// =================================================================================
+
+static uint32_t i2c_baud_hz[NUM_I2CS];   ///< Taxa efetiva de cada barramento (timeout dos lotes).
+
+/**
+ * @brief Lote assíncrono (um por vez no sistema).
+ */
+static struct {
+    i2c_inst_t *bus;        ///< Barramento do lote em montagem ou em envio.
+    uint8_t addr;
+    bool sending;           ///< DMA iniciado e lote ainda não concluído.
+    bool overflow;
+    int dma_chan;           ///< Reservado no primeiro lote.
+    size_t count;           ///< Palavras em words[].
+    uint64_t deadline_us;
+    int result;             ///< Resultado do último lote concluído.
+    uint32_t start_us;      ///< Instante da submissão.
+    volatile uint32_t end_us;   ///< STOP da última transação (marcado pela IRQ).
+    volatile bool end_valid;
+    uint32_t duration_us;   ///< Tempo de barramento do último lote concluído.
+    uint8_t irq_ready;      ///< Barramentos com o handler de STOP_DET instalado (bits).
+} batch = { .dma_chan = -1 };
+
+/// Bytes no formato de IC_DATA_CMD (bit STOP no último byte de cada transação).
+static uint16_t batch_words[HAL_I2C_BATCH_MAX];
+
+hal_i2c_t *hal_i2c_init(uint8_t bus, uint32_t sda_pin, uint32_t scl_pin, uint32_t baud_hz) {
+    if (bus >= NUM_I2CS) {
+        return NULL;
+    }
+    i2c_inst_t *i2c = i2c_get_instance(bus);
+    i2c_baud_hz[bus] = i2c_init(i2c, baud_hz);
+    gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_pin);
+    gpio_pull_up(scl_pin);
+    return (hal_i2c_t *)i2c;
+}
+
+int hal_i2c_write(hal_i2c_t *bus, uint8_t addr, const uint8_t *src, size_t len) {
+    while (hal_i2c_batch_result() == HAL_I2C_BUSY) {
+        tight_loop_contents();
+    }
+    int rc = i2c_write_blocking((i2c_inst_t *)bus, addr, src, len, false);
+    if (rc == PICO_ERROR_GENERIC) return HAL_I2C_ERR_NACK;
+    if (rc == PICO_ERROR_TIMEOUT) return HAL_I2C_ERR_TIMEOUT;
+    return rc;
+}
+
+bool hal_i2c_batch_begin(hal_i2c_t *bus, uint8_t addr) {
+    if (hal_i2c_batch_result() == HAL_I2C_BUSY) {
+        return false;
+    }
+    batch.bus = (i2c_inst_t *)bus;
+    batch.addr = addr;
+    batch.count = 0;
+    batch.overflow = false;
+    return true;
+}
+
+bool hal_i2c_batch_add(const uint8_t *src, size_t len, bool stop) {
+    if (batch.count + len > HAL_I2C_BATCH_MAX) {
+        batch.overflow = true;
+        return false;
+    }
+    uint16_t *w = &batch_words[batch.count];
+    for (size_t i = 0; i < len; i++) {
+        w[i] = src[i];
+    }
+    batch.count += len;
+    if (stop && batch.count > 0) {
+        batch_words[batch.count - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    }
+    return true;
+}
+
+/**
+ * @brief STOP_DET do barramento do lote: a cada fim de transação, verifica se foi o
+ *        último (DMA concluído e FIFO de TX vazia) e marca o instante.
+ * @details Habilitada só durante o envio de um lote: fora dele, o i2c_write_blocking()
+ *          da SDK consulta e limpa o STOP_DET por conta própria.
+ */
+static void HAL_RAM_FUNC(batch_i2c_irq)(void) {
+    i2c_hw_t *hw = i2c_get_hw(batch.bus);
+    (void)hw->clr_stop_det;
+    if (!dma_channel_is_busy(batch.dma_chan) && (hw->status & I2C_IC_STATUS_TFE_BITS)) {
+        batch.end_us = time_us_32();
+        batch.end_valid = true;
+        hw->intr_mask = 0;
+    }
+}
+
+int hal_i2c_batch_submit(void) {
+    if (batch.overflow) {
+        batch.result = HAL_I2C_ERR_SIZE;
+        return HAL_I2C_ERR_SIZE;
+    }
+    if (batch.count == 0) {
+        batch.result = 0;
+        return 0;
+    }
+    batch_words[batch.count - 1] |= I2C_IC_DATA_CMD_STOP_BITS;  // Nunca deixa o barramento preso.
+    i2c_hw_t *hw = i2c_get_hw(batch.bus);
+    if (batch.dma_chan < 0) {
+        batch.dma_chan = dma_claim_unused_channel(true);
+    }
+
+    // Endereço só pode ser trocado com o controlador desabilitado (como na SDK).
+    hw->enable = 0;
+    hw->tar = batch.addr;
+    hw->enable = 1;
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+    uint index = i2c_hw_index(batch.bus);
+    if (!(batch.irq_ready & (1u << index))) {
+        irq_set_exclusive_handler(I2C0_IRQ + index, batch_i2c_irq);
+        irq_set_enabled(I2C0_IRQ + index, true);
+        batch.irq_ready |= (uint8_t)(1u << index);
+    }
+    (void)hw->clr_stop_det;
+    batch.end_valid = false;
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+
+    // Escritas de 16 bits: byte + bits de controle; a parte alta é replicada em bits reservados.
+    dma_channel_config cfg = dma_channel_get_default_config(batch.dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(batch.bus, true));
+
+    uint32_t baud = i2c_baud_hz[index];
+    uint64_t nominal_us = (uint64_t)batch.count * 9u * 1000000u / (baud ? baud : 100000u);
+    batch.deadline_us = time_us_64() + 2 * nominal_us + 1000;
+    batch.sending = true;
+    batch.result = HAL_I2C_BUSY;
+    batch.start_us = time_us_32();
+    dma_channel_configure(batch.dma_chan, &cfg, &hw->data_cmd, batch_words, batch.count, true);
+    return 0;
+}
+
+static void batch_finish(int result) {
+    i2c_get_hw(batch.bus)->intr_mask = 0;
+    batch.sending = false;
+    batch.result = result;
+    // Sem a marca da IRQ (não deveria ocorrer), o instante da detecção é um limite superior.
+    uint32_t end = batch.end_valid ? batch.end_us : time_us_32();
+    batch.duration_us = result < 0 ? 0 : end - batch.start_us;
+}
+
+int hal_i2c_batch_result(void) {
+    if (!batch.sending) {
+        return batch.result;
+    }
+    i2c_hw_t *hw = i2c_get_hw(batch.bus);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // O controlador descarta a FIFO até a leitura de CLR_TX_ABRT; o DMA é cancelado antes.
+        dma_channel_abort(batch.dma_chan);
+        (void)hw->clr_tx_abrt;
+        batch_finish(HAL_I2C_ERR_NACK);
+    } else if (!dma_channel_is_busy(batch.dma_chan) && (hw->status & I2C_IC_STATUS_TFE_BITS) &&
+               !(hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS)) {
+        batch_finish((int)batch.count);
+    } else if (time_us_64() > batch.deadline_us) {
+        dma_channel_abort(batch.dma_chan);
+        hw->enable = 0;     // Descarta a FIFO de TX e libera o barramento.
+        hw->enable = 1;
+        batch_finish(HAL_I2C_ERR_TIMEOUT);
+    }
+    return batch.result;
+}
+
+uint32_t hal_i2c_batch_duration_us(void) {
+    return batch.duration_us;
+}
+
+// =================================================================================
+// ARMAZENAMENTO PERSISTENTE (FLASH)
+// =================================================================================
+
+#define STORAGE_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - HAL_STORAGE_SIZE)
+
+/**
+ * @brief Parâmetros da operação de flash executada com o outro núcleo pausado.
+ */
+typedef struct {
+    uint32_t offset;
+    bool erase_sector;
+    const uint8_t *page;
+} flash_op_t;
+
+static void flash_op(void *param) {
+    const flash_op_t *op = param;
+    if (op->erase_sector) flash_range_erase(op->offset & ~(FLASH_SECTOR_SIZE - 1), FLASH_SECTOR_SIZE);
+    flash_range_program(op->offset, op->page, FLASH_PAGE_SIZE);
+}
+
+const uint8_t *hal_storage_read(uint32_t offset) {
+    return (const uint8_t *)(uintptr_t)(XIP_BASE + STORAGE_FLASH_OFFSET + offset);
+}
+
+bool hal_storage_program_page(uint32_t offset, const uint8_t *page, bool erase_sector) {
+    flash_op_t op = {
+        .offset = STORAGE_FLASH_OFFSET + offset,
+        .erase_sector = erase_sector,
+        .page = page,
+    };
+    return flash_safe_execute(flash_op, &op, 100) == PICO_OK;
+}
+
+// =================================================================================
+// WATCHDOG
+// =================================================================================
+
+void hal_watchdog_enable(uint32_t timeout_ms) {
+    watchdog_enable(timeout_ms, true);
+}
+
+void hal_watchdog_feed(void) {
+    watchdog_update();
+}
+
+bool hal_watchdog_caused_reboot(void) {
+    return watchdog_caused_reboot();
+}
+
+uint32_t hal_watchdog_scratch_get(uint8_t index) {
+    return watchdog_hw->scratch[index];
+}
+
+void hal_watchdog_scratch_set(uint8_t index, uint32_t value) {
+    watchdog_hw->scratch[index] = value;
+}
+
+void hal_reboot(void) {
+    watchdog_enable(1, false);
+    while (true) {
+        tight_loop_contents();
+    }
+}
+
+// =================================================================================
+// GRAVAÇÃO DO FLUXO DE MEDIÇÕES
+// =================================================================================
+
+/**
+ * @brief Envia o registro como uma linha de texto, para conviver com o log no USB.
+ * @details Capturar a serial em arquivo basta: o smaiv_replay ignora as demais linhas.
+ */
+void hal_record_write(const uint8_t *frame, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    char line[4 + 2 * HAL_RECORD_FRAME_MAX + 2];
+
+    if (len > HAL_RECORD_FRAME_MAX) {
+        return;
+    }
+    char *p = line;
+    memcpy(p, "REC ", 4);
+    p += 4;
+    for (size_t i = 0; i < len; i++) {
+        *p++ = hex[frame[i] >> 4];
+        *p++ = hex[frame[i] & 0x0F];
+    }
+    *p++ = '\n';
+    *p = '\0';
+    fputs(line, stdout);
+}
@@ -0,0 +1,148 @@
+/**
+ * @file adc_service_posix.c
+ * @brief Implementação do serviço de ADC para a simulação: microfone lido de um WAV.
+ * @details Aceita PCM de 16 bits (o primeiro canal é usado) em qualquer taxa; as
+ *          amostras são reamostradas para AUDIO_SAMPLE_RATE_HZ (vizinho mais próximo)
+ *          e convertidas para a faixa de 12 bits do ADC com o nível de repouso em
+ *          2048. Cada bloco fica disponível no instante virtual em que a captura em
+ *          hardware o completaria. O joystick segue o roteiro de entradas.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "modules/adc_service/adc_service.h"
+#include "hal_posix.h"
+#include "config.h"
+
+#define BLOCK_US    ((uint64_t)AUDIO_BLOCK_SIZE * 1000000u / AUDIO_SAMPLE_RATE_HZ)
+
+static FILE *wav;
+static uint16_t wav_channels = 1;
+static uint32_t wav_rate = AUDIO_SAMPLE_RATE_HZ;
+static uint32_t wav_data_left = 0;
+static uint32_t resample_phase = 0;     ///< Fase do reamostrador (unidades de taxa do WAV).
+static int16_t current_sample = 0;
+static bool wav_ended = false;
+
+static uint64_t next_block_us;
+static adc_service_stats_t stats;
+
+static uint32_t read_le(FILE *f, int bytes) {
+    uint8_t b[4] = {0};
+    if (fread(b, 1, bytes, f) != (size_t)bytes) return 0;
+    return b[0] | (b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+/**
+ * @brief Localiza os blocos "fmt " e "data" do arquivo RIFF/WAVE.
+ */
+static bool open_wav(const char *path) {
+    char id[4];
+    wav = fopen(path, "rb");
+    if (!wav || fread(id, 1, 4, wav) != 4 || memcmp(id, "RIFF", 4) != 0) {
+        return false;
+    }
+    read_le(wav, 4);
+    if (fread(id, 1, 4, wav) != 4 || memcmp(id, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    bool have_fmt = false;
+    while (fread(id, 1, 4, wav) == 4) {
+        uint32_t size = read_le(wav, 4);
+        if (memcmp(id, "fmt ", 4) == 0) {
+            uint16_t format = (uint16_t)read_le(wav, 2);
+            wav_channels = (uint16_t)read_le(wav, 2);
+            wav_rate = read_le(wav, 4);
+            read_le(wav, 4);
+            read_le(wav, 2);
+            uint16_t bits = (uint16_t)read_le(wav, 2);
+            if (format != 1 || bits != 16 || wav_channels == 0 || wav_rate == 0) {
+                fprintf(stderr, "SIM: WAV deve ser PCM de 16 bits.\n");
+                return false;
+            }
+            fseek(wav, size - 16 + (size & 1), SEEK_CUR);
+            have_fmt = true;
+        } else if (memcmp(id, "data", 4) == 0) {
+            wav_data_left = size;
+            return have_fmt;
+        } else {
+            fseek(wav, size + (size & 1), SEEK_CUR);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Próxima amostra de entrada do WAV (primeiro canal); false no fim dos dados.
+ */
+static bool read_wav_frame(int16_t *out) {
+    uint32_t frame_bytes = 2u * wav_channels;
+    if (wav_data_left < frame_bytes) {
+        return false;
+    }
+    uint8_t buf[2 * 8];
+    size_t n = frame_bytes <= sizeof(buf) ? frame_bytes : sizeof(buf);
+    if (fread(buf, 1, n, wav) != n) {
+        return false;
+    }
+    if (frame_bytes > n) fseek(wav, frame_bytes - n, SEEK_CUR);
+    wav_data_left -= frame_bytes;
+    *out = (int16_t)(buf[0] | (buf[1] << 8));
+    return true;
+}
+
+/**
+ * @brief Gera a próxima amostra a AUDIO_SAMPLE_RATE_HZ (zero após o fim do WAV).
+ */
+static int16_t next_sample(void) {
+    if (!wav || wav_ended) {
+        return 0;
+    }
+    // Consome as amostras do WAV que já passaram neste período de amostragem.
+    while (resample_phase < wav_rate) {
+        if (!read_wav_frame(&current_sample)) {
+            wav_ended = true;
+            return 0;
+        }
+        resample_phase += AUDIO_SAMPLE_RATE_HZ;
+    }
+    resample_phase -= wav_rate;
+    return current_sample;
+}
+
+void adc_service_init(void) {
+    const char *path = hal_posix_config()->wav_path;
+    if (path && !open_wav(path)) {
+        fprintf(stderr, "SIM: WAV invalido: '%s'.\n", path);
+        exit(2);
+    }
+}
+
+void adc_service_start(void) {
+    next_block_us = hal_time_us() + BLOCK_US;
+}
+
+bool adc_service_read_mic_block(uint16_t *mic) {
+    // O bloco termina de ser capturado no instante virtual next_block_us.
+    hal_posix_core1_sleep_until(next_block_us);
+    next_block_us += BLOCK_US;
+
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        int32_t v = 2048 + (next_sample() >> 4);
+        mic[i] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+    }
+    if (wav_ended && hal_posix_config()->duration_ms == 0) {
+        // Fim do áudio: deixa o Core 0 consumir as últimas medições e encerra.
+        hal_posix_set_end(next_block_us);
+    }
+    return true;
+}
+
+uint16_t adc_service_joystick_y(void) {
+    return hal_posix_joystick_y();
+}
+
+void adc_service_get_stats(adc_service_stats_t *out) {
+    *out = stats;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file hal_net_posix.c
+ * @brief Rede simulada: Wi-Fi e broker sempre disponíveis, publicações em mqtt.log.
+ * @details Os callbacks da "pilha" rodam no Core 0 a partir do relógio virtual, como
+ *          os temporizadores da LwIP no modo background do firmware.
+ */
+#include <stdio.h>
+#include "hal/hal_net.h"
+#include "hal_posix.h"
+
+#define SIM_CONNECT_DELAY_US    50000u  ///< Latência simulada do DNS + CONNACK.
+
+static FILE *mqtt_log;
+static hal_mqtt_status_cb_t status_cb;
+static bool session_open = false;
+
+bool hal_net_init(void) {
+    return true;
+}
+
+bool hal_net_wifi_connect(const char *ssid, const char *password, uint32_t timeout_ms) {
+    (void)ssid;
+    (void)password;
+    (void)timeout_ms;
+    return true;
+}
+
+void hal_net_lock(void) {
+}
+
+void hal_net_unlock(void) {
+}
+
+void hal_net_timeout(uint32_t ms, void (*cb)(void *arg), void *arg) {
+    hal_posix_add_timer(hal_time_us() + (uint64_t)ms * 1000u, cb, arg);
+}
+
+static void connack(void *arg) {
+    (void)arg;
+    session_open = true;
+    status_cb(true, 0);
+}
+
+bool hal_mqtt_connect(const char *host, uint16_t port, const char *client_id, hal_mqtt_status_cb_t cb) {
+    (void)port;
+    (void)client_id;
+    status_cb = cb;
+    mqtt_log = hal_posix_open_output("mqtt.log", "w");
+    printf("SIM: broker '%s' simulado; publicacoes em mqtt.log.\n", host);
+    hal_posix_add_timer(hal_time_us() + SIM_CONNECT_DELAY_US, connack, NULL);
+    return true;
+}
+
+/**
+ * @brief Registra "<ms> <tópico> <qos> <tamanho> <payload>"; payloads binários em hexadecimal.
+ */
+bool hal_mqtt_publish(const char *topic, const void *payload, uint16_t len, uint8_t qos) {
+    if (!session_open || !mqtt_log) {
+        return false;
+    }
+    const uint8_t *p = payload;
+    bool text = true;
+    for (uint16_t i = 0; i < len; i++) {
+        if (p[i] < 0x20 || p[i] > 0x7E) {
+            text = false;
+            break;
+        }
+    }
+    fprintf(mqtt_log, "%lu %s %u %u ", (unsigned long)hal_time_ms(), topic, qos, len);
+    for (uint16_t i = 0; i < len; i++) {
+        if (text) fputc(p[i], mqtt_log);
+        else fprintf(mqtt_log, "%02x", p[i]);
+    }
+    fputc('\n', mqtt_log);
+    fflush(mqtt_log);
+    return true;
+}
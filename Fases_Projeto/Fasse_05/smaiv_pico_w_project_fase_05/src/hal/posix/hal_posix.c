@@ -0,0 +1,1003 @@
+/**
+ * @file hal_posix.c
+ * @brief Implementação da HAL para a simulação no Linux (tempo virtual, threads).
+ * @details Com SMAIV_FREERTOS=1 (alvo smaiv_sim_rtos, port POSIX do kernel) o relógio
+ *          passa a ser o tick do FreeRTOS, em tempo real: uma tarefa de maior
+ *          prioridade o copia a cada tick e executa o que venceu, e as esperas viram
+ *          vTaskDelay(). O restante (GPIO, display, flash, watchdog) é o mesmo.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include "hal_posix.h"
+#include "hal/hal_queue.h"
+#include "sim_ssd1306.h"
+#include "config.h"
+
+#if SMAIV_FREERTOS
+#include <stdarg.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+#define SIM_NUM_PINS        30
+#define SIM_MAX_INPUTS      1024
+#define SIM_MAX_TIMERS      8
+#define SIM_NEVER           UINT64_MAX
+#define SIM_OLED_ADDR       0x3C
+
+// =================================================================================
+// ESTADO DA SIMULAÇÃO
+// =================================================================================
+
+static hal_posix_config_t config = { .out_dir = "." };
+
+/**
+ * @brief Relógio virtual e sincronização entre as threads dos dois "núcleos".
+ * @details sim_now_us só é escrito com SIM_LOCK(); a leitura é atômica e sem trava.
+ *          No port POSIX do FreeRTOS uma tarefa preemptada fica parada com as travas
+ *          que tinha, e uma trava pthread disputada pararia a thread que o kernel
+ *          considera em execução; lá a seção crítica do kernel faz o papel de sim_lock.
+ */
+#if SMAIV_FREERTOS
+#define SIM_LOCK()      taskENTER_CRITICAL()
+#define SIM_UNLOCK()    taskEXIT_CRITICAL()
+#else
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+#define SIM_LOCK()      pthread_mutex_lock(&sim_lock)
+#define SIM_UNLOCK()    pthread_mutex_unlock(&sim_lock)
+#endif
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+static uint64_t sim_now_us = 0;
+static uint64_t sim_end_us = SIM_NEVER;
+static bool event_flag = false;
+
+static pthread_t core1_thread;
+static bool core1_launched = false;
+static bool core1_running = false;      ///< Core 1 executando (o relógio não avança).
+static uint64_t core1_wake_us = SIM_NEVER;
+static void (*core1_entry_fn)(void);
+
+#if SMAIV_FREERTOS
+static void sim_clock_task(void *arg);
+#endif
+
+/**
+ * @brief Entrada do roteiro: muda o nível de um botão ou a leitura do joystick.
+ */
+typedef struct {
+    uint64_t t_us;
+    int32_t pin;            ///< Pino do botão ou -1 para o joystick.
+    uint16_t value;         ///< Nível do pino (0 = pressionado) ou leitura do ADC.
+} sim_input_t;
+
+static sim_input_t inputs[SIM_MAX_INPUTS];
+static uint32_t num_inputs = 0;
+static uint32_t next_input = 0;
+static volatile uint16_t joystick_y = 2048;
+
+typedef struct {
+    uint64_t at_us;
+    void (*cb)(void *arg);
+    void *arg;
+} sim_timer_t;
+
+static sim_timer_t timers[SIM_MAX_TIMERS];
+static uint8_t num_timers = 0;
+
+static bool watchdog_enabled = false;
+static uint64_t watchdog_timeout_us = 0;
+static uint64_t watchdog_deadline_us = SIM_NEVER;
+static uint32_t watchdog_scratch[HAL_WATCHDOG_SCRATCH_COUNT];
+
+static bool pin_level[SIM_NUM_PINS];
+static bool pin_irq[SIM_NUM_PINS];
+static hal_gpio_edge_cb_t gpio_edge_cb;
+
+static FILE *outputs_log;
+static FILE *record_file;   ///< record.smr (aberto no primeiro registro).
+
+static inline uint64_t now_us(void) {
+    return __atomic_load_n(&sim_now_us, __ATOMIC_ACQUIRE);
+}
+
+static inline uint32_t now_ms(void) {
+    return (uint32_t)(now_us() / 1000u);
+}
+
+static void log_output(const char *fmt, unsigned a, unsigned b) {
+    if (outputs_log) {
+        fprintf(outputs_log, "%lu ", (unsigned long)now_ms());
+        fprintf(outputs_log, fmt, a, b);
+        fputc('\n', outputs_log);
+    }
+}
+
+// =================================================================================
+// CONFIGURAÇÃO E ROTEIRO DE ENTRADAS
+// =================================================================================
+
+static int compare_inputs(const void *a, const void *b) {
+    const sim_input_t *x = a, *y = b;
+    if (x->t_us != y->t_us) return x->t_us < y->t_us ? -1 : 1;
+    return x < y ? -1 : 1;
+}
+
+/**
+ * @brief Lê o roteiro: linhas "<ms> <A|SW|JOY_Y> <valor>"; '#' inicia comentário.
+ * @details Para os botões, 1 = pressionado e 0 = solto; para JOY_Y, a leitura de 12 bits.
+ */
+static void load_inputs(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "SIM: nao foi possivel abrir o roteiro '%s'.\n", path);
+        exit(2);
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f) && num_inputs < SIM_MAX_INPUTS) {
+        unsigned long t;
+        char name[16];
+        unsigned value;
+        if (line[0] == '#' || sscanf(line, "%lu %15s %u", &t, name, &value) != 3) {
+            continue;
+        }
+        sim_input_t *in = &inputs[num_inputs];
+        in->t_us = (uint64_t)t * 1000u;
+        if (strcmp(name, "A") == 0) {
+            in->pin = BUTTON_A_PIN;
+            in->value = !value;
+        } else if (strcmp(name, "SW") == 0) {
+            in->pin = JOYSTICK_SW_PIN;
+            in->value = !value;
+        } else if (strcmp(name, "JOY_Y") == 0) {
+            in->pin = -1;
+            in->value = (uint16_t)value;
+        } else {
+            fprintf(stderr, "SIM: entrada desconhecida '%s' ignorada.\n", name);
+            continue;
+        }
+        num_inputs++;
+    }
+    fclose(f);
+    qsort(inputs, num_inputs, sizeof(inputs[0]), compare_inputs);
+}
+
+void hal_posix_configure(const hal_posix_config_t *cfg) {
+    config = *cfg;
+    if (!config.out_dir) config.out_dir = ".";
+    if (config.input_path) load_inputs(config.input_path);
+    if (config.duration_ms) sim_end_us = (uint64_t)config.duration_ms * 1000u;
+    for (int i = 0; i < SIM_NUM_PINS; i++) pin_level[i] = true;  // Pull-ups.
+    outputs_log = hal_posix_open_output("outputs.log", "w");
+#if SMAIV_FREERTOS
+    xTaskCreate(sim_clock_task, "sim", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL);
+#endif
+}
+
+const hal_posix_config_t *hal_posix_config(void) {
+    return &config;
+}
+
+FILE *hal_posix_open_output(const char *name, const char *mode) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", config.out_dir, name);
+    FILE *f = fopen(path, mode);
+    if (!f) {
+        fprintf(stderr, "SIM: nao foi possivel criar '%s'.\n", path);
+    }
+    return f;
+}
+
+// =================================================================================
+// RELÓGIO VIRTUAL
+// =================================================================================
+
+static void write_display_dump(void);
+
+static bool golden_failed(void);
+
+void hal_posix_finish(int code) {
+    write_display_dump();
+    if (code == 0 && golden_failed()) code = 1;
+    if (outputs_log) fclose(outputs_log);
+    if (record_file) fclose(record_file);
+    if (config.on_finish) code = config.on_finish(code);
+    fflush(stdout);
+    fprintf(stderr, "SIM: encerrado em %lu ms de tempo virtual.\n", (unsigned long)now_ms());
+    exit(code);
+}
+
+#if !SMAIV_FREERTOS
+/**
+ * @brief Próximo acontecimento agendado (exceto o prazo pedido pelo chamador).
+ */
+static uint64_t next_event_us(void) {
+    uint64_t next = core1_wake_us;
+    if (next_input < num_inputs && inputs[next_input].t_us < next) next = inputs[next_input].t_us;
+    for (uint8_t i = 0; i < num_timers; i++) {
+        if (timers[i].at_us < next) next = timers[i].at_us;
+    }
+    if (watchdog_deadline_us < next) next = watchdog_deadline_us;
+    if (sim_end_us < next) next = sim_end_us;
+    return next;
+}
+#endif
+
+/**
+ * @brief Executa o que vence em sim_now_us. Chamada com sim_lock; os callbacks do
+ *        firmware rodam com a trava liberada (o Core 1 está parado).
+ * @return true se algo foi executado.
+ */
+static bool dispatch_due(void) {
+    uint64_t now = sim_now_us;
+
+    if (now >= sim_end_us) {
+        SIM_UNLOCK();
+        hal_posix_finish(0);
+    }
+    if (watchdog_enabled && now >= watchdog_deadline_us) {
+        SIM_UNLOCK();
+        printf("SIM: watchdog expirou (reset do sistema).\n");
+        hal_posix_finish(3);
+    }
+    if (core1_wake_us <= now) {
+        core1_wake_us = SIM_NEVER;
+        core1_running = true;
+        pthread_cond_broadcast(&sim_cond);
+        return true;
+    }
+    if (next_input < num_inputs && inputs[next_input].t_us <= now) {
+        const sim_input_t *in = &inputs[next_input++];
+        if (in->pin < 0) {
+            joystick_y = in->value;
+        } else if (pin_level[in->pin] != (bool)in->value) {
+            pin_level[in->pin] = in->value;
+            if (pin_irq[in->pin] && gpio_edge_cb) {
+                // Interrupção de GPIO: executa o callback e acorda o WFE.
+                SIM_UNLOCK();
+                gpio_edge_cb((uint32_t)in->pin);
+                SIM_LOCK();
+                event_flag = true;
+            }
+        }
+        return true;
+    }
+    for (uint8_t i = 0; i < num_timers; i++) {
+        if (timers[i].at_us <= now) {
+            sim_timer_t t = timers[i];
+            timers[i] = timers[--num_timers];
+            SIM_UNLOCK();
+            t.cb(t.arg);
+            SIM_LOCK();
+            return true;
+        }
+    }
+    return false;
+}
+
+#if SMAIV_FREERTOS
+/**
+ * @brief Tarefa do relógio: a cada tick copia o tempo do kernel para o relógio da HAL
+ *        e executa o que venceu (roteiro, temporizadores da rede, watchdog, fim).
+ * @details Tem a maior prioridade, então roda antes das tarefas do firmware no tick.
+ */
+static void sim_clock_task(void *arg) {
+    (void)arg;
+    TickType_t tick = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&tick, 1);
+        SIM_LOCK();
+        __atomic_store_n(&sim_now_us, (uint64_t)tick * 1000000u / configTICK_RATE_HZ, __ATOMIC_RELEASE);
+        while (dispatch_due()) {
+        }
+        SIM_UNLOCK();
+    }
+}
+
+/**
+ * @brief Bloqueia a tarefa atual até o instante indicado (no tick seguinte, se fracionário).
+ * @details Antes do escalonador o relógio não anda e a espera é ignorada.
+ */
+static void sleep_until(uint64_t t_us) {
+    uint64_t now = now_us();
+    if (t_us > now && xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        uint64_t tick_us = 1000000u / configTICK_RATE_HZ;
+        vTaskDelay((TickType_t)((t_us - now + tick_us - 1) / tick_us));
+    }
+}
+
+void hal_posix_core1_sleep_until(uint64_t t_us) {
+    sleep_until(t_us);
+}
+#else
+/**
+ * @brief Avança o relógio até o prazo (ou até um evento, se wake_on_event).
+ */
+static void advance_to(uint64_t deadline_us, bool wake_on_event) {
+    SIM_LOCK();
+    while (true) {
+        // O relógio nunca avança enquanto o Core 1 processa um bloco.
+        while (core1_running) {
+            pthread_cond_wait(&sim_cond, &sim_lock);
+        }
+        if (dispatch_due()) {
+            continue;
+        }
+        if ((wake_on_event && event_flag) || sim_now_us >= deadline_us) {
+            break;
+        }
+        uint64_t next = next_event_us();
+        __atomic_store_n(&sim_now_us, next < deadline_us ? next : deadline_us, __ATOMIC_RELEASE);
+    }
+    if (wake_on_event) {
+        event_flag = false;
+    }
+    SIM_UNLOCK();
+}
+
+static bool on_core1(void) {
+    return core1_launched && pthread_equal(pthread_self(), core1_thread);
+}
+
+void hal_posix_core1_sleep_until(uint64_t t_us) {
+    SIM_LOCK();
+    if (t_us > sim_now_us) {
+        core1_wake_us = t_us;
+        core1_running = false;
+        pthread_cond_broadcast(&sim_cond);
+        while (!core1_running) {
+            pthread_cond_wait(&sim_cond, &sim_lock);
+        }
+    }
+    SIM_UNLOCK();
+}
+#endif
+
+void hal_posix_signal_event(void) {
+    SIM_LOCK();
+    event_flag = true;
+    SIM_UNLOCK();
+}
+
+void hal_posix_add_timer(uint64_t at_us, void (*cb)(void *arg), void *arg) {
+    SIM_LOCK();
+    if (num_timers < SIM_MAX_TIMERS) {
+        timers[num_timers++] = (sim_timer_t){ at_us, cb, arg };
+    }
+    SIM_UNLOCK();
+}
+
+uint16_t hal_posix_joystick_y(void) {
+    return joystick_y;
+}
+
+void hal_posix_set_end(uint64_t t_us) {
+    SIM_LOCK();
+    if (t_us < sim_end_us) sim_end_us = t_us;
+    SIM_UNLOCK();
+}
+
+// =================================================================================
+// PLATAFORMA E TEMPO
+// =================================================================================
+
+void hal_stdio_init(void) {
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+bool hal_stdio_connected(void) {
+    return true;
+}
+
+int hal_console_getc(void) {
+    return -1;
+}
+
+uint64_t hal_time_us(void) {
+    return now_us();
+}
+
+uint32_t hal_time_us_32(void) {
+    return (uint32_t)now_us();
+}
+
+void hal_cycle_counter_init(void) {
+}
+
+uint32_t hal_cycle_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t hal_cycle_elapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+uint32_t hal_cycle_hz(void) {
+    return 1000000000u;
+}
+
+bool hal_xip_stats(hal_xip_stats_t *out) {
+    out->accesses = 0;
+    out->hits = 0;
+    return false;
+}
+
+void hal_xip_stats_reset(void) {
+}
+
+uint32_t hal_time_ms(void) {
+    return now_ms();
+}
+
+void hal_sleep_us(uint64_t us) {
+#if SMAIV_FREERTOS
+    sleep_until(now_us() + us);
+#else
+    if (on_core1()) {
+        hal_posix_core1_sleep_until(now_us() + us);
+    } else {
+        advance_to(now_us() + us, false);
+    }
+#endif
+}
+
+void hal_sleep_ms(uint32_t ms) {
+    hal_sleep_us((uint64_t)ms * 1000u);
+}
+
+void hal_wait_event_until(uint64_t deadline_us) {
+#if SMAIV_FREERTOS
+    sleep_until(deadline_us);
+#else
+    advance_to(deadline_us, true);
+#endif
+}
+
+static void *core1_main(void *arg) {
+    (void)arg;
+    core1_entry_fn();
+    return NULL;
+}
+
+void hal_core1_launch(void (*entry)(void)) {
+    core1_entry_fn = entry;
+    SIM_LOCK();
+    core1_running = true;
+    core1_launched = true;
+    pthread_create(&core1_thread, NULL, core1_main, NULL);
+    SIM_UNLOCK();
+}
+
+// =================================================================================
+// GPIO, PWM E WS2812 (registrados em outputs.log)
+// =================================================================================
+
+static uint16_t pwm_level[SIM_NUM_PINS];
+
+void hal_gpio_init_output(uint32_t pin) {
+    pin_level[pin] = false;
+}
+
+void hal_gpio_init_input_pullup(uint32_t pin) {
+    (void)pin;
+}
+
+void hal_gpio_put(uint32_t pin, bool value) {
+    if (pin_level[pin] != value) {
+        pin_level[pin] = value;
+        log_output("gpio %u %u", pin, value);
+    }
+}
+
+bool hal_gpio_get(uint32_t pin) {
+    return pin_level[pin];
+}
+
+void hal_gpio_enable_edge_irq(uint32_t pin, hal_gpio_edge_cb_t cb) {
+    gpio_edge_cb = cb;
+    pin_irq[pin] = true;
+}
+
+void hal_pwm_init(uint32_t pin, float clkdiv, uint16_t wrap) {
+    (void)clkdiv;
+    (void)wrap;
+    pwm_level[pin] = 0;
+}
+
+void hal_pwm_set_level(uint32_t pin, uint16_t level) {
+    if (pwm_level[pin] != level) {
+        pwm_level[pin] = level;
+        log_output("pwm %u %u", pin, level);
+    }
+}
+
+static uint32_t ws2812_num_leds = 0;
+static uint32_t ws2812_index = 0;
+static uint32_t ws2812_frame[WS2812_NUM_LEDS];
+static uint32_t ws2812_shown[WS2812_NUM_LEDS];
+
+void hal_ws2812_init(uint32_t pin, uint32_t num_leds) {
+    (void)pin;
+    ws2812_num_leds = num_leds < WS2812_NUM_LEDS ? num_leds : WS2812_NUM_LEDS;
+}
+
+void hal_ws2812_put(uint32_t grb) {
+    if (ws2812_num_leds == 0) return;
+    ws2812_frame[ws2812_index++] = grb;
+    if (ws2812_index < ws2812_num_leds) return;
+
+    // Cadeia completa: registra apenas quando algum LED mudou.
+    ws2812_index = 0;
+    if (memcmp(ws2812_frame, ws2812_shown, ws2812_num_leds * sizeof(uint32_t)) != 0) {
+        memcpy(ws2812_shown, ws2812_frame, ws2812_num_leds * sizeof(uint32_t));
+        log_output("ws2812 %06x %u", ws2812_frame[0], ws2812_num_leds);
+    }
+}
+
+// =================================================================================
+// I2C (display SSD1306 simulado)
+// =================================================================================
+
+struct hal_i2c {
+    uint8_t index;
+};
+
+static struct hal_i2c i2c_buses[2] = { { 0 }, { 1 } };
+static sim_ssd1306_t panel;
+static uint32_t frames_sent = 0;
+static uint32_t i2c_baud_hz = 400000;
+static FILE *frames_log;
+
+#define GOLDEN_MAX_REPORTED 20  ///< Quadros diferentes detalhados no relatório.
+
+/**
+ * @brief Tráfego do display. Um quadro é o conjunto de transações feitas no mesmo
+ *        instante virtual (o Core 0 não dorme dentro de ui_draw) que contém dados.
+ */
+static struct {
+    uint64_t frame_us;          ///< Instante das transações do quadro em aberto.
+    uint32_t frame_bytes;       ///< Bytes no barramento do quadro em aberto.
+    uint32_t frame_transactions;
+    uint32_t frame_bus_bits;    ///< Períodos de SCL do quadro em aberto.
+    uint32_t frame_commands;    ///< panel.command_bytes no início do quadro.
+    uint32_t frame_data;        ///< panel.data_bytes no início do quadro.
+    bool frame_has_data;
+    uint32_t transactions;
+    uint64_t bytes;             ///< Endereço + conteúdo de todas as transações.
+    uint64_t frame_bytes_total; ///< Soma dos quadros com dados.
+    uint32_t frame_bytes_max;
+    uint64_t frame_bus_bits_total;
+} i2c_traffic = { .frame_us = UINT64_MAX };
+
+/**
+ * @brief Comparação com os quadros de referência (--golden).
+ */
+static struct {
+    uint32_t compared;
+    uint32_t differ;
+    uint32_t missing;           ///< Referências ausentes ou inválidas.
+} golden;
+
+static void write_pbm(const char *name) {
+    FILE *f = hal_posix_open_output(name, "wb");
+    if (f) {
+        sim_ssd1306_write_pbm(&panel, f);
+        fclose(f);
+    }
+}
+
+static void compare_golden(const char *name) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", config.golden_dir, name);
+    FILE *f = fopen(path, "rb");
+    int diff = f ? sim_ssd1306_compare_pbm(&panel, f) : -1;
+    if (f) fclose(f);
+
+    golden.compared++;
+    if (diff < 0) {
+        golden.missing++;
+        fprintf(stderr, "SIM: golden: referencia '%s' ausente ou invalida.\n", path);
+    } else if (diff > 0) {
+        if (++golden.differ <= GOLDEN_MAX_REPORTED) {
+            fprintf(stderr, "SIM: golden: %s difere em %d pixels.\n", name, diff);
+        }
+    }
+}
+
+/**
+ * @brief Relatório da comparação; verifica também se a referência tem quadros a mais.
+ * @return true se algum quadro diferiu ou faltou.
+ */
+static bool golden_failed(void) {
+    if (!config.golden_dir) {
+        return false;
+    }
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", config.golden_dir, (unsigned long)frames_sent + 1);
+    FILE *f = fopen(path, "rb");
+    bool extra = f != NULL;
+    if (f) {
+        fclose(f);
+        fprintf(stderr, "SIM: golden: a referencia tem mais quadros que os %lu enviados.\n",
+                (unsigned long)frames_sent);
+    }
+    fprintf(stderr, "SIM: golden: %lu quadros comparados, %lu diferentes, %lu sem referencia.\n",
+            (unsigned long)golden.compared, (unsigned long)golden.differ, (unsigned long)golden.missing);
+    return golden.differ || golden.missing || extra;
+}
+
+static void close_display_frame(void) {
+    if (i2c_traffic.frame_has_data) {
+        frames_sent++;
+        i2c_traffic.frame_bytes_total += i2c_traffic.frame_bytes;
+        i2c_traffic.frame_bus_bits_total += i2c_traffic.frame_bus_bits;
+        if (i2c_traffic.frame_bytes > i2c_traffic.frame_bytes_max) {
+            i2c_traffic.frame_bytes_max = i2c_traffic.frame_bytes;
+        }
+        if (frames_log) {
+            fprintf(frames_log, "%lu %lu %lu %lu %lu %lu %lu\n", (unsigned long)frames_sent,
+                    (unsigned long)(i2c_traffic.frame_us / 1000u),
+                    (unsigned long)i2c_traffic.frame_transactions, (unsigned long)i2c_traffic.frame_bytes,
+                    (unsigned long)(panel.command_bytes - i2c_traffic.frame_commands),
+                    (unsigned long)(panel.data_bytes - i2c_traffic.frame_data),
+                    (unsigned long)((uint64_t)i2c_traffic.frame_bus_bits * 1000000u / i2c_baud_hz));
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%05lu.pbm", (unsigned long)frames_sent);
+        if (config.dump_frames) {
+            write_pbm(name);
+        }
+        if (config.golden_dir) {
+            compare_golden(name);
+        }
+    }
+    i2c_traffic.frame_bytes = 0;
+    i2c_traffic.frame_transactions = 0;
+    i2c_traffic.frame_bus_bits = 0;
+    i2c_traffic.frame_commands = panel.command_bytes;
+    i2c_traffic.frame_data = panel.data_bytes;
+    i2c_traffic.frame_has_data = false;
+}
+
+static void write_display_dump(void) {
+    close_display_frame();
+    write_pbm("display.pbm");
+    if (frames_log) {
+        fclose(frames_log);
+        frames_log = NULL;
+    }
+
+    uint32_t mean = frames_sent ? (uint32_t)(i2c_traffic.frame_bytes_total / frames_sent) : 0;
+    double mean_ms = frames_sent ? i2c_traffic.frame_bus_bits_total * 1000.0 / i2c_baud_hz / frames_sent : 0;
+    fprintf(stderr, "SIM: display: %lu quadros, %lu transacoes, %llu bytes; "
+            "media %lu bytes/quadro (max %lu), ~%.2f ms de barramento a %lu kHz.\n",
+            (unsigned long)frames_sent, (unsigned long)i2c_traffic.transactions,
+            (unsigned long long)i2c_traffic.bytes, (unsigned long)mean,
+            (unsigned long)i2c_traffic.frame_bytes_max, mean_ms, (unsigned long)(i2c_baud_hz / 1000));
+}
+
+hal_i2c_t *hal_i2c_init(uint8_t bus, uint32_t sda_pin, uint32_t scl_pin, uint32_t baud_hz) {
+    (void)sda_pin;
+    (void)scl_pin;
+    if (bus >= 2) return NULL;
+    sim_ssd1306_reset(&panel);
+    i2c_baud_hz = baud_hz;
+    if (!frames_log) {
+        frames_log = hal_posix_open_output("frames.log", "w");
+        if (frames_log) {
+            fprintf(frames_log, "# quadro t_ms transacoes bytes comandos dados barramento_us\n");
+        }
+    }
+    return &i2c_buses[bus];
+}
+
+int hal_i2c_write(hal_i2c_t *bus, uint8_t addr, const uint8_t *src, size_t len) {
+    (void)bus;
+    if (addr != SIM_OLED_ADDR || (config.i2c_max_hz && i2c_baud_hz > config.i2c_max_hz)) {
+        return HAL_I2C_ERR_NACK;
+    }
+    uint64_t now = now_us();
+    if (now != i2c_traffic.frame_us) {
+        close_display_frame();
+        i2c_traffic.frame_us = now;
+    }
+    sim_ssd1306_transaction(&panel, src, len);
+
+    // Por transação: START, endereço e conteúdo com 9 bits por byte (8 + ACK) e STOP.
+    i2c_traffic.transactions++;
+    i2c_traffic.frame_transactions++;
+    i2c_traffic.bytes += 1 + len;
+    i2c_traffic.frame_bytes += 1 + len;
+    i2c_traffic.frame_bus_bits += (uint32_t)(1 + len) * 9 + 2;
+    if (len > 0 && (src[0] & 0x40)) {
+        i2c_traffic.frame_has_data = true;
+    }
+    return (int)len;
+}
+
+/**
+ * @brief Lote "assíncrono": montado como no firmware e executado no envio, pois o
+ *        tempo virtual não avança dentro de uma chamada do Core 0.
+ */
+static struct {
+    hal_i2c_t *bus;
+    uint8_t addr;
+    bool overflow;
+    uint8_t data[HAL_I2C_BATCH_MAX];
+    size_t count;
+    size_t start;           ///< Início da transação corrente em data[].
+    uint16_t lens[HAL_I2C_BATCH_MAX];
+    size_t transactions;
+    int result;
+    uint32_t duration_us;
+} batch;
+
+bool hal_i2c_batch_begin(hal_i2c_t *bus, uint8_t addr) {
+    batch.bus = bus;
+    batch.addr = addr;
+    batch.overflow = false;
+    batch.count = 0;
+    batch.start = 0;
+    batch.transactions = 0;
+    return true;
+}
+
+bool hal_i2c_batch_add(const uint8_t *src, size_t len, bool stop) {
+    if (batch.count + len > HAL_I2C_BATCH_MAX) {
+        batch.overflow = true;
+        return false;
+    }
+    memcpy(&batch.data[batch.count], src, len);
+    batch.count += len;
+    if (stop && batch.count > batch.start) {
+        batch.lens[batch.transactions++] = (uint16_t)(batch.count - batch.start);
+        batch.start = batch.count;
+    }
+    return true;
+}
+
+int hal_i2c_batch_submit(void) {
+    if (batch.overflow) {
+        batch.result = HAL_I2C_ERR_SIZE;
+        return HAL_I2C_ERR_SIZE;
+    }
+    if (batch.count > batch.start) {
+        batch.lens[batch.transactions++] = (uint16_t)(batch.count - batch.start);
+        batch.start = batch.count;
+    }
+    const uint8_t *p = batch.data;
+    uint64_t bits = 0;
+    batch.result = (int)batch.count;
+    for (size_t t = 0; t < batch.transactions; t++) {
+        int rc = hal_i2c_write(batch.bus, batch.addr, p, batch.lens[t]);
+        if (rc < 0) {
+            batch.result = rc;
+            break;
+        }
+        p += batch.lens[t];
+        bits += (uint64_t)(1 + batch.lens[t]) * 9 + 2;
+    }
+    batch.duration_us = batch.result < 0 ? 0 : (uint32_t)(bits * 1000000u / i2c_baud_hz);
+    return 0;
+}
+
+int hal_i2c_batch_result(void) {
+    return batch.result;
+}
+
+uint32_t hal_i2c_batch_duration_us(void) {
+    return batch.duration_us;
+}
+
+// =================================================================================
+// ARMAZENAMENTO PERSISTENTE
+// =================================================================================
+
+static uint8_t storage[HAL_STORAGE_SIZE];
+static bool storage_loaded = false;
+
+static void load_storage(void) {
+    storage_loaded = true;
+    memset(storage, 0xFF, sizeof(storage));
+    if (config.flash_path) {
+        FILE *f = fopen(config.flash_path, "rb");
+        if (f) {
+            if (fread(storage, 1, sizeof(storage), f) != sizeof(storage)) {
+                memset(storage, 0xFF, sizeof(storage));
+            }
+            fclose(f);
+        }
+    }
+}
+
+const uint8_t *hal_storage_read(uint32_t offset) {
+    if (!storage_loaded) load_storage();
+    return &storage[offset];
+}
+
+bool hal_storage_program_page(uint32_t offset, const uint8_t *page, bool erase_sector) {
+    if (!storage_loaded) load_storage();
+    if (offset + HAL_STORAGE_PAGE_SIZE > HAL_STORAGE_SIZE) {
+        return false;
+    }
+    if (erase_sector) {
+        memset(&storage[offset & ~(HAL_STORAGE_SECTOR_SIZE - 1)], 0xFF, HAL_STORAGE_SECTOR_SIZE);
+    }
+    // Como na flash, a programação só leva bits de 1 para 0.
+    for (uint32_t i = 0; i < HAL_STORAGE_PAGE_SIZE; i++) {
+        storage[offset + i] &= page[i];
+    }
+    if (config.flash_path) {
+        FILE *f = fopen(config.flash_path, "wb");
+        if (f) {
+            fwrite(storage, 1, sizeof(storage), f);
+            fclose(f);
+        }
+    }
+    return true;
+}
+
+// =================================================================================
+// WATCHDOG
+// =================================================================================
+
+void hal_watchdog_enable(uint32_t timeout_ms) {
+    SIM_LOCK();
+    watchdog_enabled = true;
+    watchdog_timeout_us = (uint64_t)timeout_ms * 1000u;
+    watchdog_deadline_us = sim_now_us + watchdog_timeout_us;
+    SIM_UNLOCK();
+}
+
+void hal_watchdog_feed(void) {
+    SIM_LOCK();
+    if (watchdog_enabled) {
+        watchdog_deadline_us = sim_now_us + watchdog_timeout_us;
+    }
+    SIM_UNLOCK();
+}
+
+bool hal_watchdog_caused_reboot(void) {
+    return false;
+}
+
+uint32_t hal_watchdog_scratch_get(uint8_t index) {
+    return watchdog_scratch[index];
+}
+
+void hal_watchdog_scratch_set(uint8_t index, uint32_t value) {
+    watchdog_scratch[index] = value;
+}
+
+void hal_reboot(void) {
+    printf("SIM: reinicializacao solicitada.\n");
+    hal_posix_finish(0);
+}
+
+// =================================================================================
+// GRAVAÇÃO DO FLUXO DE MEDIÇÕES
+// =================================================================================
+
+void hal_record_write(const uint8_t *frame, size_t len) {
+    if (config.record_sink) {
+        config.record_sink(frame, len);
+        return;
+    }
+    if (!record_file) {
+        record_file = hal_posix_open_output("record.smr", "wb");
+        if (!record_file) {
+            return;
+        }
+    }
+    fputc((int)len, record_file);
+    fwrite(frame, 1, len, record_file);
+}
+
+// =================================================================================
+// FILA ENTRE NÚCLEOS
+// =================================================================================
+
+void hal_queue_init(hal_queue_t *q, uint32_t element_size, uint32_t capacity) {
+    pthread_mutex_init(&q->lock, NULL);
+    q->data = calloc(capacity, element_size);
+    q->element_size = element_size;
+    q->capacity = capacity;
+    q->head = 0;
+    q->count = 0;
+}
+
+bool hal_queue_try_add(hal_queue_t *q, const void *element) {
+    pthread_mutex_lock(&q->lock);
+    bool ok = q->count < q->capacity;
+    if (ok) {
+        uint32_t slot = (q->head + q->count) % q->capacity;
+        memcpy(q->data + slot * q->element_size, element, q->element_size);
+        q->count++;
+    }
+    pthread_mutex_unlock(&q->lock);
+    if (ok) {
+        hal_posix_signal_event();   // Como o SEV da fila da SDK.
+    }
+    return ok;
+}
+
+bool hal_queue_try_remove(hal_queue_t *q, void *element) {
+    pthread_mutex_lock(&q->lock);
+    bool ok = q->count > 0;
+    if (ok) {
+        memcpy(element, q->data + q->head * q->element_size, q->element_size);
+        q->head = (q->head + 1) % q->capacity;
+        q->count--;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+bool hal_queue_is_empty(hal_queue_t *q) {
+    pthread_mutex_lock(&q->lock);
+    bool empty = q->count == 0;
+    pthread_mutex_unlock(&q->lock);
+    return empty;
+}
+
+#if SMAIV_FREERTOS
+// =================================================================================
+// SAÍDA PADRÃO DAS TAREFAS (FreeRTOS)
+// =================================================================================
+
+/**
+ * @brief printf() e afins com o escalonador suspenso.
+ * @details Uma tarefa preemptada dentro do printf() ficaria parada com a trava do
+ *          stdout, e a próxima a imprimir bloquearia a thread em execução. O alvo
+ *          smaiv_sim_rtos liga com -Wl,--wrap para desviar as chamadas para cá.
+ */
+int __real_vprintf(const char *fmt, va_list ap);
+int __real_puts(const char *s);
+int __real_putchar(int c);
+
+static bool stdio_suspend(void) {
+    bool running = xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    if (running) {
+        vTaskSuspendAll();
+    }
+    return running;
+}
+
+static void stdio_resume(bool suspended) {
+    if (suspended) {
+        xTaskResumeAll();
+    }
+}
+
+int __wrap_vprintf(const char *fmt, va_list ap) {
+    bool suspended = stdio_suspend();
+    int n = __real_vprintf(fmt, ap);
+    stdio_resume(suspended);
+    return n;
+}
+
+int __wrap_printf(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = __wrap_vprintf(fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+int __wrap_puts(const char *s) {
+    bool suspended = stdio_suspend();
+    int n = __real_puts(s);
+    stdio_resume(suspended);
+    return n;
+}
+
+int __wrap_putchar(int c) {
+    bool suspended = stdio_suspend();
+    int n = __real_putchar(c);
+    stdio_resume(suspended);
+    return n;
+}
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file hal_posix.h
+ * @brief Controle da simulação de host (implementação POSIX da HAL).
+ * @details O tempo é virtual e só avança quando o Core 0 dorme (hal_wait_event_until,
+ *          hal_sleep_*): o relógio salta para o próximo acontecimento (temporizador
+ *          pedido, bloco de áudio do Core 1, entrada do roteiro, temporizador da rede)
+ *          e o Core 1 (uma thread) processa cada bloco com o Core 0 parado. Assim
+ *          uma execução é determinística e muito mais rápida que o tempo real.
+ *          Durações medidas com hal_time_us_32() (profiler) valem zero. No
+ *          smaiv_sim_rtos (SMAIV_FREERTOS) o relógio é o tick do kernel, em tempo real.
+ */
+#ifndef HAL_POSIX_H
+#define HAL_POSIX_H
+
+#include <stdio.h>
+#include "hal/hal.h"
+
+/**
+ * @brief Parâmetros de uma execução (preenchidos pela linha de comando do simulador).
+ */
+typedef struct {
+    const char *wav_path;       ///< Áudio do microfone (NULL = silêncio).
+    const char *input_path;     ///< Roteiro de entradas (NULL = nenhuma).
+    const char *out_dir;        ///< Diretório dos arquivos de saída.
+    const char *flash_path;     ///< Arquivo que persiste a área de flash (NULL = RAM).
+    uint32_t duration_ms;       ///< Duração máxima (0 = até o fim do WAV).
+    bool dump_frames;           ///< Grava um PBM a cada quadro enviado ao display.
+    const char *golden_dir;     ///< Quadros de referência (frame_NNNNN.pbm) a comparar (NULL = não).
+    uint32_t i2c_max_hz;        ///< Acima desta frequência o display simulado não responde (0 = sem limite).
+
+    /// Destino dos registros do recorder (NULL = record.smr no diretório de saída).
+    void (*record_sink)(const uint8_t *frame, size_t len);
+    /// Chamado ao fim da simulação; devolve o código de saída do processo.
+    int (*on_finish)(int code);
+} hal_posix_config_t;
+
+/**
+ * @brief Aplica a configuração (antes de chamar o main() do firmware).
+ */
+void hal_posix_configure(const hal_posix_config_t *cfg);
+const hal_posix_config_t *hal_posix_config(void);
+
+/**
+ * @brief Bloqueia a thread do Core 1 até o instante virtual indicado.
+ * @details Enquanto o Core 1 executa, o relógio não avança.
+ */
+void hal_posix_core1_sleep_until(uint64_t t_us);
+
+/**
+ * @brief Equivalente ao SEV/IRQ: acorda hal_wait_event_until() no Core 0.
+ */
+void hal_posix_signal_event(void);
+
+/**
+ * @brief Agenda um callback no Core 0 (contexto da "pilha de rede") no instante indicado.
+ */
+void hal_posix_add_timer(uint64_t at_us, void (*cb)(void *arg), void *arg);
+
+/**
+ * @brief Leitura atual do eixo Y do joystick (roteiro de entradas).
+ */
+uint16_t hal_posix_joystick_y(void);
+
+/**
+ * @brief Encerra a simulação no instante indicado (ex.: fim do WAV).
+ */
+void hal_posix_set_end(uint64_t t_us);
+
+/**
+ * @brief Abre um arquivo no diretório de saída.
+ */
+FILE *hal_posix_open_output(const char *name, const char *mode);
+
+/**
+ * @brief Grava as saídas finais e termina o processo.
+ */
+void hal_posix_finish(int code) __attribute__((noreturn));
+
+#endif
@@ -0,0 +1,442 @@
+/**
+ * @file replay.c
+ * @brief smaiv_replay: reproduz uma gravação do recorder no main.c, em tempo virtual.
+ * @details Substitui, na ligação, o processamento de áudio e o subsistema de entrada:
+ *          audio_get_measurement() e input_events_get() devolvem os registros da
+ *          gravação na ordem original, cada um liberado no instante em que o Core 0
+ *          do dispositivo o tratou e os lotes de medições terminando onde terminaram.
+ *          As decisões emitidas pelo main.c reproduzido são comparadas com as
+ *          gravadas pelo tipo, pelo argumento e pela posição no fluxo (quantos
+ *          registros de dados haviam sido consumidos), que não depende da fração de
+ *          milissegundo em que o dispositivo as tomou.
+ *
+ * Uso: smaiv_replay [--out dir] [--flash arquivo.bin] [--decisions] [--save log.smr]
+ *                   gravacao
+ *
+ * A gravação pode ser o record.smr do simulador ou uma captura da serial USB do
+ * firmware compilado com SMAIV_RECORDER (as linhas que não começam com "REC " são
+ * ignoradas). Código de saída: 0 sem divergências, 1 com divergências, 2 em erro.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hal_posix.h"
+#include "modules/audio_processing/audio_processing.h"
+#include "modules/input_events/input_events.h"
+#include "modules/recorder/recorder.h"
+
+#define REPLAY_MAX_PENDING      256     ///< Decisões aguardando o par para comparação.
+#define REPLAY_MAX_REPORTED     20      ///< Divergências detalhadas no relatório.
+
+int smaiv_firmware_main(void);
+
+// =================================================================================
+// LEITURA DA GRAVAÇÃO
+// =================================================================================
+
+static FILE *log_file;
+static FILE *save_file;
+static bool log_is_text;
+static bool log_eof = false;
+static uint32_t log_clock_ms;
+static uint32_t log_last_ms;
+static bool have_header = false;
+
+/**
+ * @brief Próximo registro bruto (binário: tamanho + registro; texto: linha "REC <hex>").
+ */
+static bool read_frame(uint8_t *frame, size_t *len) {
+    if (!log_is_text) {
+        int n = fgetc(log_file);
+        if (n == EOF || n == 0 || n > HAL_RECORD_FRAME_MAX ||
+            fread(frame, 1, (size_t)n, log_file) != (size_t)n) {
+            return false;
+        }
+        *len = (size_t)n;
+        return true;
+    }
+
+    char line[512];
+    while (fgets(line, sizeof(line), log_file)) {
+        if (strncmp(line, "REC ", 4) != 0) {
+            continue;
+        }
+        size_t n = 0;
+        for (const char *p = line + 4; n < HAL_RECORD_FRAME_MAX; p += 2) {
+            unsigned byte;
+            if (sscanf(p, "%2x", &byte) != 1) {
+                break;
+            }
+            frame[n++] = (uint8_t)byte;
+        }
+        if (n > 0) {
+            *len = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Decodifica o próximo registro válido; false no fim da gravação.
+ */
+static bool read_record(rec_record_t *r) {
+    uint8_t frame[HAL_RECORD_FRAME_MAX];
+    size_t len;
+
+    while (!log_eof && read_frame(frame, &len)) {
+        if (!recorder_decode(frame, len, &log_clock_ms, r)) {
+            fprintf(stderr, "REPLAY: registro invalido ignorado.\n");
+            continue;
+        }
+        if (r->type == REC_HEADER) {
+            if (have_header) {
+                // O dispositivo reiniciou durante a captura: o relógio recomeçou.
+                fprintf(stderr, "REPLAY: nova sessao na gravacao; reproduzindo apenas a primeira.\n");
+                break;
+            }
+            have_header = true;
+        }
+        if (save_file) {
+            fputc((int)len, save_file);
+            fwrite(frame, 1, len, save_file);
+        }
+        log_last_ms = r->time_ms;
+        return true;
+    }
+    log_eof = true;
+    return false;
+}
+
+// =================================================================================
+// COMPARAÇÃO DAS DECISÕES
+// =================================================================================
+
+typedef struct {
+    uint32_t seq;           ///< Registros de dados consumidos antes da decisão.
+    uint32_t time_ms;
+    uint8_t kind;
+    uint8_t arg;
+} decision_t;
+
+typedef struct {
+    decision_t items[REPLAY_MAX_PENDING];
+    uint32_t head;
+    uint32_t count;
+} decision_fifo_t;
+
+static decision_fifo_t expected;    ///< Decisões gravadas ainda não comparadas.
+static decision_fifo_t replayed;    ///< Decisões reproduzidas ainda não comparadas.
+
+static struct {
+    uint32_t measurements;
+    uint32_t inputs;
+    uint32_t recorded;
+    uint32_t replayed;
+    uint32_t matched;
+    uint32_t divergences;
+} stats;
+
+static bool print_decisions = false;
+static uint32_t log_seq = 0;        ///< Registros de dados lidos da gravação.
+static uint32_t replay_seq = 0;     ///< Registros de dados entregues ao firmware.
+
+static void report(const char *what, const decision_t *d) {
+    stats.divergences++;
+    if (stats.divergences <= REPLAY_MAX_REPORTED) {
+        printf("REPLAY: %s: registro %lu (%lu ms) %s %u\n", what, (unsigned long)d->seq,
+               (unsigned long)d->time_ms, recorder_decision_name(d->kind), d->arg);
+    }
+}
+
+static void fifo_push(decision_fifo_t *f, const decision_t *d, const char *overflow_what) {
+    if (f->count == REPLAY_MAX_PENDING) {
+        report(overflow_what, d);
+        return;
+    }
+    f->items[(f->head + f->count++) % REPLAY_MAX_PENDING] = *d;
+}
+
+static decision_t fifo_pop(decision_fifo_t *f) {
+    decision_t d = f->items[f->head];
+    f->head = (f->head + 1) % REPLAY_MAX_PENDING;
+    f->count--;
+    return d;
+}
+
+/**
+ * @brief Casa as duas filas pela posição no fluxo; a mais adiantada nunca terá par.
+ */
+static void compare_pending(void) {
+    while (expected.count > 0 && replayed.count > 0) {
+        const decision_t *e = &expected.items[expected.head];
+        const decision_t *a = &replayed.items[replayed.head];
+        if (e->seq == a->seq && e->kind == a->kind && e->arg == a->arg) {
+            stats.matched++;
+            fifo_pop(&expected);
+            fifo_pop(&replayed);
+        } else if (e->seq < a->seq) {
+            decision_t d = fifo_pop(&expected);
+            report("gravada e nao reproduzida", &d);
+        } else if (a->seq < e->seq) {
+            decision_t d = fifo_pop(&replayed);
+            report("reproduzida e nao gravada", &d);
+        } else {
+            decision_t d = fifo_pop(&expected);
+            report("gravada", &d);
+            d = fifo_pop(&replayed);
+            report("  reproduzida", &d);
+            stats.divergences--;    // Um único desacordo.
+        }
+    }
+}
+
+/**
+ * @brief Destino dos registros emitidos pelo recorder do firmware reproduzido.
+ */
+static void replay_sink(const uint8_t *frame, size_t len) {
+    static uint32_t clock_ms;
+    rec_record_t r;
+    if (!recorder_decode(frame, len, &clock_ms, &r) || r.type != REC_DECISION) {
+        return;
+    }
+    decision_t d = { replay_seq, r.time_ms, r.decision.kind, r.decision.arg };
+    stats.replayed++;
+    if (print_decisions) {
+        printf("DECISAO %lu %s %u\n", (unsigned long)d.time_ms, recorder_decision_name(d.kind), d.arg);
+    }
+    fifo_push(&replayed, &d, "reproduzida e nao comparada");
+    compare_pending();
+}
+
+// =================================================================================
+// FONTE DE REGISTROS (ORDEM ORIGINAL)
+// =================================================================================
+
+static rec_record_t head;           ///< Próximo registro de medição, lote ou entrada.
+static bool head_valid = false;
+static bool in_batch = false;       ///< Lote de medições em andamento no dispositivo.
+static bool wake_pending = false;
+
+static void wake_cb(void *arg) {
+    (void)arg;
+    wake_pending = false;
+    hal_posix_signal_event();
+}
+
+/**
+ * @brief Avança até o próximo registro de dados, recolhendo as decisões gravadas, e
+ *        agenda o despertar do Core 0 no instante dele.
+ */
+static void advance(void) {
+    rec_record_t r;
+    head_valid = false;
+    while (read_record(&r)) {
+        if (r.type == REC_DECISION) {
+            decision_t d = { log_seq, r.time_ms, r.decision.kind, r.decision.arg };
+            stats.recorded++;
+            fifo_push(&expected, &d, "gravada e nao comparada");
+            continue;
+        }
+        if (r.type == REC_HEADER) {
+            if (r.header.version != REC_VERSION || r.header.feature_count != AUDIO_FEATURE_COUNT) {
+                fprintf(stderr, "REPLAY: gravacao incompativel (versao %u, %u caracteristicas).\n",
+                        r.header.version, r.header.feature_count);
+                exit(2);
+            }
+            continue;
+        }
+        head = r;
+        head_valid = true;
+        log_seq++;
+        break;
+    }
+    compare_pending();
+
+    if (!head_valid) {
+        // Fim da gravação: encerra logo após o último registro (inclusive decisões).
+        hal_posix_set_end((uint64_t)log_last_ms * 1000u + 1000u);
+        return;
+    }
+    uint64_t at_us = (uint64_t)head.time_ms * 1000u;
+    if (at_us > hal_time_us()) {
+        if (!wake_pending) {
+            wake_pending = true;
+            hal_posix_add_timer(at_us, wake_cb, NULL);
+        }
+    } else {
+        hal_posix_signal_event();
+    }
+}
+
+/**
+ * @brief O registro de dados seguinte é do tipo pedido e já foi liberado.
+ * @details Dentro de um lote as medições seguem sem esperar o relógio: no dispositivo
+ *          o lote pode ter cruzado a fronteira de um milissegundo.
+ */
+static bool head_ready(uint8_t type) {
+    return head_valid && head.type == type && (in_batch || hal_time_ms() >= head.time_ms);
+}
+
+/**
+ * @brief Entrega o registro de dados atual ao firmware e busca o seguinte.
+ */
+static void consume(void) {
+    replay_seq++;
+    advance();
+}
+
+// --- Substitutos de modules/audio_processing ---
+
+void audio_init(void) {
+}
+
+void audio_launch_on_core1(void) {
+    advance();
+}
+
+bool audio_get_measurement(measurement_t *out) {
+    if (in_batch && head_valid && head.type == REC_BATCH_END) {
+        in_batch = false;
+        consume();
+        return false;   // O lote do dispositivo terminou aqui.
+    }
+    if (!head_ready(REC_MEASUREMENT)) {
+        return false;
+    }
+    *out = head.measurement;
+    stats.measurements++;
+    in_batch = true;
+    consume();
+    return true;
+}
+
+bool audio_measurement_pending(void) {
+    return head_ready(REC_MEASUREMENT);
+}
+
+// --- Substitutos de modules/input_events ---
+
+void input_events_init(void) {
+}
+
+bool input_events_get(input_event_t *evt) {
+    if (!head_ready(REC_INPUT)) {
+        return false;
+    }
+    *evt = head.input;
+    stats.inputs++;
+    consume();
+    return true;
+}
+
+bool input_events_pending(void) {
+    return head_ready(REC_INPUT);
+}
+
+uint32_t input_events_dropped_edges(void) {
+    return 0;
+}
+
+// =================================================================================
+// PROGRAMA
+// =================================================================================
+
+static struct timespec started;
+
+static int replay_finish(int code) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double real_s = (double)(now.tv_sec - started.tv_sec) + (now.tv_nsec - started.tv_nsec) / 1e9;
+    double virt_s = hal_time_us() / 1e6;
+
+    // O que sobrou de um lado não tem par do outro.
+    while (expected.count > 0) {
+        decision_t d = fifo_pop(&expected);
+        report("gravada e nao reproduzida", &d);
+    }
+    while (replayed.count > 0) {
+        decision_t d = fifo_pop(&replayed);
+        report("reproduzida e nao gravada", &d);
+    }
+    if (save_file) fclose(save_file);
+
+    printf("REPLAY: %lu medicoes, %lu entradas; decisoes: %lu gravadas, %lu reproduzidas, "
+           "%lu iguais, %lu divergencias.\n",
+           (unsigned long)stats.measurements, (unsigned long)stats.inputs,
+           (unsigned long)stats.recorded, (unsigned long)stats.replayed,
+           (unsigned long)stats.matched, (unsigned long)stats.divergences);
+    printf("REPLAY: %.1f s de tempo virtual em %.3f s (%.0fx).\n",
+           virt_s, real_s, real_s > 0 ? virt_s / real_s : 0.0);
+    if (code != 0) {
+        return code;
+    }
+    return stats.divergences ? 1 : 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [opcoes] gravacao\n"
+            "  --out DIR       diretorio de saida (display.pbm, outputs.log, mqtt.log)\n"
+            "  --flash ARQ     area de flash inicial (dose de ruido)\n"
+            "  --decisions     imprime cada decisao reproduzida\n"
+            "  --save ARQ      grava a sessao reproduzida em formato binario (.smr)\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    hal_posix_config_t cfg = { .out_dir = "." };
+    const char *log_path = NULL;
+    const char *save_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--decisions") == 0) {
+            print_decisions = true;
+        } else if (arg[0] != '-') {
+            log_path = arg;
+        } else if (val == NULL) {
+            usage(argv[0]);
+            return 2;
+        } else {
+            if (strcmp(arg, "--out") == 0) cfg.out_dir = val;
+            else if (strcmp(arg, "--flash") == 0) cfg.flash_path = val;
+            else if (strcmp(arg, "--save") == 0) save_path = val;
+            else {
+                usage(argv[0]);
+                return 2;
+            }
+            i++;
+        }
+    }
+    if (log_path == NULL) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    log_file = fopen(log_path, "rb");
+    if (!log_file) {
+        fprintf(stderr, "REPLAY: nao foi possivel abrir '%s'.\n", log_path);
+        return 2;
+    }
+    // Binário: o primeiro registro é o cabeçalho (tamanho, REC_HEADER, instante, magic).
+    uint8_t probe[10];
+    log_is_text = !(fread(probe, 1, sizeof(probe), log_file) == sizeof(probe) &&
+                    probe[1] == REC_HEADER && probe[6] == 'S' && probe[7] == 'M' &&
+                    probe[8] == 'R' && probe[9] == 'L');
+    rewind(log_file);
+
+    if (save_path && !(save_file = fopen(save_path, "wb"))) {
+        fprintf(stderr, "REPLAY: nao foi possivel criar '%s'.\n", save_path);
+        return 2;
+    }
+
+    cfg.record_sink = replay_sink;
+    cfg.on_finish = replay_finish;
+    clock_gettime(CLOCK_MONOTONIC, &started);
+    hal_posix_configure(&cfg);
+    return smaiv_firmware_main();
+}
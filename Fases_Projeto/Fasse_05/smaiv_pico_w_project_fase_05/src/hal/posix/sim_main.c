@@ -0,0 +1,68 @@
+/**
+ * @file sim_main.c
+ * @brief Ponto de entrada do simulador de host: lê as opções e executa o firmware.
+ * @details O main() do firmware é compilado como smaiv_firmware_main (ver
+ *          host/CMakeLists.txt), sem nenhuma outra alteração.
+ *
+ * Uso: smaiv_sim [--wav arquivo.wav] [--input roteiro.txt] [--out dir]
+ *                [--flash arquivo.bin] [--duration ms] [--frames] [--golden dir]
+ *                [--i2c-max-hz hz]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hal_posix.h"
+
+int smaiv_firmware_main(void);
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [opcoes]\n"
+            "  --wav ARQ       audio do microfone (PCM 16 bits; padrao: silencio)\n"
+            "  --input ARQ     roteiro de entradas: \"<ms> <A|SW|JOY_Y> <valor>\"\n"
+            "  --out DIR       diretorio de saida (display.pbm, frames.log, outputs.log,\n"
+            "                  mqtt.log, record.smr)\n"
+            "  --flash ARQ     persiste a area de flash entre execucoes\n"
+            "  --duration MS   tempo virtual maximo (padrao: fim do WAV ou 10 s)\n"
+            "  --frames        grava um PBM por quadro enviado ao display\n"
+            "  --golden DIR    compara cada quadro com DIR/frame_NNNNN.pbm (de um --frames\n"
+            "                  anterior); sai com codigo 1 se algum diferir\n"
+            "  --i2c-max-hz HZ o display nao responde acima desta frequencia I2C\n",
+            prog);
+}
+
+int main(int argc, char **argv) {
+    hal_posix_config_t cfg = { .out_dir = "." };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--frames") == 0) {
+            cfg.dump_frames = true;
+            continue;
+        }
+        if (val == NULL) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (strcmp(arg, "--wav") == 0) cfg.wav_path = val;
+        else if (strcmp(arg, "--input") == 0) cfg.input_path = val;
+        else if (strcmp(arg, "--out") == 0) cfg.out_dir = val;
+        else if (strcmp(arg, "--flash") == 0) cfg.flash_path = val;
+        else if (strcmp(arg, "--golden") == 0) cfg.golden_dir = val;
+        else if (strcmp(arg, "--i2c-max-hz") == 0) cfg.i2c_max_hz = (uint32_t)strtoul(val, NULL, 10);
+        else if (strcmp(arg, "--duration") == 0) cfg.duration_ms = (uint32_t)strtoul(val, NULL, 10);
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (cfg.wav_path == NULL && cfg.duration_ms == 0) {
+        cfg.duration_ms = 10000;
+    }
+
+    hal_posix_configure(&cfg);
+    return smaiv_firmware_main();
+}
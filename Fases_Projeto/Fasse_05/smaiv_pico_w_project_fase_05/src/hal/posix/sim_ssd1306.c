@@ -0,0 +1,183 @@
+/**
+ * @file sim_ssd1306.c
+ * @brief Implementação do modelo do controlador SSD1306.
+ * @details A orientação física (SEG remap, direção de varredura COM) não é aplicada:
+ *          o driver a configura para que a coluna 0 da GDDRAM fique à esquerda, que
+ *          é como o painel é exportado.
+ */
+#include <string.h>
+#include "sim_ssd1306.h"
+
+#define PBM_ROW_BYTES   (SIM_SSD1306_WIDTH / 8)
+#define PBM_HEIGHT      (SIM_SSD1306_PAGES * 8)
+
+void sim_ssd1306_reset(sim_ssd1306_t *p) {
+    memset(p, 0, sizeof(*p));
+    p->addr_mode = 2;
+    p->col_end = SIM_SSD1306_WIDTH - 1;
+    p->page_end = SIM_SSD1306_PAGES - 1;
+}
+
+/**
+ * @brief Quantidade de argumentos de cada comando (0 para comandos simples).
+ */
+static uint8_t command_args(uint8_t cmd) {
+    switch (cmd) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void execute(sim_ssd1306_t *p) {
+    const uint8_t *a = p->args;
+    switch (p->cmd) {
+    case 0x20:
+        p->addr_mode = a[0] & 0x03;
+        break;
+    case 0x21:
+        p->col_start = a[0] & 0x7F;
+        p->col_end = a[1] & 0x7F;
+        p->col = p->col_start;
+        break;
+    case 0x22:
+        p->page_start = a[0] & 0x07;
+        p->page_end = a[1] & 0x07;
+        p->page = p->page_start;
+        break;
+    case 0xA4: case 0xA5:
+        p->entire_on = p->cmd & 1;
+        break;
+    case 0xA6: case 0xA7:
+        p->inverted = p->cmd & 1;
+        break;
+    case 0xAE: case 0xAF:
+        p->display_on = p->cmd & 1;
+        break;
+    default:
+        if (p->cmd >= 0xB0 && p->cmd <= 0xB7) {
+            p->page = p->cmd & 0x07;            // Página (modo de página).
+        } else if (p->cmd <= 0x0F) {
+            p->col = (p->col & 0xF0) | p->cmd;  // Nibble baixo da coluna.
+        } else if (p->cmd <= 0x1F) {
+            p->col = (uint8_t)(((p->cmd & 0x07) << 4) | (p->col & 0x0F));
+        }
+        break;
+    }
+}
+
+static void command_byte(sim_ssd1306_t *p, uint8_t b) {
+    p->command_bytes++;
+    if (p->nargs < p->args_needed) {
+        p->args[p->nargs++] = b;
+    } else {
+        p->cmd = b;
+        p->nargs = 0;
+        p->args_needed = command_args(b);
+    }
+    if (p->nargs == p->args_needed) {
+        execute(p);
+        p->args_needed = 0;
+        p->nargs = 0;
+    }
+}
+
+static void data_byte(sim_ssd1306_t *p, uint8_t b) {
+    p->data_bytes++;
+    p->gddram[p->page & 0x07][p->col & 0x7F] = b;
+
+    switch (p->addr_mode) {
+    case 0:     // Horizontal: coluna, depois página, dentro da janela.
+        if (p->col++ >= p->col_end) {
+            p->col = p->col_start;
+            p->page = p->page >= p->page_end ? p->page_start : p->page + 1;
+        }
+        break;
+    case 1:     // Vertical: página, depois coluna.
+        if (p->page++ >= p->page_end) {
+            p->page = p->page_start;
+            p->col = p->col >= p->col_end ? p->col_start : p->col + 1;
+        }
+        break;
+    default:    // Página: apenas a coluna avança.
+        p->col = (p->col + 1) & 0x7F;
+        break;
+    }
+}
+
+void sim_ssd1306_transaction(sim_ssd1306_t *p, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = data[i++];
+        bool is_data = control & 0x40;
+        bool single = control & 0x80;  // Co = 1: um byte e novo byte de controle.
+
+        size_t end = single ? (i < len ? i + 1 : len) : len;
+        for (; i < end; i++) {
+            if (is_data) data_byte(p, data[i]);
+            else command_byte(p, data[i]);
+        }
+    }
+}
+
+bool sim_ssd1306_pixel(const sim_ssd1306_t *p, int x, int y) {
+    if (!p->display_on) {
+        return false;
+    }
+    if (p->entire_on) {
+        return true;
+    }
+    return (((p->gddram[y >> 3][x] >> (y & 7)) & 1) != 0) != p->inverted;
+}
+
+/**
+ * @brief Linha y do painel no formato do PBM P4 (bit mais significativo à esquerda).
+ */
+static void pbm_row(const sim_ssd1306_t *p, int y, uint8_t row[PBM_ROW_BYTES]) {
+    memset(row, 0, PBM_ROW_BYTES);
+    for (int x = 0; x < SIM_SSD1306_WIDTH; x++) {
+        if (sim_ssd1306_pixel(p, x, y)) {
+            row[x >> 3] |= (uint8_t)(0x80 >> (x & 7));
+        }
+    }
+}
+
+bool sim_ssd1306_write_pbm(const sim_ssd1306_t *p, FILE *f) {
+    fprintf(f, "P4\n%d %d\n", SIM_SSD1306_WIDTH, PBM_HEIGHT);
+    for (int y = 0; y < PBM_HEIGHT; y++) {
+        uint8_t row[PBM_ROW_BYTES];
+        pbm_row(p, y, row);
+        if (fwrite(row, 1, sizeof(row), f) != sizeof(row)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int sim_ssd1306_compare_pbm(const sim_ssd1306_t *p, FILE *f) {
+    int width, height;
+    if (fscanf(f, "P4 %d %d", &width, &height) != 2 || width != SIM_SSD1306_WIDTH ||
+        height != PBM_HEIGHT || fgetc(f) == EOF) {
+        return -1;
+    }
+    int diff = 0;
+    for (int y = 0; y < PBM_HEIGHT; y++) {
+        uint8_t row[PBM_ROW_BYTES], ref[PBM_ROW_BYTES];
+        if (fread(ref, 1, sizeof(ref), f) != sizeof(ref)) {
+            return -1;
+        }
+        pbm_row(p, y, row);
+        for (int i = 0; i < PBM_ROW_BYTES; i++) {
+            diff += __builtin_popcount(row[i] ^ ref[i]);
+        }
+    }
+    return diff;
+}
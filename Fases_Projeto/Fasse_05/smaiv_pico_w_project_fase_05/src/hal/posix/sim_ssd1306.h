@@ -0,0 +1,59 @@
+/**
+ * @file sim_ssd1306.h
+ * @brief Modelo do controlador SSD1306 para a simulação de host.
+ * @details Interpreta o fluxo I2C (byte de controle, comandos e dados) como o
+ *          controlador faz: decodifica os comandos de endereçamento e grava os dados
+ *          na GDDRAM, de modo que o conteúdo do painel possa ser exportado em PBM e
+ *          comparado com imagens de referência. Conta também os bytes de comando e
+ *          de dados recebidos.
+ */
+#ifndef SIM_SSD1306_H
+#define SIM_SSD1306_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SIM_SSD1306_WIDTH   128
+#define SIM_SSD1306_PAGES   8
+
+typedef struct {
+    uint8_t gddram[SIM_SSD1306_PAGES][SIM_SSD1306_WIDTH];
+    uint8_t addr_mode;          ///< 0 = horizontal, 1 = vertical, 2 = página.
+    uint8_t col_start, col_end, page_start, page_end;
+    uint8_t col, page;
+    bool display_on;
+    bool inverted;              ///< 0xA7: pixels apagados acendem e vice-versa.
+    bool entire_on;             ///< 0xA5: todos os pixels acesos, ignorando a GDDRAM.
+    uint8_t cmd;                ///< Comando aguardando argumentos.
+    uint8_t args[6];
+    uint8_t nargs, args_needed;
+    uint32_t command_bytes;     ///< Comandos e argumentos recebidos desde o reset.
+    uint32_t data_bytes;        ///< Bytes gravados na GDDRAM desde o reset.
+} sim_ssd1306_t;
+
+void sim_ssd1306_reset(sim_ssd1306_t *p);
+
+/**
+ * @brief Processa o conteúdo de uma transação I2C (após o byte de endereço).
+ */
+void sim_ssd1306_transaction(sim_ssd1306_t *p, const uint8_t *data, size_t len);
+
+/**
+ * @brief Pixel visível no painel (considera display ligado, inversão e "entire on").
+ */
+bool sim_ssd1306_pixel(const sim_ssd1306_t *p, int x, int y);
+
+/**
+ * @brief Exporta o painel como PBM binário (P4), 128 x 64 (1 = pixel aceso).
+ */
+bool sim_ssd1306_write_pbm(const sim_ssd1306_t *p, FILE *f);
+
+/**
+ * @brief Compara o painel com uma imagem PBM binária (P4) de 128 x 64.
+ * @return Pixels diferentes ou -1 se o arquivo não for um P4 desse tamanho.
+ */
+int sim_ssd1306_compare_pbm(const sim_ssd1306_t *p, FILE *f);
+
+#endif
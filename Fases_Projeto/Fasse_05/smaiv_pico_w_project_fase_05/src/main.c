@@ -20,14 +20,21 @@
  * - Controla a lógica de estado do sistema (monitoramento vs. alerta).
  * - Gerencia toda a conectividade de rede (Wi-Fi e MQTT).
  * - Controla os atuadores de alerta locais (LEDs, buzzer).
- * - Comunica-se com o Core 1 através de uma FIFO (First-In, First-Out) para receber
- *   os dados de nível sonoro.
+ * - Comunica-se com o Core 1 através de uma fila (First-In, First-Out) para receber
+ *   os registros de medição (nível sonoro e classe do evento).
+ * - Cada subsistema é uma tarefa do escalonador cooperativo (modules/scheduler),
+ *   liberada por temporizador, por evento (fila de medições, interrupções de GPIO)
+ *   ou por notificação; sem tarefas prontas o núcleo dorme e o tempo é medido.
+ * - Na variante FreeRTOS SMP (SMAIV_FREERTOS=1) as mesmas funções de tarefa rodam
+ *   como tarefas do kernel fixadas no Core 0, e o DSP é uma tarefa fixada no Core 1.
+ * - O hardware é acessado pela camada hal/ (RP2040 em hal/pico, Linux em hal/posix);
+ *   no simulador de host este main() é compilado como smaiv_firmware_main().
  * 
  * **Core 1 (Módulo audio_processing):**
  * - Atua como um co-processador de sinal dedicado.
- * - Executa um loop infinito focado exclusivamente na aquisição de áudio via ADC
- *   e no cálculo do valor RMS (Root Mean Square).
- * - Envia o resultado do cálculo de RMS para o Core 0 de forma contínua através da FIFO.
+ * - Executa um loop infinito focado exclusivamente na aquisição de áudio via ADC,
+ *   no cálculo do valor RMS (Root Mean Square) e na classificação do evento sonoro.
+ * - Envia um registro de medição por quadro para o Core 0 através de uma fila.
  * 
  * Esta abordagem de processamento paralelo garante que a tarefa computacionalmente
  * intensiva e sensível ao tempo (processamento de áudio) não interfira na
@@ -42,9 +49,8 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
-#include "pico/stdlib.h"
-#include "pico/cyw43_arch.h"
-#include "pico/multicore.h"
+#include "hal/hal.h"
+#include "hal/hal_net.h"
 
 // Arquivos de configuração e tipos compartilhados
 #include "config.h"
@@ -55,6 +61,595 @@
 #include "modules/ui_manager/ui_manager.h"
 #include "modules/local_alerts/local_alerts.h"
 #include "modules/mqtt_comm/mqtt_comm.h"
+#include "modules/sound_classifier/sound_classifier.h"
+#include "modules/feature_upload/feature_upload.h"
+#include "modules/event_segmenter/event_segmenter.h"
+#include "modules/noise_dose/noise_dose.h"
+#include "modules/adc_service/adc_service.h"
+#include "modules/input_events/input_events.h"
+#include "modules/profiler/profiler.h"
+#include "modules/fmt/fmt.h"
+#include "modules/console/console.h"
+#include "modules/supervisor/supervisor.h"
+#include "modules/recorder/recorder.h"
+
+#if SMAIV_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#else
+#include "modules/scheduler/scheduler.h"
+#endif
+
+// =================================================================================
+// ESTADO DO CORE 0
+// =================================================================================
+
+/**
+ * @brief Estrutura de estado global do sistema, compartilhada pelas tarefas do Core 0.
+ */
+static system_state_t state = {
+    .current_sound_level = 0.0f,
+    .sound_threshold = 150.0f,
+    .sound_class = SOUND_CLASS_UNKNOWN,
+    .current_screen = SCREEN_MAIN,
+    .wifi_connected = false,
+    .mqtt_connected = false,
+    .alert_active = false
+};
+
+/**
+ * @brief Alarme silenciado pelo usuário; um temporizador de disparo único o rearma.
+ */
+static bool alarm_silenced = false;
+
+/**
+ * @brief Seção crítica de `state`, `alarm_silenced` e `silenced_until_ms`.
+ * @details Na variante FreeRTOS as tarefas de UI e de alertas podem preemptar a de
+ *          aplicação (e a de rede) no meio de uma atualização. Toda escrita nesses
+ *          campos passa pela seção crítica, e os leitores de outras tarefas trabalham
+ *          sobre uma cópia tirada dentro dela (snapshot_state()). No escalonador
+ *          cooperativo uma tarefa nunca interrompe outra e as macros são vazias.
+ */
+#if SMAIV_FREERTOS
+#define STATE_LOCK()   taskENTER_CRITICAL()
+#define STATE_UNLOCK() taskEXIT_CRITICAL()
+#else
+#define STATE_LOCK()   ((void)0)
+#define STATE_UNLOCK() ((void)0)
+#endif
+
+/**
+ * @brief Buffer e contador dos vetores de características enviados no evento atual.
+ */
+static uint8_t feature_packet[FEATURE_UPLOAD_PACKET_SIZE];
+static uint32_t feature_packets_sent = 0;
+
+/**
+ * @brief Último evento encerrado pelo segmentador.
+ */
+static sound_event_t event;
+
+/**
+ * @brief Heartbeats das tarefas do Core 0 e publicação única da causa do último reset.
+ */
+static sup_client_t core0_client;
+static sup_client_t ui_client;
+static bool reset_reported = false;
+
+#if SMAIV_FREERTOS
+/**
+ * @brief Fim do período de silêncio (verificado pela tarefa de aplicação).
+ */
+static uint32_t silenced_until_ms;
+
+/**
+ * @brief Tarefas que recebem notificações de outras tarefas.
+ */
+static TaskHandle_t alerts_task_handle;
+static TaskHandle_t ui_task_handle;
+#else
+/**
+ * @brief Tarefas que recebem notificações de outras tarefas.
+ */
+static sched_task_id_t task_alarm_rearm_id;
+static sched_task_id_t task_alerts_id;
+static sched_task_id_t task_ui_id;
+#endif
+
+// =================================================================================
+// FUNÇÕES AUXILIARES
+// =================================================================================
+
+/**
+ * @brief Acorda a tarefa dos atuadores locais antes do próximo período.
+ */
+static void wake_alerts(void) {
+#if SMAIV_FREERTOS
+    xTaskNotifyGive(alerts_task_handle);
+#else
+    sched_notify(task_alerts_id);
+#endif
+}
+
+/**
+ * @brief Acorda a tarefa do display antes do próximo período.
+ */
+static void wake_ui(void) {
+#if SMAIV_FREERTOS
+    xTaskNotifyGive(ui_task_handle);
+#else
+    sched_notify(task_ui_id);
+#endif
+}
+
+/**
+ * @brief Inicia o período em que o alarme silenciado não pode disparar.
+ */
+static void start_silence_window(void) {
+#if SMAIV_FREERTOS
+    STATE_LOCK();
+    alarm_silenced = true;
+    silenced_until_ms = hal_time_ms() + ALARM_SILENCE_MS;
+    STATE_UNLOCK();
+#else
+    alarm_silenced = true;
+    sched_start_oneshot(task_alarm_rearm_id, ALARM_SILENCE_MS);
+#endif
+}
+
+/**
+ * @brief Copia o estado para uma tarefa leitora, atualizando antes o status MQTT.
+ */
+static void snapshot_state(system_state_t *copy) {
+    bool mqtt = mqtt_is_connected();
+    STATE_LOCK();
+    state.mqtt_connected = mqtt;
+    *copy = state;
+    STATE_UNLOCK();
+}
+
+/**
+ * @brief Registra no log um evento completo e o escala via MQTT conforme a classe.
+ * @param event Evento encerrado pelo segmentador.
+ */
+static void report_event(const sound_event_t *event) {
+    char peak[16], leq[16];
+    fmt_t f;
+    fmt_init(&f, peak, sizeof(peak));
+    fmt_float(&f, event->peak_level, 1);
+    fmt_init(&f, leq, sizeof(leq));
+    fmt_float(&f, event->leq_db, 1);
+    printf("Evento: inicio=%lu ms dur=%lu ms pico=%s Leq=%s dB banda=%u-%u Hz classe=%s%s\n",
+           (unsigned long)event->start_ms, (unsigned long)event->duration_ms,
+           peak, leq,
+           audio_band_edges_hz[event->dominant_band], audio_band_edges_hz[event->dominant_band + 1],
+           sound_class_name(event->sound_class), event->truncated ? " (parcial)" : "");
+
+    if (sound_classifier_should_escalate(event->sound_class)) {
+        REC_LOG_DECISION(REC_DEC_EVENT_ESCALATED, event->sound_class);
+        mqtt_publish_alert(&state, event);
+    } else {
+        REC_LOG_DECISION(REC_DEC_EVENT_IGNORED, event->sound_class);
+        printf("Evento '%s' nao escalado.\n", sound_class_name(event->sound_class));
+    }
+}
+
+/**
+ * @brief Avalia o alarme local "travado" e notifica atuadores e UI quando ele muda.
+ * @details Fora do período de silêncio, o alarme dispara imediatamente quando o nível
+ *          excede o limiar; o alerta remoto é enviado pelo segmentador ao fim do evento.
+ */
+static void evaluate_alarm(void) {
+    STATE_LOCK();
+    bool was_active = state.alert_active;
+    if (!was_active && !alarm_silenced) {
+        state.alert_active = (state.current_sound_level > state.sound_threshold);
+    }
+    bool changed = (state.alert_active != was_active);
+    STATE_UNLOCK();
+
+    if (changed) {
+        REC_LOG_DECISION(REC_DEC_ALARM_ON, 0);
+        wake_alerts();
+        wake_ui();
+    }
+}
+
+/**
+ * @brief Aplica um registro de medição do Core 1 ao estado, ao alarme, à dose e ao
+ *        segmentador.
+ * @details O limiar é avaliado em cada registro: um lote drenado de uma vez pode ter
+ *          um quadro alto no meio e terminar abaixo do limiar.
+ */
+static void handle_measurement(const measurement_t *m) {
+    REC_LOG_MEASUREMENT(m);
+    STATE_LOCK();
+    state.current_sound_level = m->event_level;
+    state.sound_class = m->sound_class;
+    STATE_UNLOCK();
+    evaluate_alarm();
+    ui_push_measurement(m);
+    noise_dose_update(m->la_db + DOSE_SPL_CALIBRATION_DB, AUDIO_FRAME_MS);
+
+    switch (event_segmenter_process(m, state.sound_threshold, &event)) {
+    case SEGMENT_STARTED:
+        feature_upload_begin();
+        feature_packets_sent = 0;
+        break;
+    case SEGMENT_ENDED:
+        report_event(&event);
+        break;
+    default:
+        break;
+    }
+
+    // Durante um evento, envia um vetor compacto de características por segundo.
+    if (event_segmenter_active() && feature_packets_sent < FEATURE_UPLOAD_MAX_PACKETS &&
+        feature_upload_add(m, feature_packet)) {
+        mqtt_publish_features(feature_packet, sizeof(feature_packet));
+        feature_packets_sent++;
+    }
+}
+
+// =================================================================================
+// TAREFAS DO CORE 0
+// =================================================================================
+
+/**
+ * @brief Consome todas as medições enviadas pelo Core 1 (liberada pela fila de medições).
+ */
+static void task_measurements(void *ctx) {
+    (void)ctx;
+    measurement_t m;
+
+    PROF_START(t0);
+    while (audio_get_measurement(&m)) {
+        handle_measurement(&m);
+    }
+    REC_LOG_BATCH_END();
+    PROF_STOP(PROF_MEASUREMENTS, t0);
+}
+
+/**
+ * @brief Consome os eventos de entrada já filtrados (bordas de GPIO e joystick).
+ * @details A lógica é dividida com base no estado de alarme "travado".
+ */
+static void task_input(void *ctx) {
+    (void)ctx;
+    input_event_t input;
+
+    supervisor_checkin(core0_client);
+    PROF_START(t0);
+    while (input_events_get(&input)) {
+        REC_LOG_INPUT(&input);
+        if (state.alert_active) {
+            // CONTEXTO: ALARME ATIVO
+            // O botão A silencia o alarme; a liberação posterior não tem efeito.
+            if (input.input == INPUT_BUTTON_A && input.type == INPUT_EVT_PRESS) {
+                printf("Alarme silenciado pelo usuário.\n");
+                REC_LOG_DECISION(REC_DEC_SILENCED, 0);
+                STATE_LOCK();
+                state.alert_active = false;
+                state.current_screen = SCREEN_MAIN;
+                STATE_UNLOCK();
+
+                // Período durante o qual o alarme não pode ser reativado.
+                start_silence_window();
+                wake_alerts();
+            }
+        } else {
+            // CONTEXTO: MONITORAMENTO NORMAL
+            STATE_LOCK();
+            ui_handle_input(&state, &input);
+            STATE_UNLOCK();
+        }
+        wake_ui();
+    }
+    PROF_STOP(PROF_INPUT, t0);
+}
+
+/**
+ * @brief Fim do período de silêncio.
+ */
+static void task_alarm_rearm(void *ctx) {
+    (void)ctx;
+    REC_LOG_DECISION(REC_DEC_REARMED, 0);
+    STATE_LOCK();
+    alarm_silenced = false;
+    STATE_UNLOCK();
+    evaluate_alarm();
+}
+
+/**
+ * @brief Atualiza os atuadores locais (o status MQTT é lido do módulo de rede).
+ */
+static void task_alerts(void *ctx) {
+    (void)ctx;
+    system_state_t snapshot;
+    snapshot_state(&snapshot);
+    PROFILE(PROF_ALERTS, alerts_update(&snapshot));
+}
+
+static void task_ui(void *ctx) {
+    (void)ctx;
+    system_state_t snapshot;
+    supervisor_checkin(ui_client);
+    snapshot_state(&snapshot);
+    PROFILE(PROF_UI_DRAW, ui_draw(&snapshot));
+}
+
+/**
+ * @brief Persistência periódica da dose de ruído e publicação do resumo.
+ */
+static void task_dose(void *ctx) {
+    (void)ctx;
+    noise_dose_status_t dose;
+    bool report;
+    PROFILE(PROF_DOSE, report = noise_dose_service(&dose));
+    if (report) {
+        mqtt_publish_dose(&dose);
+    }
+}
+
+/**
+ * @brief Registra no log a integridade do ADC, os quadros do display e a ocupação do Core 0.
+ * @details Os contadores do ADC só são impressos quando mudaram desde a última execução.
+ */
+static void task_health(void *ctx) {
+    (void)ctx;
+    static adc_service_stats_t last;
+
+    adc_service_stats_t now;
+    adc_service_get_stats(&now);
+    if (now.corrupted_samples != last.corrupted_samples || now.dropped_samples != last.dropped_samples ||
+        now.resyncs != last.resyncs) {
+        printf("ADC: %lu amostras corrompidas, %lu perdidas, %lu ressincronizacoes.\n",
+               (unsigned long)now.corrupted_samples, (unsigned long)now.dropped_samples,
+               (unsigned long)now.resyncs);
+        last = now;
+    }
+
+    ui_stats_t ui;
+    ui_get_stats(&ui);
+    uint32_t sent = ui.frames_sent ? ui.frames_sent : 1;
+    printf("UI: %lu quadros enviados (media %lu us e %lu bytes I2C, max %lu us), %lu sem alteracao, %lu adiados.\n",
+           (unsigned long)ui.frames_sent, (unsigned long)(ui.draw_us_total / sent),
+           (unsigned long)(ui.i2c_bytes / sent), (unsigned long)ui.draw_us_max,
+           (unsigned long)ui.frames_unchanged, (unsigned long)ui.frames_deferred);
+    uint32_t tx = ui.tx_frames ? ui.tx_frames : 1;
+    printf("UI: barramento a %lu kHz: media %lu us por quadro, max %lu us.\n",
+           (unsigned long)(ui.i2c_hz / 1000), (unsigned long)(ui.tx_us_total / tx),
+           (unsigned long)ui.tx_us_max);
+
+#if SMAIV_FREERTOS
+    printf("FreeRTOS: heap livre %u bytes (minimo %u).\n",
+           (unsigned)xPortGetFreeHeapSize(), (unsigned)xPortGetMinimumEverFreeHeapSize());
+#else
+    sched_stats_t sched;
+    sched_get_stats(&sched);
+    printf("Core 0: ocioso %u.%u%%, prazos perdidos: %lu\n",
+           sched.idle_permille / 10, sched.idle_permille % 10, (unsigned long)sched.deadline_misses);
+#endif
+}
+
+/**
+ * @brief Nome da última tarefa do Core 0 registrada no breadcrumb.
+ */
+static const char *last_task_name(int8_t task) {
+#if SMAIV_FREERTOS
+    (void)task;
+    return "-";
+#else
+    sched_task_stats_t stats;
+    return sched_get_task_stats(task, &stats) ? stats.name : "-";
+#endif
+}
+
+/**
+ * @brief Alimenta o watchdog (se todos os clientes estiverem em dia) e publica a causa
+ *        da reinicialização anterior assim que o broker estiver acessível.
+ */
+static void task_supervisor(void *ctx) {
+    (void)ctx;
+    supervisor_service();
+
+    if (!reset_reported && mqtt_is_connected()) {
+        const sup_reset_info_t *info = supervisor_last_reset();
+        mqtt_publish_reset(info, last_task_name(info->last_task));
+        reset_reported = true;
+    }
+}
+
+/**
+ * @brief Comando "reboot": reinicia o sistema registrando a causa.
+ */
+static void cmd_reboot(const char *args) {
+    (void)args;
+    printf("Reiniciando...\n");
+    supervisor_reboot();
+}
+
+static const console_command_t reboot_command = {
+    "reboot", "reinicia o sistema", cmd_reboot
+};
+
+/**
+ * @brief Lê e executa os comandos recebidos pelo console USB.
+ */
+static void task_console(void *ctx) {
+    (void)ctx;
+    console_poll();
+}
+
+#if PROFILING_ENABLED
+/**
+ * @brief Publica o relatório de desempenho via MQTT (uma mensagem por linha JSON).
+ */
+static void publish_profile(void) {
+    char line[PROFILER_LINE_MAX];
+
+    profiler_format_summary(line, sizeof(line));
+    mqtt_publish_profile(line);
+    for (int i = 0; i < PROF_COUNT; i++) {
+        if (profiler_format_probe((prof_probe_t)i, line, sizeof(line)) > 0) {
+            mqtt_publish_profile(line);
+        }
+    }
+}
+
+static void task_profile(void *ctx) {
+    (void)ctx;
+    publish_profile();
+}
+
+/**
+ * @brief Comando "prof": imprime, zera ("reset") ou publica ("mqtt") o relatório.
+ */
+static void cmd_profile(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        profiler_reset();
+        printf("Perfil zerado.\n");
+    } else if (strcmp(args, "mqtt") == 0) {
+        publish_profile();
+        printf("Perfil publicado em %s.\n", MQTT_TOPIC_PROFILE);
+    } else {
+        profiler_print();
+    }
+}
+
+static const console_command_t profile_command = {
+    "prof", "relatorio de desempenho [reset|mqtt]", cmd_profile
+};
+#endif
+
+/**
+ * @brief Inicializa o chip Wi-Fi CYW43 e tenta conectar à rede e ao broker.
+ * @return false se o chip Wi-Fi não pôde ser inicializado.
+ */
+static bool network_connect(void) {
+    if (!hal_net_init()) {
+        printf("FATAL: Falha ao inicializar o modulo Wi-Fi.\n");
+        return false;
+    }
+    printf("Conectando ao Wi-Fi: %s...\n", WIFI_SSID);
+
+    if (!hal_net_wifi_connect(WIFI_SSID, WIFI_PASSWORD, 30000)) {
+        printf("ERRO: Falha ao conectar ao Wi-Fi. Operando em modo offline.\n");
+        STATE_LOCK();
+        state.wifi_connected = false;
+        STATE_UNLOCK();
+    } else {
+        printf("Wi-Fi conectado com sucesso.\n");
+        STATE_LOCK();
+        state.wifi_connected = true;
+        STATE_UNLOCK();
+        mqtt_connect();
+    }
+    return true;
+}
+
+#if SMAIV_FREERTOS
+// =================================================================================
+// VARIANTE FREERTOS SMP
+// =================================================================================
+
+/**
+ * @brief Descritor de uma tarefa periódica que também pode ser acordada por notificação.
+ */
+typedef struct {
+    void (*fn)(void *ctx);
+    uint32_t period_ms;
+} rtos_periodic_t;
+
+static void rtos_periodic_task(void *arg) {
+    const rtos_periodic_t *p = (const rtos_periodic_t *)arg;
+    while (true) {
+        p->fn(NULL);
+#if PROFILING_ENABLED
+        uint32_t expected = hal_time_us_32() + p->period_ms * 1000u;
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(p->period_ms)) == 0) {
+            // Acordou pelo período: registra o atraso em relação ao instante esperado.
+            int32_t late = (int32_t)(hal_time_us_32() - expected);
+            PROF_RECORD(PROF_CORE0_LATENCY, late > 0 ? (uint32_t)late : 0);
+        }
+#else
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(p->period_ms));
+#endif
+    }
+}
+
+/**
+ * @brief Tarefa de aplicação: bloqueia na fila de medições e trata a entrada a cada
+ *        INPUT_POLL_MS, no máximo.
+ */
+static void rtos_app_task(void *arg) {
+    (void)arg;
+    measurement_t m;
+    while (true) {
+        if (audio_wait_measurement(&m, INPUT_POLL_MS)) {
+            handle_measurement(&m);
+        }
+        task_measurements(NULL);
+        task_input(NULL);
+        supervisor_note_task(-1);
+        STATE_LOCK();
+        bool rearm = alarm_silenced && (int32_t)(hal_time_ms() - silenced_until_ms) >= 0;
+        STATE_UNLOCK();
+        if (rearm) {
+            task_alarm_rearm(NULL);
+        }
+    }
+}
+
+/**
+ * @brief Tarefa de rede: conecta o Wi-Fi (o restante do sistema segue operando) e
+ *        passa a publicar as mensagens enfileiradas pelas demais tarefas.
+ */
+static void rtos_network_task(void *arg) {
+    (void)arg;
+    if (!network_connect()) {
+        vTaskDelete(NULL);
+    }
+    mqtt_publisher_loop();
+}
+
+static TaskHandle_t create_pinned(TaskFunction_t fn, const char *name, uint32_t stack_words,
+                                  void *arg, UBaseType_t priority, unsigned core) {
+    TaskHandle_t handle;
+    xTaskCreate(fn, name, stack_words, arg, priority, &handle);
+    vTaskCoreAffinitySet(handle, 1u << core);
+    return handle;
+}
+
+static void start_rtos_tasks(void) {
+    static const rtos_periodic_t alerts = { task_alerts, ALERTS_REFRESH_MS };
+    static const rtos_periodic_t ui = { task_ui, UI_REFRESH_MS };
+    static const rtos_periodic_t dose = { task_dose, DOSE_SERVICE_MS };
+    static const rtos_periodic_t health = { task_health, HEALTH_LOG_INTERVAL_MS };
+    static const rtos_periodic_t console = { task_console, CONSOLE_POLL_MS };
+    static const rtos_periodic_t supervisor = { task_supervisor, SUP_SERVICE_MS };
+#if PROFILING_ENABLED
+    static const rtos_periodic_t profile = { task_profile, PROFILER_PUBLISH_MS };
+#endif
+
+    // DSP fixado no Core 1 (a tarefa é criada pelo módulo de áudio).
+    audio_launch_on_core1();
+
+    create_pinned(rtos_app_task, "app", RTOS_STACK_WORDS, NULL, RTOS_PRIO_APP, 0);
+    create_pinned(rtos_periodic_task, "supervisor", RTOS_STACK_WORDS, (void *)&supervisor, RTOS_PRIO_APP, 0);
+    alerts_task_handle = create_pinned(rtos_periodic_task, "alertas", RTOS_STACK_WORDS,
+                                       (void *)&alerts, RTOS_PRIO_ALERTS, 0);
+    create_pinned(rtos_network_task, "rede", RTOS_STACK_WORDS, NULL, RTOS_PRIO_NET, 0);
+    ui_task_handle = create_pinned(rtos_periodic_task, "ui", RTOS_STACK_WORDS,
+                                   (void *)&ui, RTOS_PRIO_UI, 0);
+    create_pinned(rtos_periodic_task, "dose", RTOS_STACK_WORDS, (void *)&dose, RTOS_PRIO_BACKGROUND, 0);
+    create_pinned(rtos_periodic_task, "saude", RTOS_STACK_WORDS, (void *)&health, RTOS_PRIO_BACKGROUND, 0);
+    create_pinned(rtos_periodic_task, "console", RTOS_STACK_WORDS, (void *)&console, RTOS_PRIO_BACKGROUND, 0);
+#if PROFILING_ENABLED
+    create_pinned(rtos_periodic_task, "perfil", RTOS_STACK_WORDS, (void *)&profile, RTOS_PRIO_BACKGROUND, 0);
+#endif
+}
+#endif
 
 // =================================================================================
 // main() - Orquestrador do Sistema SMAIV
@@ -64,136 +659,118 @@ int main() {
     // --- 1. INICIALIZAÇÃO DO SISTEMA E HARDWARE ---
 
     /**
-     * @brief Inicializa as bibliotecas padrão da SDK, incluindo o stdio via USB.
+     * @brief Inicializa o stdio (USB CDC no firmware).
      */
-    stdio_init_all();
+    hal_stdio_init();
 
     /**
      * @brief Bloqueia a execução até que a conexão serial USB seja estabelecida.
      * @details Essencial para garantir que as primeiras mensagens de log não sejam perdidas.
      */
-    while (!stdio_usb_connected()) {
-        sleep_ms(100);
+    while (!hal_stdio_connected()) {
+        hal_sleep_ms(100);
     }
     printf("\n--- SMAIV: FASE 5 - SISTEMA MODULAR INTEGRADO ---\n");
 
     /**
-     * @brief Declara e inicializa a estrutura de estado global do sistema.
+     * @brief Recupera os breadcrumbs da execução anterior antes de qualquer outra coisa.
      */
-    system_state_t state = {
-        .current_sound_level = 0.0f,
-        .sound_threshold = 150.0f,
-        .current_screen = SCREEN_MAIN,
-        .wifi_connected = false,
-        .mqtt_connected = false,
-        .alert_active = false 
-    };
+    supervisor_init();
+    const sup_reset_info_t *last_reset = supervisor_last_reset();
+    printf("Ultimo reset: %s (cliente %d, tarefa %d, laco %lu, %lu s)\n",
+           supervisor_cause_name(last_reset->cause), last_reset->client,
+           last_reset->last_task, (unsigned long)last_reset->loop_count,
+           (unsigned long)last_reset->uptime_s);
 
     /**
      * @brief Inicializa os modulo que rodam no core 0
      */
     ui_init();
+    input_events_init();
     alerts_init();
+    noise_dose_init();
+    event_segmenter_init();
+    mqtt_comm_init();
+    core0_client = supervisor_register("core0", SUP_CORE0_TIMEOUT_MS);
+    ui_client = supervisor_register("ui", SUP_UI_TIMEOUT_MS);
+    console_register(&reboot_command);
+#if PROFILING_ENABLED
+    console_register(&profile_command);
+#endif
+#if RECORDER_ENABLED
+    recorder_init();
+#endif
 
     /**
-     * @brief Inicializa o hardware de áudio e LANÇA o processamento no Core 1
+     * @brief Inicializa o hardware de áudio (o processamento é lançado a seguir).
      */
     audio_init();
+
+#if SMAIV_FREERTOS
+    // --- 2. TAREFAS FREERTOS (a conexão de rede ocorre na tarefa "rede") ---
+    printf("Iniciando tarefas FreeRTOS SMP...\n");
+    start_rtos_tasks();
+    supervisor_start();
+    vTaskStartScheduler();
+#else
     printf("Core 0: Lançando processamento de áudio no Core 1...\n");
     audio_launch_on_core1();
 
-
     // --- 2. INICIALIZAÇÃO DA CONECTIVIDADE ---
-
-    /**
-     * @brief Inicializa o chip Wi-Fi CYW43, habilitando o modo Station (STA).
-     */
-    if (cyw43_arch_init()) {
-        printf("FATAL: Falha ao inicializar o modulo Wi-Fi.\n");
+    if (!network_connect()) {
         return -1;
     }
-    cyw43_arch_enable_sta_mode();
-    printf("Conectando ao Wi-Fi: %s...\n", WIFI_SSID);
+
+    // --- 3. REGISTRO DAS TAREFAS DO CORE 0 ---
 
     /**
-     * @brief Tenta estabelecer a conexão com a rede Wi-Fi configurada.
+     * @brief Tarefas em ordem de prioridade; cada uma executa apenas quando liberada.
      */
-    if (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, 30000)) {
-        printf("ERRO: Falha ao conectar ao Wi-Fi. Operando em modo offline.\n");
-        state.wifi_connected = false;
-    } else {
-        printf("Wi-Fi conectado com sucesso.\n");
-        state.wifi_connected = true;
-        mqtt_connect(&state);
-    }
-    
-    printf("Sistema ativo. Entrando no loop principal do Core 0.\n");
+    sched_init();
 
-    // --- 3. LOOP OPERACIONAL INFINITO (CORE 0) ---
+    // Primeira tarefa: alimenta o watchdog antes das demais quando liberada.
+    sched_task_id_t task_sup_id = sched_add_task("supervisor", task_supervisor, NULL, 20);
+    sched_set_period(task_sup_id, SUP_SERVICE_MS);
 
-    /**
-     * @brief Variável para detecção de borda de subida do estado de alerta.
-     */
-    bool last_alert_state = false;
+    sched_task_id_t task_meas_id = sched_add_task("medicoes", task_measurements, NULL, 50);
+    sched_set_event_source(task_meas_id, audio_measurement_pending);
 
-     /**
-     * @brief // Timestamp para controlar o período após um alarme ser desativado.
-     */
-    absolute_time_t silenced_until = get_absolute_time();
+    sched_task_id_t task_input_id = sched_add_task("entrada", task_input, NULL, 20);
+    sched_set_event_source(task_input_id, input_events_pending);
+    sched_set_period(task_input_id, INPUT_POLL_MS);
 
-    while (true) {
+    task_alarm_rearm_id = sched_add_task("rearme", task_alarm_rearm, NULL, 50);
 
-        /**
-         * @brief Verifica se há um novo valor de RMS enviado pelo Core 1
-         */
-        if (multicore_fifo_rvalid()) {
-            // Lê o valor da FIFO
-            uint32_t raw_value = multicore_fifo_pop_blocking();
-            // Reconverte o valor para float
-            state.current_sound_level = *(float*)&raw_value;
-        }
+    task_alerts_id = sched_add_task("alertas", task_alerts, NULL, 50);
+    sched_set_period(task_alerts_id, ALERTS_REFRESH_MS);
 
-        /**
-         * @brief Lógica principal dividida com base no estado de alarme "travado".
-         */
-         if (state.alert_active) {
-            // CONTEXTO: ALARME ATIVO
-            // Verifica se o botão A foi pressionado para silenciar o alarme.
-            if (!gpio_get(BUTTON_A_PIN)) {
-                printf("Alarme silenciado pelo usuário.\n");
-                state.alert_active = false;
-                state.current_screen = SCREEN_MAIN;
+    task_ui_id = sched_add_task("ui", task_ui, NULL, 100);
+    sched_set_period(task_ui_id, UI_REFRESH_MS);
 
-                // Período durante o qual o alarme não pode ser reativado.
-                silenced_until = make_timeout_time_ms(5000); // 5 segundos
-                
-                // Debounce e espera para garantir que o usuário solte o botão
-                sleep_ms(500); 
-            }
-        } else {
-            // CONTEXTO: MONITORAMENTO NORMAL
-            ui_update_input(&state);
-            
-            // --- LÓGICA DE REATIVAÇÃO CONTROLADA ---
-            // Verifica se o período de silêncio já passou.
-            if (time_reached(silenced_until)) {
-                last_alert_state = state.alert_active;
-                state.alert_active = (state.current_sound_level > state.sound_threshold);
-
-                // Publica o alerta apenas na transição de "normal" para "alerta".
-                if (state.alert_active && !last_alert_state) {
-                    mqtt_publish_alert(&state);
-                }
-            }
-        }
-        
-        // --- 4. ATUALIZAÇÃO DOS ATUADORES ---
-        
-        alerts_update(&state);
-        ui_draw(&state);
+    sched_task_id_t task_dose_id = sched_add_task("dose", task_dose, NULL, 1000);
+    sched_set_period(task_dose_id, DOSE_SERVICE_MS);
 
-        sleep_ms(20);
-    }
+    sched_task_id_t task_health_id = sched_add_task("saude", task_health, NULL, 1000);
+    sched_set_period(task_health_id, HEALTH_LOG_INTERVAL_MS);
+
+    sched_task_id_t task_console_id = sched_add_task("console", task_console, NULL, 100);
+    sched_set_period(task_console_id, CONSOLE_POLL_MS);
+
+#if PROFILING_ENABLED
+    sched_task_id_t task_profile_id = sched_add_task("perfil", task_profile, NULL, 1000);
+    sched_set_period(task_profile_id, PROFILER_PUBLISH_MS);
+#endif
+
+    wake_alerts();
+    wake_ui();
+
+    // O Wi-Fi já foi conectado (bloqueante): a partir daqui o watchdog está ativo.
+    supervisor_start();
+    printf("Sistema ativo. Entrando no escalonador do Core 0.\n");
+
+    // --- 4. LAÇO OPERACIONAL INFINITO (CORE 0) ---
+    sched_run();
+#endif
 
     return 0;
-}
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+ * @file adc_service.c
+ * @brief Implementação do serviço de arbitragem do ADC (round-robin + FIFO + DMA em anel).
+ */
+#include "adc_service.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+
+#if SMAIV_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+#define ADC_CHANNELS    2                                   ///< Joystick + microfone.
+#define CAPTURE_LEN     (AUDIO_BLOCK_SIZE * ADC_CHANNELS)   ///< Amostras intercaladas por bloco.
+#define CAPTURE_RATE_HZ (AUDIO_SAMPLE_RATE_HZ * ADC_CHANNELS) ///< Conversões por segundo.
+#define CAPTURE_RING_BITS 11                                ///< log2 do tamanho em bytes de capture_buf.
+#define ADC_CLOCK_HZ    48000000.0f
+
+/**
+ * @brief Transferências programadas no canal de DMA: múltiplo do anel, para que o
+ *        contador decrescente dê sempre a posição no anel (~74 h a 16 kHz).
+ */
+#define CAPTURE_TRANSFERS   (0xFFFFFFFFu / (2u * CAPTURE_LEN) * (2u * CAPTURE_LEN))
+
+/**
+ * @brief Margem antes do fim das transferências em que a captura é reiniciada.
+ */
+#define CAPTURE_RESTART_AT  (CAPTURE_TRANSFERS - 4u * CAPTURE_LEN)
+
+/**
+ * @brief Anel de dois blocos: índices pares = joystick, ímpares = microfone.
+ * @details O DMA escreve com wrap de endereço (CAPTURE_RING_BITS), então volta ao
+ *          início sozinho e não depende de nenhuma IRQ para continuar no lugar certo,
+ *          nem quando as interrupções ficam desligadas durante uma escrita na flash.
+ */
+static uint16_t capture_buf[2][CAPTURE_LEN] __attribute__((aligned(1u << CAPTURE_RING_BITS)));
+_Static_assert(sizeof(capture_buf) == (1u << CAPTURE_RING_BITS), "anel do DMA deve cobrir capture_buf");
+
+static int dma_chan;
+
+static uint32_t blocks_consumed = 0;            ///< Blocos já entregues ao DSP.
+static volatile uint16_t joystick_y = 2048;     ///< Média do joystick no último bloco.
+static uint16_t last_mic_sample = 2048;         ///< Substitui conversões com erro.
+static volatile adc_service_stats_t stats;
+
+/**
+ * @brief Conversões já gravadas no anel desde o início da captura.
+ * @details O contador de transferências do canal é o contador livre da captura: o
+ *          bloco n ocupa capture_buf[n & 1] e está completo quando isto passa de
+ *          (n + 1) * CAPTURE_LEN.
+ */
+static inline uint32_t samples_captured(void) {
+    return CAPTURE_TRANSFERS - dma_channel_hw_addr(dma_chan)->transfer_count;
+}
+
+/**
+ * @brief (Re)inicia a captura alinhada: a primeira conversão é sempre o joystick.
+ */
+static void restart_capture(void) {
+    adc_run(false);
+    dma_channel_abort(dma_chan);
+    adc_fifo_drain();
+    hw_set_bits(&adc_hw->fcs, ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS);
+
+    blocks_consumed = 0;
+
+    adc_select_input(JOYSTICK_Y_ADC_INPUT);
+    dma_channel_set_trans_count(dma_chan, CAPTURE_TRANSFERS, false);
+    dma_channel_set_write_addr(dma_chan, capture_buf, true);
+    adc_run(true);
+}
+
+void adc_service_init(void) {
+    adc_init();
+    adc_gpio_init(MIC_ADC_PIN);
+    adc_gpio_init(JOYSTICK_Y_PIN);
+
+    // FIFO com DREQ para o DMA e bit de erro (bit 15) em cada amostra.
+    adc_fifo_setup(true, true, 1, true, false);
+    adc_set_clkdiv(ADC_CLOCK_HZ / CAPTURE_RATE_HZ - 1.0f);
+    adc_set_round_robin((1u << JOYSTICK_Y_ADC_INPUT) | (1u << MIC_ADC_INPUT));
+
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, CAPTURE_RING_BITS);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(dma_chan, &cfg, capture_buf, &adc_hw->fifo, CAPTURE_TRANSFERS, false);
+}
+
+void adc_service_start(void) {
+    restart_capture();
+}
+
+bool HAL_RAM_FUNC(adc_service_read_mic_block)(uint16_t *mic) {
+    bool continuous = true;
+
+    uint32_t completed;
+    while ((completed = samples_captured() / CAPTURE_LEN) == blocks_consumed) {
+#if SMAIV_FREERTOS
+        // Dorme até o fim previsto do bloco em andamento.
+        uint32_t left = CAPTURE_LEN - samples_captured() % CAPTURE_LEN;
+        vTaskDelay(pdMS_TO_TICKS(left * 1000u / CAPTURE_RATE_HZ) + 1);
+#else
+        tight_loop_contents();
+#endif
+    }
+
+    // Se mais de um bloco foi concluído, o mais antigo já foi sobrescrito.
+    if (completed - blocks_consumed > 1) {
+        stats.dropped_samples += (completed - blocks_consumed - 1) * AUDIO_BLOCK_SIZE;
+        blocks_consumed = completed - 1;
+        continuous = false;
+    }
+
+    const uint16_t *buf = capture_buf[blocks_consumed & 1];
+    uint32_t joy_sum = 0;
+    uint16_t joy_last = joystick_y;
+
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        uint16_t j = buf[2 * i];
+        uint16_t s = buf[2 * i + 1];
+
+        if (j & ADC_FIFO_ERR_BITS) {
+            stats.corrupted_samples++;
+        } else {
+            joy_last = j;
+        }
+        if (s & ADC_FIFO_ERR_BITS) {
+            stats.corrupted_samples++;
+        } else {
+            last_mic_sample = s;
+        }
+        joy_sum += joy_last;
+        mic[i] = last_mic_sample;
+    }
+
+    // O DMA voltou a este buffer enquanto ele era lido: bloco inconsistente.
+    if (samples_captured() > (blocks_consumed + 2) * CAPTURE_LEN) {
+        stats.dropped_samples += AUDIO_BLOCK_SIZE;
+        continuous = false;
+    }
+    blocks_consumed++;
+    joystick_y = (uint16_t)(joy_sum / AUDIO_BLOCK_SIZE);
+
+    // Estouro da FIFO desalinha o round-robin: reinicia a captura a partir do joystick.
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        stats.resyncs++;
+        restart_capture();
+        continuous = false;
+    } else if (samples_captured() >= CAPTURE_RESTART_AT) {
+        // Fim das transferências programadas (a cada ~3 dias): recomeça o anel.
+        restart_capture();
+        continuous = false;
+    }
+    return continuous;
+}
+
+uint16_t adc_service_joystick_y(void) {
+    return joystick_y;
+}
+
+void adc_service_get_stats(adc_service_stats_t *out) {
+    out->corrupted_samples = stats.corrupted_samples;
+    out->dropped_samples = stats.dropped_samples;
+    out->resyncs = stats.resyncs;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file adc_service.h
+ * @brief Dono único do ADC: amostragem round-robin do microfone e do joystick.
+ * @details O ADC opera em modo contínuo alternando (round-robin) entre o canal do
+ *          joystick e o do microfone, na taxa 2 * AUDIO_SAMPLE_RATE_HZ. A FIFO do ADC
+ *          é drenada por um canal de DMA que escreve em anel sobre dois blocos, sem
+ *          IRQ: o contador de transferências do canal diz quantos blocos ficaram
+ *          prontos, mesmo depois de as interrupções ficarem desligadas (escrita na
+ *          flash). O Core 1 separa as amostras: o bloco do microfone vai para o DSP
+ *          e a média do joystick fica disponível para o Core 0. Nenhum outro código
+ *          deve chamar adc_select_input()/adc_read().
+ *
+ *          Esta interface é também a fronteira de HAL da aquisição: adc_service.c é a
+ *          implementação do RP2040 e hal/posix/adc_service_posix.c a da simulação no
+ *          host, que lê o microfone de um arquivo WAV.
+ */
+#ifndef ADC_SERVICE_H
+#define ADC_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Contadores de integridade da aquisição.
+ */
+typedef struct {
+    uint32_t corrupted_samples; ///< Conversões com bit de erro do ADC.
+    uint32_t dropped_samples;   ///< Amostras do microfone sobrescritas antes de lidas.
+    uint32_t resyncs;           ///< Reinícios da captura após estouro da FIFO do ADC.
+} adc_service_stats_t;
+
+/**
+ * @brief Configura ADC, pinos, FIFO e canais de DMA (Core 0, antes de lançar o Core 1).
+ */
+void adc_service_init(void);
+
+/**
+ * @brief Inicia a captura (no Core 1).
+ */
+void adc_service_start(void);
+
+/**
+ * @brief Aguarda e devolve o próximo bloco de AUDIO_BLOCK_SIZE amostras do microfone.
+ * @details Também atualiza a leitura do joystick com a média do bloco (Core 1).
+ * @param mic Buffer de saída (valores de 12 bits).
+ * @return false se houve descontinuidade antes ou durante este bloco.
+ */
+bool adc_service_read_mic_block(uint16_t *mic);
+
+/**
+ * @brief Última leitura (média de um bloco) do eixo Y do joystick, para o Core 0.
+ */
+uint16_t adc_service_joystick_y(void);
+
+/**
+ * @brief Copia os contadores de integridade da aquisição.
+ */
+void adc_service_get_stats(adc_service_stats_t *stats);
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ * @file audio_features.c
+ * @brief Implementação da extração de características por quadro (Core 1).
+ */
+#include "audio_features.h"
+#include "audio_fft.h"
+#include "hal/hal.h"
+#include <math.h>
+
+const uint16_t HAL_RAM_DATA(audio_band_edges_hz)[AUDIO_NUM_BANDS + 1] = {
+    31, 62, 125, 250, 500, 1000, 2000, 3000, AUDIO_SAMPLE_RATE_HZ / 2
+};
+
+const float HAL_RAM_DATA(audio_feature_scale)[AUDIO_FEATURE_COUNT] = {
+    [AUDIO_FEATURE_LEVEL_DB] = 0.5f,          // 0..127,5 dB
+    [AUDIO_FEATURE_ZCR]      = 1.0f / 255.0f, // 0..1
+    [AUDIO_FEATURE_CREST_DB] = 0.25f,         // 0..63,75 dB
+    [AUDIO_FEATURE_CENTROID] = 16.0f,         // 0..4080 Hz
+    [AUDIO_FEATURE_FLUX]     = 0.5f,          // 0..127,5 dB
+    [AUDIO_FEATURE_BAND_0 ... AUDIO_FEATURE_COUNT - 1] = 0.5f, // 0..127,5 dB
+};
+
+static uint32_t power[AUDIO_FFT_BINS];
+static float prev_band_db[AUDIO_NUM_BANDS];
+static float a_weight[AUDIO_FFT_BINS];   ///< Ponderação A (potência linear) por bin.
+
+void audio_features_init(void) {
+    // Curva A da IEC 61672: R_A(f) normalizada para 0 dB em 1 kHz (+2,0 dB).
+    const float c1 = 20.6f * 20.6f, c2 = 107.7f * 107.7f, c3 = 737.9f * 737.9f, c4 = 12194.0f * 12194.0f;
+    for (uint32_t k = 0; k < AUDIO_FFT_BINS; k++) {
+        float f2 = (k * AUDIO_FFT_BIN_HZ) * (k * AUDIO_FFT_BIN_HZ);
+        float ra = c4 * f2 * f2 / ((f2 + c1) * sqrtf((f2 + c2) * (f2 + c3)) * (f2 + c4));
+        a_weight[k] = ra * ra * 1.5849f; // 10^(2,0 / 10)
+    }
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) prev_band_db[b] = -60.0f;
+}
+
+static inline float power_to_db(float p) {
+    return (p > 1e-6f) ? 10.0f * log10f(p) : -60.0f;
+}
+
+static void HAL_RAM_FUNC(compute_spectral)(audio_frame_features_t *out) {
+    float total = 0.0f;
+    float weighted = 0.0f;
+    float a_total = 0.0f;
+    float flux = 0.0f;
+    uint32_t k = (uint32_t)(audio_band_edges_hz[0] / AUDIO_FFT_BIN_HZ + 0.5f);
+
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+        uint32_t k_end = (uint32_t)(audio_band_edges_hz[b + 1] / AUDIO_FFT_BIN_HZ + 0.5f);
+        if (b == AUDIO_NUM_BANDS - 1) k_end = AUDIO_FFT_BINS;
+
+        uint64_t band_sum = 0;
+        for (; k < k_end; k++) {
+            band_sum += power[k];
+            weighted += (float)power[k] * (k * AUDIO_FFT_BIN_HZ);
+            a_total += (float)power[k] * a_weight[k];
+        }
+        float band_power = (float)band_sum * AUDIO_FFT_POWER_TO_LSB2;
+        total += (float)band_sum;
+
+        float db = power_to_db(band_power);
+        if (db > prev_band_db[b]) flux += db - prev_band_db[b];
+        prev_band_db[b] = db;
+        out->band_db[b] = db;
+    }
+
+    out->centroid_hz = (total > 0.0f) ? weighted / total : 0.0f;
+    out->flux_db = flux;
+    out->la_db = power_to_db(a_total * AUDIO_FFT_POWER_TO_LSB2);
+}
+
+void HAL_RAM_FUNC(audio_features_center)(const uint16_t *raw, int16_t *samples) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        sum += raw[i];
+    }
+
+    uint16_t dc_offset = sum / AUDIO_BLOCK_SIZE;
+
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        samples[i] = (int16_t)(raw[i] - dc_offset);
+    }
+}
+
+void HAL_RAM_FUNC(audio_features_time_domain)(const int16_t *samples, audio_frame_features_t *out) {
+    uint64_t sum_of_squares = 0;
+    uint32_t peak = 0;
+    uint32_t crossings = 0;
+
+    for (uint32_t i = 0; i < AUDIO_BLOCK_SIZE; i++) {
+        int32_t s = samples[i];
+        sum_of_squares += (uint32_t)(s * s);
+        uint32_t mag = (uint32_t)(s < 0 ? -s : s);
+        if (mag > peak) peak = mag;
+        if (i > 0 && ((samples[i - 1] < 0) != (s < 0))) crossings++;
+    }
+
+    out->rms = sqrtf((float)sum_of_squares / AUDIO_BLOCK_SIZE);
+    out->zcr = (float)crossings / (AUDIO_BLOCK_SIZE - 1);
+
+    if (out->rms > 0.0f) {
+        out->level_db = 20.0f * log10f(out->rms);
+        out->crest_db = 20.0f * log10f((float)peak / out->rms);
+    } else {
+        out->level_db = 0.0f;
+        out->crest_db = 0.0f;
+    }
+}
+
+void HAL_RAM_FUNC(audio_features_compute)(const int16_t *samples, audio_frame_features_t *out) {
+    audio_features_time_domain(samples, out);
+    audio_fft_power(samples, power);
+    compute_spectral(out);
+}
+
+const uint32_t *audio_features_spectrum(void) {
+    return power;
+}
+
+void HAL_RAM_FUNC(audio_features_quantize)(const audio_frame_features_t *f, int8_t *q) {
+    float values[AUDIO_FEATURE_COUNT] = {
+        [AUDIO_FEATURE_LEVEL_DB] = f->level_db,
+        [AUDIO_FEATURE_ZCR]      = f->zcr,
+        [AUDIO_FEATURE_CREST_DB] = f->crest_db,
+        [AUDIO_FEATURE_CENTROID] = f->centroid_hz,
+        [AUDIO_FEATURE_FLUX]     = f->flux_db,
+    };
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+        values[AUDIO_FEATURE_BAND_0 + b] = f->band_db[b];
+    }
+
+    for (int i = 0; i < AUDIO_FEATURE_COUNT; i++) {
+        int32_t v = (int32_t)lroundf(values[i] / audio_feature_scale[i]) - 128;
+        if (v < -128) v = -128;
+        if (v > 127) v = 127;
+        q[i] = (int8_t)v;
+    }
+}
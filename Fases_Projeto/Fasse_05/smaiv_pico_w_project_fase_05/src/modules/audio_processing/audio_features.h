@@ -0,0 +1,93 @@
+/**
+ * @file audio_features.h
+ * @brief Extração de características por quadro de áudio (classificador e upload).
+ */
+#ifndef AUDIO_FEATURES_H
+#define AUDIO_FEATURES_H
+
+#include <stdint.h>
+
+#define AUDIO_NUM_BANDS 8   ///< Bandas de ~oitava entre 31 Hz e 4 kHz.
+
+/**
+ * @brief Índices das características no vetor quantizado.
+ */
+typedef enum {
+    AUDIO_FEATURE_LEVEL_DB = 0, ///< Nível RMS em dB (re 1 LSB do ADC).
+    AUDIO_FEATURE_ZCR,          ///< Taxa de cruzamentos por zero (0..1).
+    AUDIO_FEATURE_CREST_DB,     ///< Fator de crista (pico/RMS) em dB.
+    AUDIO_FEATURE_CENTROID,     ///< Centroide espectral em Hz.
+    AUDIO_FEATURE_FLUX,         ///< Fluxo espectral (soma dos aumentos de banda, dB).
+    AUDIO_FEATURE_BAND_0,       ///< Primeira banda (dB); seguem AUDIO_NUM_BANDS posições.
+    AUDIO_FEATURE_COUNT = AUDIO_FEATURE_BAND_0 + AUDIO_NUM_BANDS
+} audio_feature_t;
+
+/**
+ * @brief Características de um quadro em unidades físicas.
+ */
+typedef struct {
+    float rms;                       ///< Valor RMS (LSB do ADC).
+    float level_db;                  ///< 20*log10(rms).
+    float zcr;                       ///< Fração de amostras consecutivas com troca de sinal.
+    float crest_db;                  ///< 20*log10(pico/rms).
+    float centroid_hz;               ///< Centroide espectral.
+    float flux_db;                   ///< Soma dos aumentos de nível por banda desde o quadro anterior.
+    float la_db;                     ///< Nível com ponderação A em dB (re 1 LSB).
+    float band_db[AUDIO_NUM_BANDS];  ///< Nível de cada banda em dB (re 1 LSB^2).
+} audio_frame_features_t;
+
+/**
+ * @brief Frequências de corte (Hz) das bandas: banda i cobre [edges[i], edges[i+1]).
+ */
+extern const uint16_t audio_band_edges_hz[AUDIO_NUM_BANDS + 1];
+
+/**
+ * @brief Passo de quantização (unidade física por LSB) de cada característica.
+ * @details q = round(valor / escala) - 128. Faz parte do contrato com o modelo do
+ *          classificador e com o decodificador `tools/decode_features.py`.
+ */
+extern const float audio_feature_scale[AUDIO_FEATURE_COUNT];
+
+/**
+ * @brief Pré-calcula a ponderação A por bin e o estado inicial do fluxo espectral.
+ * @details Deve ser chamada uma vez (Core 0) antes de lançar o Core 1.
+ */
+void audio_features_init(void);
+
+/**
+ * @brief Remove a componente DC de um bloco do ADC (média do próprio bloco).
+ * @param raw AUDIO_BLOCK_SIZE leituras de 12 bits.
+ * @param samples Saída com as amostras centradas.
+ */
+void audio_features_center(const uint16_t *raw, int16_t *samples);
+
+/**
+ * @brief Características no domínio do tempo: RMS, nível, ZCR e fator de crista.
+ * @details Preenche apenas rms, level_db, zcr e crest_db; chamada por
+ *          audio_features_compute() e exposta para os benchmarks.
+ */
+void audio_features_time_domain(const int16_t *samples, audio_frame_features_t *out);
+
+/**
+ * @brief Calcula as características de um quadro já centrado (sem componente DC).
+ * @details Mantém o espectro do quadro anterior para o fluxo espectral, portanto
+ *          deve ser chamada apenas pelo Core 1, uma vez por quadro.
+ * @param samples AUDIO_BLOCK_SIZE amostras centradas.
+ * @param out Estrutura de saída.
+ */
+void audio_features_compute(const int16_t *samples, audio_frame_features_t *out);
+
+/**
+ * @brief Espectro de potência do último quadro processado (AUDIO_FFT_BINS valores).
+ * @details Válido até a próxima chamada de audio_features_compute() (Core 1).
+ */
+const uint32_t *audio_features_spectrum(void);
+
+/**
+ * @brief Quantiza as características para int8.
+ * @param f Características em unidades físicas.
+ * @param q Vetor de saída com AUDIO_FEATURE_COUNT posições.
+ */
+void audio_features_quantize(const audio_frame_features_t *f, int8_t *q);
+
+#endif
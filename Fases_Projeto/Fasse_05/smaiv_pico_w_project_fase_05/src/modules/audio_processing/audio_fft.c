@@ -0,0 +1,89 @@
+/**
+ * @file audio_fft.c
+ * @brief Implementação da FFT radix-2 em ponto fixo (sem FPU, Cortex-M0+).
+ * @details Cada estágio divide o resultado por 2 (com arredondamento), o que evita
+ *          saturação e resulta em uma escala total de 1/N.
+ */
+#include "audio_fft.h"
+#include "hal/hal.h"
+#include <math.h>
+
+#if (AUDIO_FFT_SIZE & (AUDIO_FFT_SIZE - 1)) != 0
+#error "AUDIO_FFT_SIZE deve ser potencia de 2"
+#endif
+
+static int16_t twiddle_cos[AUDIO_FFT_SIZE / 2];
+static int16_t twiddle_sin[AUDIO_FFT_SIZE / 2];
+static int16_t hann_window[AUDIO_FFT_SIZE];
+
+static int16_t fft_re[AUDIO_FFT_SIZE];
+static int16_t fft_im[AUDIO_FFT_SIZE];
+
+void audio_fft_init(void) {
+    const float two_pi = 6.28318530718f;
+    for (int k = 0; k < AUDIO_FFT_SIZE / 2; k++) {
+        twiddle_cos[k] = (int16_t)lroundf(32767.0f * cosf(two_pi * k / AUDIO_FFT_SIZE));
+        twiddle_sin[k] = (int16_t)lroundf(32767.0f * sinf(two_pi * k / AUDIO_FFT_SIZE));
+    }
+    for (int n = 0; n < AUDIO_FFT_SIZE; n++) {
+        hann_window[n] = (int16_t)lroundf(32767.0f * 0.5f * (1.0f - cosf(two_pi * n / AUDIO_FFT_SIZE)));
+    }
+}
+
+static inline int16_t mul_q15(int16_t a, int16_t b) {
+    return (int16_t)(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+/**
+ * @brief Leva uma amostra de 12 bits à faixa do Q15 (x16), com saturação.
+ * @details Depois da remoção de DC uma amostra pode passar de ±2047; o deslocamento
+ *          simples estouraria o int16 e inverteria o sinal.
+ */
+static inline int16_t sample_to_q15(int16_t s) {
+    if (s > INT16_MAX >> 4) return INT16_MAX;
+    if (s < INT16_MIN >> 4) return INT16_MIN;
+    return (int16_t)(s * 16);
+}
+
+void HAL_RAM_FUNC(audio_fft_power)(const int16_t *samples, uint32_t *power) {
+    // Janela + reordenação por bit-reverso na carga (entrada real, imaginário nulo).
+    for (uint32_t i = 0, j = 0; i < AUDIO_FFT_SIZE; i++) {
+        fft_re[j] = mul_q15(sample_to_q15(samples[i]), hann_window[i]);
+        fft_im[j] = 0;
+
+        uint32_t bit = AUDIO_FFT_SIZE >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+
+    for (uint32_t len = 2, step = AUDIO_FFT_SIZE / 2; len <= AUDIO_FFT_SIZE; len <<= 1, step >>= 1) {
+        const uint32_t half = len >> 1;
+        for (uint32_t start = 0; start < AUDIO_FFT_SIZE; start += len) {
+            for (uint32_t k = 0; k < half; k++) {
+                const int32_t wr = twiddle_cos[k * step];
+                const int32_t wi = -twiddle_sin[k * step];
+                const uint32_t a = start + k;
+                const uint32_t b = a + half;
+
+                int32_t tr = (wr * fft_re[b] - wi * fft_im[b] + (1 << 14)) >> 15;
+                int32_t ti = (wr * fft_im[b] + wi * fft_re[b] + (1 << 14)) >> 15;
+                int32_t ar = fft_re[a];
+                int32_t ai = fft_im[a];
+
+                fft_re[a] = (int16_t)((ar + tr + 1) >> 1);
+                fft_im[a] = (int16_t)((ai + ti + 1) >> 1);
+                fft_re[b] = (int16_t)((ar - tr + 1) >> 1);
+                fft_im[b] = (int16_t)((ai - ti + 1) >> 1);
+            }
+        }
+    }
+
+    for (uint32_t k = 0; k < AUDIO_FFT_BINS; k++) {
+        int32_t re = fft_re[k];
+        int32_t im = fft_im[k];
+        power[k] = (uint32_t)(re * re) + (uint32_t)(im * im);
+    }
+}
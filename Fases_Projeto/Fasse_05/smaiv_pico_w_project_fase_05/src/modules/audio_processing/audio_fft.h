@@ -0,0 +1,38 @@
+/**
+ * @file audio_fft.h
+ * @brief FFT em ponto fixo (Q15) para a análise espectral dos quadros no Core 1.
+ */
+#ifndef AUDIO_FFT_H
+#define AUDIO_FFT_H
+
+#include <stdint.h>
+#include "config.h"
+
+#define AUDIO_FFT_SIZE   AUDIO_BLOCK_SIZE         ///< Pontos da FFT (potência de 2).
+#define AUDIO_FFT_BINS   (AUDIO_FFT_SIZE / 2 + 1) ///< Bins do espectro unilateral (DC..Nyquist).
+#define AUDIO_FFT_BIN_HZ ((float)AUDIO_SAMPLE_RATE_HZ / AUDIO_FFT_SIZE) ///< Resolução em Hz.
+
+/**
+ * @brief Converte uma soma de bins de audio_fft_power() em potência unilateral (LSB^2).
+ * @details Inclui o fator 2/256 da escala interna e a correção do ganho de potência
+ *          da janela de Hann (1 / 0,375). Não se aplica aos bins DC e Nyquist.
+ */
+#define AUDIO_FFT_POWER_TO_LSB2 ((2.0f / 256.0f) / 0.375f)
+
+/**
+ * @brief Pré-calcula as tabelas de twiddles e da janela de Hann.
+ * @details Deve ser chamada uma vez (Core 0) antes de lançar o Core 1.
+ */
+void audio_fft_init(void);
+
+/**
+ * @brief Calcula o espectro de potência de um quadro centrado.
+ * @details Aplica a janela de Hann e uma FFT radix-2 com escala 1/N. O resultado
+ *          está em unidades de (LSB * 16)^2 (ver AUDIO_FFT_POWER_TO_LSB2).
+ * @param samples AUDIO_FFT_SIZE amostras centradas (12 bits; fora de -2048..2047
+ *                saturam).
+ * @param power Saída com AUDIO_FFT_BINS valores |X[k]|^2.
+ */
+void audio_fft_power(const int16_t *samples, uint32_t *power);
+
+#endif
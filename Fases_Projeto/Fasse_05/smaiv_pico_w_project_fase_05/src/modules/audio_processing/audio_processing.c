@@ -3,70 +3,173 @@
  * @brief Implementação do módulo de aquisição e processamento de áudio no Core 1.
  */
 #include "audio_processing.h"
+#include "audio_features.h"
+#include "audio_fft.h"
+#include "noise_floor.h"
 #include "config.h"
-#include "pico/multicore.h"
-#include "hardware/adc.h"
-#include <math.h>
+#include "modules/sound_classifier/sound_classifier.h"
+#include "modules/adc_service/adc_service.h"
+#include "modules/profiler/profiler.h"
+#include "modules/supervisor/supervisor.h"
+#include "hal/hal.h"
+
+#if SMAIV_FREERTOS
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#else
+#include "hal/hal_queue.h"
+#endif
 
-#define SAMPLE_COUNT 256
 
 /**
- * @brief Função interna que calcula o nível de ruído (RMS).
- * @return float O valor RMS calculado.
+ * @brief Fila de medições do Core 1 para o Core 0 (fila da HAL entre núcleos,
+ *        ou fila do kernel na variante FreeRTOS).
  */
-static float calculate_rms_level(void) {
-    uint16_t samples[SAMPLE_COUNT];
-    uint32_t sum = 0;
-
-    adc_select_input(MIC_ADC_INPUT);
-
-    for (int i = 0; i < SAMPLE_COUNT; i++) {
-        samples[i] = adc_read();
-        sum += samples[i];
-    }
+#if SMAIV_FREERTOS
+static QueueHandle_t meas_queue;
+#else
+static hal_queue_t meas_queue;
+#endif
 
-    uint16_t dc_offset = sum / SAMPLE_COUNT;
+static sup_client_t dsp_client = SUP_INVALID_CLIENT;  ///< Heartbeat do DSP (um por bloco).
 
-    uint64_t sum_of_squares = 0;
-    for (int i = 0; i < SAMPLE_COUNT; i++) {
-        int32_t sample_centered = samples[i] - dc_offset;
-        sum_of_squares += (sample_centered * sample_centered);
-    }
+/**
+ * @brief Obtém do serviço de ADC um bloco de AUDIO_BLOCK_SIZE amostras do microfone
+ *        e o devolve centrado (componente DC removida).
+ * @param samples Buffer de saída.
+ */
+static void HAL_RAM_FUNC(acquire_block)(int16_t *samples) {
+    uint16_t raw[AUDIO_BLOCK_SIZE];
 
-    return sqrtf((float)sum_of_squares / SAMPLE_COUNT);
+    // A taxa de amostragem é imposta pelo hardware (ADC em round-robin + DMA).
+    adc_service_read_mic_block(raw);
+    audio_features_center(raw, samples);
 }
 
 /**
- * @brief Ponto de entrada para o Core 1.
- * @details Este é o loop infinito que será executado exclusivamente no Core 1.
- *          Ele continuamente calcula o nível de RMS e envia o resultado para o
- *          Core 0 através da FIFO inter-core.
+ * @brief Loop de processamento de áudio, executado exclusivamente no Core 1.
+ * @details A cada quadro calcula as características do áudio (incluindo o RMS),
+ *          alimenta o classificador e envia um registro de medição ao Core 0.
  */
-void core1_entry() {
+static void HAL_RAM_FUNC(audio_loop)(void) {
+    int16_t samples[AUDIO_BLOCK_SIZE];
+    audio_frame_features_t features;
+    uint32_t frame_count = 0;
+#if PROFILING_ENABLED
+    uint32_t last_block_us = 0;
+#endif
+
+    measurement_t m = {
+        .sound_class = SOUND_CLASS_UNKNOWN,
+        .class_score = 0
+    };
+
+    // O Core 1 é o dono do ADC: a captura é iniciada e consumida neste núcleo.
+    adc_service_start();
+
     // Loop infinito de processamento de áudio no Core 1
     while (true) {
-        float rms_value = calculate_rms_level();
+        acquire_block(samples);
+#if PROFILING_ENABLED
+        profiler_mark_period(PROF_DSP_JITTER, &last_block_us, AUDIO_FRAME_MS * 1000);
+#endif
+        PROF_START(block_t0);
+
+        audio_features_compute(samples, &features);
+        audio_features_quantize(&features, m.features);
+        sound_classifier_push_frame(m.features);
+
+        if (++frame_count % SOUND_CLASSIFIER_HOP_FRAMES == 0) {
+            sound_classifier_run(&m.sound_class, &m.class_score);
+        }
+
+        m.timestamp_ms = hal_time_ms();
+        m.rms_level = features.rms;
+        m.la_db = features.la_db;
+#if AUDIO_NOISE_FLOOR_ENABLED
+        m.event_level = noise_floor_process(audio_features_spectrum());
+#else
+        m.event_level = features.rms;
+#endif
+        PROF_STOP(PROF_DSP_BLOCK, block_t0);
+        supervisor_checkin(dsp_client);
 
-        // Para enviar um float pela FIFO (que espera um uint32_t),
-        multicore_fifo_push_blocking((uint32_t)(*(uint32_t*)&rms_value));
+        // Se o Core 0 estiver atrasado o quadro é descartado (a fila nunca bloqueia o DSP).
+#if SMAIV_FREERTOS
+        xQueueSend(meas_queue, &m, 0);
+#else
+        hal_queue_try_add(&meas_queue, &m);
+#endif
     }
 }
 
+#if SMAIV_FREERTOS
 /**
- * @brief Inicializa o pino do ADC conectado ao microfone.
+ * @brief Tarefa de DSP (fixada no Core 1). O pico_flash da SDK pausa esta tarefa
+ *        durante gravações na flash sem necessidade de inicialização adicional.
+ */
+static void audio_task(void *arg) {
+    (void)arg;
+    audio_loop();
+}
+#endif
+
+/**
+ * @brief Inicializa o serviço de ADC (microfone e joystick), a fila de medições,
+ *        as tabelas da FFT e o classificador de eventos.
  */
 void audio_init(void) {
-    adc_init();
-    adc_gpio_init(MIC_ADC_PIN);
+    adc_service_init();
+#if SMAIV_FREERTOS
+    meas_queue = xQueueCreate(AUDIO_MEAS_QUEUE_LEN, sizeof(measurement_t));
+#else
+    hal_queue_init(&meas_queue, sizeof(measurement_t), AUDIO_MEAS_QUEUE_LEN);
+#endif
+    audio_fft_init();
+    audio_features_init();
+    noise_floor_init();
+    sound_classifier_init();
+    dsp_client = supervisor_register("dsp", SUP_DSP_TIMEOUT_MS);
 }
 
 /**
  * @brief Lança o loop de processamento de áudio no Core 1.
  */
 void audio_launch_on_core1(void) {
-    // Reseta a FIFO antes de usar
-    multicore_fifo_clear_irq();
-    
-    // Lança a função 'core1_entry' no segundo núcleo
-    multicore_launch_core1(core1_entry);
-}
\ No newline at end of file
+#if SMAIV_FREERTOS
+    TaskHandle_t handle;
+    xTaskCreate(audio_task, "audio", RTOS_STACK_WORDS, NULL, RTOS_PRIO_AUDIO, &handle);
+    vTaskCoreAffinitySet(handle, 1u << 1);
+#else
+    // Lança o loop de áudio no segundo núcleo (pausável durante gravações na flash).
+    hal_core1_launch(audio_loop);
+#endif
+}
+
+/**
+ * @brief Retira a próxima medição produzida pelo Core 1, se houver.
+ * @param out Estrutura de saída.
+ * @return true se uma medição foi lida.
+ */
+bool audio_get_measurement(measurement_t *out) {
+#if SMAIV_FREERTOS
+    return xQueueReceive(meas_queue, out, 0) == pdTRUE;
+#else
+    return hal_queue_try_remove(&meas_queue, out);
+#endif
+}
+
+bool audio_measurement_pending(void) {
+#if SMAIV_FREERTOS
+    return uxQueueMessagesWaiting(meas_queue) > 0;
+#else
+    return !hal_queue_is_empty(&meas_queue);
+#endif
+}
+
+#if SMAIV_FREERTOS
+bool audio_wait_measurement(measurement_t *out, uint32_t timeout_ms) {
+    return xQueueReceive(meas_queue, out, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+#endif
@@ -1,6 +1,10 @@
 #ifndef AUDIO_PROCESSING_H
 #define AUDIO_PROCESSING_H
 
+#include <stdbool.h>
+#include "common.h"
+#include "config.h"
+
 /**
  * @brief Inicializa os recursos de hardware necessários para o processamento de áudio.
  */
@@ -9,9 +13,30 @@ void audio_init(void);
 /**
  * @brief Lança o loop de processamento de áudio no Core 1.
  * @details Esta função inicia o segundo núcleo do RP2040, que ficará
- *          dedicado a calcular o nível de ruído (RMS) e enviar os
- *          resultados para o Core 0 via FIFO.
+ *          dedicado a calcular as características do áudio (RMS, classe do
+ *          evento) e enviar os resultados para o Core 0 via fila de medições.
+ *          Na variante FreeRTOS, cria a tarefa de DSP fixada no Core 1.
  */
 void audio_launch_on_core1(void);
 
-#endif
\ No newline at end of file
+/**
+ * @brief Retira a próxima medição produzida pelo Core 1 (não bloqueante).
+ * @param out Estrutura de saída.
+ * @return true se uma medição foi lida.
+ */
+bool audio_get_measurement(measurement_t *out);
+
+/**
+ * @brief Indica se há medições aguardando na fila (fonte de eventos do escalonador).
+ */
+bool audio_measurement_pending(void);
+
+#if SMAIV_FREERTOS
+/**
+ * @brief Aguarda uma medição por até timeout_ms (bloqueia a tarefa chamadora).
+ * @return true se uma medição foi lida.
+ */
+bool audio_wait_measurement(measurement_t *out, uint32_t timeout_ms);
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file noise_floor.c
+ * @brief Implementação da subtração espectral com piso de ruído adaptativo.
+ */
+#include "noise_floor.h"
+#include "audio_fft.h"
+#include "audio_features.h"
+#include "hal/hal.h"
+#include <math.h>
+#include <stdbool.h>
+
+/**
+ * @brief Primeiro bin analisado (mesmo limite inferior das bandas de características).
+ */
+#define FIRST_BIN ((uint32_t)(31 / AUDIO_FFT_BIN_HZ + 0.5f))
+
+static uint32_t noise[AUDIO_FFT_BINS]; ///< Piso estimado por bin (mesma unidade de power[]).
+static bool primed = false;
+
+void noise_floor_init(void) {
+    primed = false;
+}
+
+float HAL_RAM_FUNC(noise_floor_process)(const uint32_t *power) {
+    uint64_t residual = 0;
+
+    if (!primed) {
+        for (uint32_t k = 0; k < AUDIO_FFT_BINS; k++) noise[k] = power[k];
+        primed = true;
+    }
+
+    for (uint32_t k = FIRST_BIN; k < AUDIO_FFT_BINS - 1; k++) {
+        uint32_t p = power[k];
+        uint32_t n = noise[k];
+
+        // Subtração com sobre-estimativa: descarta flutuações normais do próprio ruído.
+        uint64_t floor_p = (uint64_t)n * AUDIO_NOISE_OVERSUBTRACT;
+        if (p > floor_p) residual += p - floor_p;
+
+        // Piso assimétrico: acompanha quedas rapidamente e subidas lentamente, de modo
+        // que eventos transitórios quase não contaminam a estimativa.
+        if (p < n) {
+            noise[k] = n - ((n - p) >> AUDIO_NOISE_FALL_SHIFT);
+        } else {
+            noise[k] = n + ((p - n) >> AUDIO_NOISE_RISE_SHIFT) + 1;
+        }
+    }
+
+    return sqrtf((float)residual * AUDIO_FFT_POWER_TO_LSB2);
+}
+
+float noise_floor_level(void) {
+    uint64_t total = 0;
+    for (uint32_t k = FIRST_BIN; k < AUDIO_FFT_BINS - 1; k++) total += noise[k];
+    return sqrtf((float)total * AUDIO_FFT_POWER_TO_LSB2);
+}
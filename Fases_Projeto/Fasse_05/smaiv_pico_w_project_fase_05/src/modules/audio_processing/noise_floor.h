@@ -0,0 +1,31 @@
+/**
+ * @file noise_floor.h
+ * @brief Estimativa do ruído estacionário e subtração espectral do nível de evento.
+ * @details Mantém, por bin da FFT, uma estimativa do espectro de ruído de fundo
+ *          (ex.: zumbido de máquinas) que desce rapidamente e sobe lentamente.
+ *          O nível de evento é o RMS da potência que excede esse piso. A atualização
+ *          é incremental por quadro e usa apenas memória estática (Core 1).
+ */
+#ifndef NOISE_FLOOR_H
+#define NOISE_FLOOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief Reinicia a estimativa (o primeiro quadro seguinte vira o piso inicial).
+ */
+void noise_floor_init(void);
+
+/**
+ * @brief Atualiza o piso de ruído com o espectro do quadro e retorna o nível acima dele.
+ * @param power Espectro de potência do quadro (saída de audio_fft_power()).
+ * @return Nível RMS (LSB do ADC) da parcela do quadro acima do piso de ruído.
+ */
+float noise_floor_process(const uint32_t *power);
+
+/**
+ * @brief Nível RMS (LSB do ADC) correspondente ao piso de ruído estimado atual.
+ */
+float noise_floor_level(void);
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file console.c
+ * @brief Implementação do console de comandos sobre USB CDC.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "hal/hal.h"
+#include "config.h"
+#include "console.h"
+
+static const console_command_t *commands[CONSOLE_MAX_COMMANDS];
+static uint8_t num_commands = 0;
+
+static char line[CONSOLE_LINE_MAX];
+static uint8_t line_len = 0;
+
+bool console_register(const console_command_t *cmd) {
+    if (num_commands >= CONSOLE_MAX_COMMANDS) {
+        return false;
+    }
+    commands[num_commands++] = cmd;
+    return true;
+}
+
+static void print_help(void) {
+    printf("Comandos:\n  help - lista os comandos\n");
+    for (uint8_t i = 0; i < num_commands; i++) {
+        printf("  %s - %s\n", commands[i]->name, commands[i]->help);
+    }
+}
+
+/**
+ * @brief Separa o nome do comando dos argumentos e chama o tratador.
+ */
+static void dispatch(char *text) {
+    while (*text == ' ') text++;
+    if (*text == '\0') {
+        return;
+    }
+
+    char *args = strchr(text, ' ');
+    if (args) {
+        *args++ = '\0';
+        while (*args == ' ') args++;
+    } else {
+        args = text + strlen(text);
+    }
+
+    if (strcmp(text, "help") == 0) {
+        print_help();
+        return;
+    }
+    for (uint8_t i = 0; i < num_commands; i++) {
+        if (strcmp(text, commands[i]->name) == 0) {
+            commands[i]->handler(args);
+            return;
+        }
+    }
+    printf("Comando desconhecido: '%s' (use 'help').\n", text);
+}
+
+void console_poll(void) {
+    int c;
+    while ((c = hal_console_getc()) >= 0) {
+        if (c == '\r' || c == '\n') {
+            line[line_len] = '\0';
+            line_len = 0;
+            dispatch(line);
+        } else if (line_len < CONSOLE_LINE_MAX - 1) {
+            line[line_len++] = (char)c;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file console.h
+ * @brief Console de comandos em linha sobre o stdio USB (CDC).
+ * @details Lê caracteres sem bloquear, monta uma linha e a despacha para o comando
+ *          registrado com o mesmo nome (primeira palavra). O comando "help" lista
+ *          os comandos disponíveis.
+ */
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdbool.h>
+
+/**
+ * @brief Função de um comando; args aponta para o texto após o nome (pode ser "").
+ */
+typedef void (*console_handler_t)(const char *args);
+
+/**
+ * @brief Descrição de um comando (deve ter duração estática).
+ */
+typedef struct {
+    const char *name;
+    const char *help;
+    console_handler_t handler;
+} console_command_t;
+
+/**
+ * @brief Registra um comando.
+ * @return false se a tabela (CONSOLE_MAX_COMMANDS) estiver cheia.
+ */
+bool console_register(const console_command_t *cmd);
+
+/**
+ * @brief Consome os caracteres disponíveis e executa as linhas completas.
+ */
+void console_poll(void);
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file event_segmenter.c
+ * @brief Implementação do segmentador de eventos acústicos.
+ */
+#include "event_segmenter.h"
+#include "config.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief Acumuladores do evento em andamento.
+ */
+static struct {
+    bool active;
+    uint32_t start_ms;
+    uint32_t last_active_ms;
+    uint8_t frames_below;                  ///< Quadros consecutivos abaixo do nível de liberação.
+    uint16_t frames;
+    float peak;
+    float energy_sum;                      ///< Soma de nível^2 dos quadros do evento.
+    float band_energy[AUDIO_NUM_BANDS];    ///< Energia linear acumulada por banda.
+    uint16_t class_votes[SOUND_CLASS_COUNT];
+} seg;
+
+void event_segmenter_init(void) {
+    memset(&seg, 0, sizeof(seg));
+}
+
+bool event_segmenter_active(void) {
+    return seg.active;
+}
+
+static void accumulate(const measurement_t *m) {
+    float level = m->event_level;
+    if (level > seg.peak) seg.peak = level;
+    seg.energy_sum += level * level;
+    seg.frames++;
+    seg.last_active_ms = m->timestamp_ms;
+
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+        int q = m->features[AUDIO_FEATURE_BAND_0 + b];
+        float db = (q + 128) * audio_feature_scale[AUDIO_FEATURE_BAND_0 + b];
+        seg.band_energy[b] += powf(10.0f, db * 0.1f);
+    }
+    if (m->sound_class < SOUND_CLASS_COUNT) seg.class_votes[m->sound_class]++;
+}
+
+static void finish(sound_event_t *out, bool truncated) {
+    out->start_ms = seg.start_ms;
+    out->end_ms = seg.last_active_ms;
+    out->duration_ms = seg.last_active_ms - seg.start_ms;
+    out->peak_level = seg.peak;
+    out->leq_db = 10.0f * log10f(seg.energy_sum / seg.frames);
+    out->frames = seg.frames;
+    out->truncated = truncated;
+
+    out->dominant_band = 0;
+    for (uint8_t b = 1; b < AUDIO_NUM_BANDS; b++) {
+        if (seg.band_energy[b] > seg.band_energy[out->dominant_band]) out->dominant_band = b;
+    }
+
+    out->sound_class = SOUND_CLASS_UNKNOWN;
+    uint16_t best_votes = 0;
+    for (uint8_t c = 0; c < SOUND_CLASS_COUNT; c++) {
+        if (seg.class_votes[c] > best_votes) {
+            best_votes = seg.class_votes[c];
+            out->sound_class = c;
+        }
+    }
+
+    event_segmenter_init();
+}
+
+segment_result_t event_segmenter_process(const measurement_t *m, float threshold, sound_event_t *out) {
+    if (!seg.active) {
+        if (m->event_level <= threshold) return SEGMENT_NONE;
+
+        seg.active = true;
+        seg.start_ms = m->timestamp_ms - AUDIO_FRAME_MS;
+        accumulate(m);
+        return SEGMENT_STARTED;
+    }
+
+    // Histerese: o evento se mantém enquanto o nível ficar acima do nível de liberação.
+    if (m->event_level >= threshold * EVENT_RELEASE_RATIO) {
+        seg.frames_below = 0;
+        accumulate(m);
+        if (m->timestamp_ms - seg.start_ms >= EVENT_MAX_DURATION_MS) {
+            finish(out, true);
+            return SEGMENT_ENDED;
+        }
+        return SEGMENT_NONE;
+    }
+
+    if (++seg.frames_below >= EVENT_HANGOVER_FRAMES) {
+        finish(out, false);
+        return SEGMENT_ENDED;
+    }
+    return SEGMENT_NONE;
+}
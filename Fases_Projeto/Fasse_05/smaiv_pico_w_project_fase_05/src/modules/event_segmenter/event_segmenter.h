@@ -0,0 +1,58 @@
+/**
+ * @file event_segmenter.h
+ * @brief Segmentação de eventos acústicos sobre o fluxo de medições (Core 0).
+ * @details Converte a sequência de quadros em eventos completos com início, fim,
+ *          duração, pico, Leq, banda dominante e classe. Opera em streaming, com
+ *          histerese e tempo de sustentação, usando estado de tamanho fixo.
+ */
+#ifndef EVENT_SEGMENTER_H
+#define EVENT_SEGMENTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+
+/**
+ * @brief Registro de um evento acústico completo.
+ */
+typedef struct {
+    uint32_t start_ms;       ///< Início do primeiro quadro acima do limiar (ms desde o boot).
+    uint32_t end_ms;         ///< Fim do último quadro acima do nível de liberação.
+    uint32_t duration_ms;    ///< end_ms - start_ms.
+    float peak_level;        ///< Maior nível de quadro no evento (mesma unidade do limiar).
+    float leq_db;            ///< Nível equivalente: 10*log10 da média de nível^2 (dB re 1 LSB).
+    uint8_t dominant_band;   ///< Banda com maior energia acumulada (índice em audio_band_edges_hz).
+    uint8_t sound_class;     ///< Classe mais frequente durante o evento (sound_class_t).
+    uint16_t frames;         ///< Quadros acumulados no evento.
+    bool truncated;          ///< true se o evento foi encerrado por EVENT_MAX_DURATION_MS.
+} sound_event_t;
+
+/**
+ * @brief Resultado do processamento de uma medição.
+ */
+typedef enum {
+    SEGMENT_NONE = 0,   ///< Nada mudou.
+    SEGMENT_STARTED,    ///< Um evento começou neste quadro.
+    SEGMENT_ENDED       ///< Um evento terminou; o registro foi escrito na saída.
+} segment_result_t;
+
+/**
+ * @brief Reinicia o segmentador (descarta um evento em andamento).
+ */
+void event_segmenter_init(void);
+
+/**
+ * @brief Processa uma medição do Core 1.
+ * @param m Medição do quadro.
+ * @param threshold Limiar de disparo (nível de evento).
+ * @param out Registro do evento, escrito quando o retorno é SEGMENT_ENDED.
+ * @return Transição ocorrida neste quadro.
+ */
+segment_result_t event_segmenter_process(const measurement_t *m, float threshold, sound_event_t *out);
+
+/**
+ * @brief Indica se há um evento em andamento.
+ */
+bool event_segmenter_active(void);
+
+#endif
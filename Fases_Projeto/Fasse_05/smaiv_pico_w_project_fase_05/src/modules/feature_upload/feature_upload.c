@@ -0,0 +1,57 @@
+/**
+ * @file feature_upload.c
+ * @brief Implementação do agregador de vetores de características (Core 0).
+ */
+#include "feature_upload.h"
+#include <string.h>
+
+static int32_t slot_sum[AUDIO_FEATURE_COUNT]; ///< Soma das características da fatia corrente.
+static uint8_t slot_frames = 0;                ///< Quadros acumulados na fatia corrente.
+static uint8_t slot_index = 0;                 ///< Fatia corrente dentro do pacote.
+static uint16_t sequence = 0;                  ///< Número de sequência do próximo pacote.
+static uint32_t packet_start_ms = 0;
+static int8_t slots[FEATURE_UPLOAD_SLOTS][AUDIO_FEATURE_COUNT];
+
+void feature_upload_begin(void) {
+    memset(slot_sum, 0, sizeof(slot_sum));
+    slot_frames = 0;
+    slot_index = 0;
+}
+
+bool feature_upload_add(const measurement_t *m, uint8_t *packet) {
+    if (slot_index == 0 && slot_frames == 0) {
+        packet_start_ms = m->timestamp_ms;
+    }
+
+    for (int i = 0; i < AUDIO_FEATURE_COUNT; i++) {
+        slot_sum[i] += m->features[i];
+    }
+    if (++slot_frames < FEATURE_UPLOAD_SLOT_FRAMES) return false;
+
+    // Fecha a fatia com a média arredondada (a soma pode ser negativa).
+    for (int i = 0; i < AUDIO_FEATURE_COUNT; i++) {
+        int32_t s = slot_sum[i];
+        int32_t half = FEATURE_UPLOAD_SLOT_FRAMES / 2;
+        slots[slot_index][i] = (int8_t)((s >= 0 ? s + half : s - half) / FEATURE_UPLOAD_SLOT_FRAMES);
+    }
+    memset(slot_sum, 0, sizeof(slot_sum));
+    slot_frames = 0;
+    if (++slot_index < FEATURE_UPLOAD_SLOTS) return false;
+    slot_index = 0;
+
+    packet[0] = 'F';
+    packet[1] = FEATURE_UPLOAD_VERSION;
+    packet[2] = (uint8_t)sequence;
+    packet[3] = (uint8_t)(sequence >> 8);
+    packet[4] = (uint8_t)packet_start_ms;
+    packet[5] = (uint8_t)(packet_start_ms >> 8);
+    packet[6] = (uint8_t)(packet_start_ms >> 16);
+    packet[7] = (uint8_t)(packet_start_ms >> 24);
+    packet[8] = FEATURE_UPLOAD_SLOTS;
+    packet[9] = AUDIO_FEATURE_COUNT;
+    packet[10] = FEATURE_UPLOAD_SLOT_FRAMES;
+    packet[11] = m->sound_class;
+    memcpy(packet + FEATURE_UPLOAD_HEADER_SIZE, slots, sizeof(slots));
+    sequence++;
+    return true;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file feature_upload.h
+ * @brief Empacotamento de vetores de características por segundo para envio via MQTT.
+ * @details Alternativa barata ao streaming de áudio: durante um evento, cada segundo
+ *          é resumido em FEATURE_UPLOAD_SLOTS fatias de ~256 ms com as características
+ *          quantizadas médias, totalizando ~70 bytes/s por dispositivo.
+ *
+ * ### Formato do pacote (little-endian)
+ * | Offset | Tamanho           | Campo                                        |
+ * |--------|-------------------|----------------------------------------------|
+ * | 0      | 1                 | Assinatura 'F' (0x46)                        |
+ * | 1      | 1                 | Versão (FEATURE_UPLOAD_VERSION)              |
+ * | 2      | 2                 | Número de sequência do pacote                |
+ * | 4      | 4                 | Timestamp (ms desde o boot) do 1º quadro     |
+ * | 8      | 1                 | Fatias por pacote                            |
+ * | 9      | 1                 | Características por fatia                    |
+ * | 10     | 1                 | Quadros por fatia                            |
+ * | 11     | 1                 | Classe do som (sound_class_t)                |
+ * | 12     | fatias * caract.  | Características int8 (ordem de audio_feature_t) |
+ *
+ * A desquantização usa `audio_feature_scale`: valor = (q + 128) * escala.
+ */
+#ifndef FEATURE_UPLOAD_H
+#define FEATURE_UPLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+
+#define FEATURE_UPLOAD_VERSION      1
+#define FEATURE_UPLOAD_SLOTS        4   ///< Fatias por pacote (1 pacote ~ 1 s).
+#define FEATURE_UPLOAD_SLOT_FRAMES  8   ///< Quadros de 32 ms por fatia.
+#define FEATURE_UPLOAD_HEADER_SIZE  12
+#define FEATURE_UPLOAD_PACKET_SIZE  (FEATURE_UPLOAD_HEADER_SIZE + FEATURE_UPLOAD_SLOTS * AUDIO_FEATURE_COUNT)
+
+/**
+ * @brief Inicia a coleta de um novo evento (descarta fatias parciais).
+ */
+void feature_upload_begin(void);
+
+/**
+ * @brief Acumula uma medição no pacote corrente.
+ * @param m Medição recebida do Core 1.
+ * @param packet Buffer de saída com FEATURE_UPLOAD_PACKET_SIZE bytes.
+ * @return true quando um pacote completo foi escrito em `packet`.
+ */
+bool feature_upload_add(const measurement_t *m, uint8_t *packet);
+
+#endif
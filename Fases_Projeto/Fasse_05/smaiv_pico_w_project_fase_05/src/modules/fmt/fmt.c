@@ -0,0 +1,182 @@
+/**
+ * @file fmt.c
+ * @brief Conversão de inteiros e ponto fixo para decimal em buffer limitado.
+ */
+#include "fmt.h"
+#include <string.h>
+
+static const uint32_t pow10_u32[10] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+void fmt_init(fmt_t *f, char *buf, size_t size) {
+    f->buf = buf;
+    f->size = size;
+    f->len = 0;
+    f->truncated = false;
+    buf[0] = '\0';
+}
+
+void fmt_char(fmt_t *f, char c) {
+    if (f->len + 1 >= f->size) {
+        f->truncated = true;
+        return;
+    }
+    f->buf[f->len++] = c;
+    f->buf[f->len] = '\0';
+}
+
+void fmt_str(fmt_t *f, const char *s) {
+    while (*s) {
+        if (f->len + 1 >= f->size) {
+            f->truncated = true;
+            break;
+        }
+        f->buf[f->len++] = *s++;
+    }
+    f->buf[f->len] = '\0';
+}
+
+/**
+ * @brief Escreve os dígitos de v (sem sinal) precedidos de sign, com largura mínima.
+ * @details Os dígitos são gerados do menos significativo para o mais significativo em
+ *          um buffer local. Valores de 32 bits usam só divisões de 32 bits (divisor de
+ *          hardware do RP2040); a divisão de 64 bits fica restrita a números maiores.
+ */
+static void put_digits(fmt_t *f, uint64_t v, char sign, uint8_t width, char pad) {
+    char digits[20];
+    uint8_t n = 0;
+    while (v > UINT32_MAX) {
+        digits[n++] = (char)('0' + (uint32_t)(v % 10u));
+        v /= 10u;
+    }
+    uint32_t v32 = (uint32_t)v;
+    do {
+        digits[n++] = (char)('0' + v32 % 10u);
+        v32 /= 10u;
+    } while (v32);
+
+    uint8_t total = (uint8_t)(n + (sign ? 1 : 0));
+    if (pad == '0' && sign) {
+        fmt_char(f, sign);
+    }
+    for (; total < width; total++) {
+        fmt_char(f, pad);
+    }
+    if (pad != '0' && sign) {
+        fmt_char(f, sign);
+    }
+    while (n) {
+        fmt_char(f, digits[--n]);
+    }
+}
+
+void fmt_u32_pad(fmt_t *f, uint32_t v, uint8_t width, char pad) {
+    put_digits(f, v, 0, width, pad);
+}
+
+void fmt_i32_pad(fmt_t *f, int32_t v, uint8_t width, char pad) {
+    uint32_t mag = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+    put_digits(f, mag, v < 0 ? '-' : 0, width, pad);
+}
+
+void fmt_fixed(fmt_t *f, int64_t v, uint8_t decimals) {
+    if (decimals > 9) {
+        decimals = 9;
+    }
+    uint64_t mag = v < 0 ? 0u - (uint64_t)v : (uint64_t)v;
+    uint32_t div = pow10_u32[decimals];
+    put_digits(f, mag / div, v < 0 ? '-' : 0, 0, ' ');
+    if (decimals) {
+        fmt_char(f, '.');
+        put_digits(f, mag % div, 0, decimals, '0');
+    }
+}
+
+/**
+ * @brief Escreve mantissa * 2^exponent quando passa de 64 bits (|x| >= 2^63).
+ * @details O valor (até 2^128) fica em quatro palavras de 32 bits e sai em blocos de
+ *          9 dígitos, por divisões sucessivas por 10^9 com resto de 32 bits.
+ */
+static void put_wide(fmt_t *f, uint32_t mantissa, uint32_t exponent) {
+    uint32_t words[4] = { 0 };          // Menos significativa primeiro.
+    uint32_t word = exponent / 32, bit = exponent % 32;
+    words[word] = mantissa << bit;
+    if (bit > 8) {                      // A mantissa de 24 bits cruza a palavra.
+        words[word + 1] = mantissa >> (32 - bit);
+    }
+
+    uint32_t chunks[5];                 // 2^128 < 10^45.
+    uint8_t n = 0;
+    bool nonzero = true;
+    while (nonzero) {
+        uint64_t rem = 0;
+        nonzero = false;
+        for (int i = 3; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | words[i];
+            words[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+            nonzero = nonzero || words[i];
+        }
+        chunks[n++] = (uint32_t)rem;
+    }
+    put_digits(f, chunks[--n], 0, 0, ' ');
+    while (n) {
+        put_digits(f, chunks[--n], 0, 9, '0');
+    }
+}
+
+void fmt_float(fmt_t *f, float x, uint8_t decimals) {
+    if (decimals > 6) {
+        decimals = 6;
+    }
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bool negative = (bits >> 31) != 0;
+    int32_t exponent = (int32_t)((bits >> 23) & 0xFFu);
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFF) {
+        fmt_str(f, mantissa ? "nan" : negative ? "-inf" : "inf");
+        return;
+    }
+    // x = mantissa * 2^exponent, com a mantissa inteira de 24 bits.
+    if (exponent == 0) {
+        exponent = -149;                // Subnormal.
+    } else {
+        mantissa |= 0x800000u;
+        exponent -= 150;
+    }
+    if (negative) {
+        fmt_char(f, '-');               // Como o printf, inclusive em "-0.0".
+    }
+
+    if (exponent >= 0) {
+        // Inteiro exato: sem casas a arredondar.
+        if (exponent <= 39) {
+            put_digits(f, (uint64_t)mantissa << exponent, 0, 0, ' ');
+        } else {
+            put_wide(f, mantissa, (uint32_t)exponent);
+        }
+        if (decimals) {
+            fmt_char(f, '.');
+            put_digits(f, 0, 0, decimals, '0');
+        }
+        return;
+    }
+
+    // x * 10^decimals = mantissa * 10^decimals / 2^-exponent (numerador < 2^44), com
+    // arredondamento para o par mais próximo, como o printf.
+    uint64_t num = (uint64_t)mantissa * pow10_u32[decimals];
+    uint32_t shift = (uint32_t)-exponent;
+    uint64_t q = 0;
+    if (shift < 64) {
+        q = num >> shift;
+        uint64_t rem = num & ((1ull << shift) - 1u);
+        uint64_t half = 1ull << (shift - 1);
+        if (rem > half || (rem == half && (q & 1u))) {
+            q++;
+        }
+    }
+    fmt_fixed(f, (int64_t)q, decimals);
+}
@@ -0,0 +1,83 @@
+/**
+ * @file fmt.h
+ * @brief Formatação de números e textos sem printf, para a UI, os payloads e o log.
+ * @details O Cortex-M0+ não tem FPU: o "%f" do printf arrasta a formatação de float
+ *          em software (vários kB de flash e dezenas de µs por número). Aqui os números
+ *          são convertidos com aritmética inteira e escritos em um buffer limitado, que
+ *          é sempre terminado em zero; o que não couber é descartado e sinalizado em
+ *          fmt_t::truncated. Valores com casas decimais são escritos a partir de ponto
+ *          fixo (fmt_fixed) ou dos bits do float (fmt_float), sem operações de float.
+ *
+ *          Uso:
+ *          @code
+ *          char buf[32];
+ *          fmt_t f;
+ *          fmt_init(&f, buf, sizeof(buf));
+ *          fmt_str(&f, "Nivel:");
+ *          fmt_float(&f, level, 0);
+ *          @endcode
+ */
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Buffer de saída em montagem.
+ */
+typedef struct {
+    char *buf;
+    size_t size;        ///< Capacidade, incluindo o terminador.
+    size_t len;         ///< Caracteres escritos (sem o terminador).
+    bool truncated;     ///< Algo foi descartado por falta de espaço.
+} fmt_t;
+
+/**
+ * @brief Prepara um buffer vazio (size deve ser pelo menos 1).
+ */
+void fmt_init(fmt_t *f, char *buf, size_t size);
+
+void fmt_char(fmt_t *f, char c);
+void fmt_str(fmt_t *f, const char *s);
+
+/**
+ * @brief Inteiro sem sinal em decimal, alinhado à direita em width caracteres.
+ * @param width Largura mínima (0 = sem preenchimento).
+ * @param pad Caractere de preenchimento (' ' ou '0').
+ */
+void fmt_u32_pad(fmt_t *f, uint32_t v, uint8_t width, char pad);
+
+/**
+ * @brief Inteiro com sinal em decimal, alinhado à direita em width caracteres
+ *        (com '0', o sinal vem antes dos zeros, como no "%05d").
+ */
+void fmt_i32_pad(fmt_t *f, int32_t v, uint8_t width, char pad);
+
+static inline void fmt_u32(fmt_t *f, uint32_t v) { fmt_u32_pad(f, v, 0, ' '); }
+static inline void fmt_i32(fmt_t *f, int32_t v) { fmt_i32_pad(f, v, 0, ' '); }
+
+/**
+ * @brief Número em ponto fixo decimal: v em unidades de 10^-decimals.
+ * @details fmt_fixed(f, -1234, 2) escreve "-12.34"; fmt_fixed(f, 5, 1) escreve "0.5".
+ * @param decimals Casas decimais (0 a 9).
+ */
+void fmt_fixed(fmt_t *f, int64_t v, uint8_t decimals);
+
+/**
+ * @brief Float com casas decimais fixas, equivalente ao "%.Nf".
+ * @details Conversão exata só com inteiros, a partir dos bits IEEE 754: o resultado
+ *          é o mesmo do printf (arredondamento para o par mais próximo, "-0.0" para
+ *          negativos que arredondam a zero), em toda a faixa do float (até ~3.4e38,
+ *          com todos os dígitos). NaN e infinitos são escritos como "nan", "inf" e "-inf".
+ * @param decimals Casas decimais (0 a 6).
+ */
+void fmt_float(fmt_t *f, float x, uint8_t decimals);
+
+/**
+ * @brief Texto montado (terminado em zero).
+ */
+static inline const char *fmt_cstr(const fmt_t *f) { return f->buf; }
+
+#endif
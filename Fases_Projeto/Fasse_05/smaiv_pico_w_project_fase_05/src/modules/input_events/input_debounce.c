@@ -0,0 +1,76 @@
+/**
+ * @file input_debounce.c
+ * @brief Implementação da máquina de estados de debounce (independente de hardware).
+ */
+#include "input_debounce.h"
+#include "config.h"
+
+/**
+ * @brief Comparação de tempo tolerante ao estouro do contador de 32 bits.
+ */
+static inline bool time_after_eq(uint32_t now, uint32_t t) {
+    return (int32_t)(now - t) >= 0;
+}
+
+void input_debounce_init(input_debounce_t *d, bool pressed, uint32_t long_press_ms, uint32_t repeat_ms) {
+    *d = (input_debounce_t){
+        .long_press_ms = long_press_ms,
+        .repeat_ms = repeat_ms,
+        .stable = pressed,
+        .candidate = pressed,
+        .hold_stage = INPUT_HOLD_IDLE   // Um pressionamento anterior ao boot não gera LONG_PRESS.
+    };
+}
+
+void input_debounce_edge(input_debounce_t *d, bool pressed, uint32_t now_ms) {
+    if (!d->pending) {
+        d->burst_ms = now_ms;
+        d->pending = true;
+    }
+    d->candidate = pressed;
+    d->last_edge_ms = now_ms;
+}
+
+bool input_debounce_poll(input_debounce_t *d, uint32_t now_ms, input_event_t *evt) {
+    // 1. Rajada estabilizada: aceita a mudança de nível, se houver.
+    if (d->pending && time_after_eq(now_ms, d->last_edge_ms + INPUT_DEBOUNCE_MS)) {
+        d->pending = false;
+        if (d->candidate != d->stable) {
+            d->stable = d->candidate;
+            evt->time_ms = d->burst_ms;
+            if (d->stable) {
+                d->pressed_ms = d->burst_ms;
+                d->hold_stage = (d->long_press_ms != 0) ? INPUT_HOLD_WAIT_LONG : INPUT_HOLD_IDLE;
+                evt->held_ms = 0;
+                evt->type = INPUT_EVT_PRESS;
+            } else {
+                evt->held_ms = d->burst_ms - d->pressed_ms;
+                evt->type = INPUT_EVT_RELEASE;
+            }
+            return true;
+        }
+    }
+
+    // 2. Entrada mantida: pressionamento longo e repetição (suspensos durante uma rajada).
+    if (!d->stable || d->pending) {
+        return false;
+    }
+    if (d->hold_stage == INPUT_HOLD_WAIT_LONG) {
+        uint32_t t = d->pressed_ms + d->long_press_ms;
+        if (time_after_eq(now_ms, t)) {
+            d->hold_stage = (d->repeat_ms != 0) ? INPUT_HOLD_REPEAT : INPUT_HOLD_IDLE;
+            d->next_repeat_ms = t + d->repeat_ms;
+            evt->time_ms = t;
+            evt->held_ms = d->long_press_ms;
+            evt->type = INPUT_EVT_LONG_PRESS;
+            return true;
+        }
+    } else if (d->hold_stage == INPUT_HOLD_REPEAT && time_after_eq(now_ms, d->next_repeat_ms)) {
+        evt->time_ms = d->next_repeat_ms;
+        evt->held_ms = d->next_repeat_ms - d->pressed_ms;
+        evt->type = INPUT_EVT_REPEAT;
+        d->next_repeat_ms += d->repeat_ms;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file input_debounce.h
+ * @brief Máquina de estados de debounce, pressionamento longo e repetição de uma entrada.
+ * @details Lógica pura (sem dependência da SDK): recebe bordas brutas com carimbo de
+ *          tempo e o tempo atual, e produz eventos já filtrados. Uma rajada de bordas
+ *          só é aceita depois de INPUT_DEBOUNCE_MS sem novas bordas; o evento recebe
+ *          o instante da primeira borda da rajada.
+ */
+#ifndef INPUT_DEBOUNCE_H
+#define INPUT_DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Tipos de evento de entrada.
+ */
+typedef enum {
+    INPUT_EVT_PRESS = 0,     ///< Entrada pressionada (após debounce).
+    INPUT_EVT_RELEASE,       ///< Entrada liberada; held_ms traz a duração.
+    INPUT_EVT_LONG_PRESS,    ///< Mantida por long_press_ms (emitido uma vez).
+    INPUT_EVT_REPEAT         ///< Repetição periódica após o pressionamento longo.
+} input_event_type_t;
+
+/**
+ * @brief Evento filtrado de uma entrada.
+ */
+typedef struct {
+    uint32_t time_ms;   ///< Instante do evento (ms desde o boot).
+    uint32_t held_ms;   ///< Tempo pressionado até o evento (0 em PRESS).
+    uint8_t input;      ///< Identificador da entrada (input_id_t).
+    uint8_t type;       ///< input_event_type_t.
+} input_event_t;
+
+/**
+ * @brief Fase do tratamento de uma entrada mantida pressionada.
+ */
+typedef enum {
+    INPUT_HOLD_WAIT_LONG = 0,  ///< Aguardando long_press_ms.
+    INPUT_HOLD_REPEAT,         ///< LONG_PRESS emitido; repetindo a cada repeat_ms.
+    INPUT_HOLD_IDLE            ///< Nada mais a emitir até a próxima liberação.
+} input_hold_stage_t;
+
+/**
+ * @brief Estado do debounce de uma entrada.
+ */
+typedef struct {
+    uint32_t long_press_ms;  ///< 0 desabilita o pressionamento longo (e a repetição).
+    uint32_t repeat_ms;      ///< 0 desabilita a repetição.
+    uint32_t burst_ms;       ///< Primeira borda da rajada em andamento.
+    uint32_t last_edge_ms;   ///< Última borda recebida.
+    uint32_t pressed_ms;     ///< Instante aceito do pressionamento atual.
+    uint32_t next_repeat_ms; ///< Próxima repetição agendada.
+    bool stable;             ///< Nível aceito (true = pressionado).
+    bool candidate;          ///< Nível da última borda bruta.
+    bool pending;            ///< Há uma rajada aguardando estabilizar.
+    uint8_t hold_stage;      ///< input_hold_stage_t do pressionamento atual.
+} input_debounce_t;
+
+/**
+ * @brief Inicializa o estado de uma entrada.
+ * @param pressed Nível inicial lido do pino.
+ * @param long_press_ms Tempo para LONG_PRESS (0 = desabilitado).
+ * @param repeat_ms Período de REPEAT após o LONG_PRESS (0 = desabilitado).
+ */
+void input_debounce_init(input_debounce_t *d, bool pressed, uint32_t long_press_ms, uint32_t repeat_ms);
+
+/**
+ * @brief Registra uma borda bruta (pode ser chamada com o mesmo nível repetido).
+ */
+void input_debounce_edge(input_debounce_t *d, bool pressed, uint32_t now_ms);
+
+/**
+ * @brief Avança a máquina de estados até now_ms e devolve o próximo evento.
+ * @param evt Evento de saída (o campo input não é preenchido).
+ * @return true se um evento foi produzido; chamar novamente até retornar false.
+ */
+bool input_debounce_poll(input_debounce_t *d, uint32_t now_ms, input_event_t *evt);
+
+#endif
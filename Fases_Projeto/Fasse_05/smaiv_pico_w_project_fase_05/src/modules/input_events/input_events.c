@@ -0,0 +1,127 @@
+/**
+ * @file input_events.c
+ * @brief Implementação do subsistema de entrada (IRQ de GPIO + debounce por tempo).
+ */
+#include "input_events.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "modules/adc_service/adc_service.h"
+
+/**
+ * @brief Borda bruta registrada pela interrupção.
+ */
+typedef struct {
+    uint32_t time_ms;
+    uint8_t input;
+    uint8_t pressed;
+} raw_edge_t;
+
+/**
+ * @brief Fila circular ISR -> loop principal (produtor e consumidor no Core 0).
+ */
+static raw_edge_t edge_queue[INPUT_EDGE_QUEUE_LEN];
+static volatile uint32_t edge_head = 0;
+static volatile uint32_t edge_tail = 0;
+static volatile uint32_t dropped_edges = 0;
+static volatile bool resync_needed = false;
+
+static input_debounce_t inputs[INPUT_COUNT];
+static uint8_t next_input = 0;   ///< Rodízio para não privilegiar uma entrada.
+
+static const uint32_t button_pins[] = {
+    [INPUT_BUTTON_A] = BUTTON_A_PIN,
+    [INPUT_JOY_SW] = JOYSTICK_SW_PIN
+};
+#define NUM_BUTTONS (sizeof(button_pins) / sizeof(button_pins[0]))
+
+/**
+ * @brief Callback de GPIO: apenas carimba e enfileira a borda (pinos pull-up, 0 = pressionado).
+ */
+static void HAL_RAM_FUNC(gpio_edge_callback)(uint32_t gpio) {
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        if (button_pins[i] != gpio) {
+            continue;
+        }
+        uint32_t head = edge_head;
+        if (head - edge_tail >= INPUT_EDGE_QUEUE_LEN) {
+            dropped_edges++;
+            resync_needed = true;
+            return;
+        }
+        raw_edge_t *e = &edge_queue[head % INPUT_EDGE_QUEUE_LEN];
+        e->time_ms = hal_time_ms();
+        e->input = i;
+        e->pressed = !hal_gpio_get(gpio);
+        edge_head = head + 1;
+        return;
+    }
+}
+
+/**
+ * @brief Converte o eixo Y do joystick em bordas das entradas virtuais (com histerese).
+ */
+static void sample_joystick(uint32_t now) {
+    uint16_t y = adc_service_joystick_y();
+    bool up = inputs[INPUT_JOY_UP].candidate;
+    bool down = inputs[INPUT_JOY_DOWN].candidate;
+
+    bool new_up = up ? (y > INPUT_JOY_HIGH - INPUT_JOY_HYST) : (y > INPUT_JOY_HIGH);
+    bool new_down = down ? (y < INPUT_JOY_LOW + INPUT_JOY_HYST) : (y < INPUT_JOY_LOW);
+
+    if (new_up != up) input_debounce_edge(&inputs[INPUT_JOY_UP], new_up, now);
+    if (new_down != down) input_debounce_edge(&inputs[INPUT_JOY_DOWN], new_down, now);
+}
+
+void input_events_init(void) {
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        hal_gpio_init_input_pullup(button_pins[i]);
+    }
+    // Aguarda os pull-ups estabilizarem antes de ler o nível inicial.
+    hal_sleep_us(10);
+
+    input_debounce_init(&inputs[INPUT_BUTTON_A], !hal_gpio_get(BUTTON_A_PIN), INPUT_LONG_PRESS_MS, 0);
+    input_debounce_init(&inputs[INPUT_JOY_SW], !hal_gpio_get(JOYSTICK_SW_PIN), INPUT_LONG_PRESS_MS, 0);
+    input_debounce_init(&inputs[INPUT_JOY_UP], false, INPUT_LONG_PRESS_MS, INPUT_REPEAT_MS);
+    input_debounce_init(&inputs[INPUT_JOY_DOWN], false, INPUT_LONG_PRESS_MS, INPUT_REPEAT_MS);
+
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        hal_gpio_enable_edge_irq(button_pins[i], gpio_edge_callback);
+    }
+}
+
+bool input_events_get(input_event_t *evt) {
+    uint32_t now = hal_time_ms();
+
+    // Entrega as bordas registradas pela interrupção à máquina de debounce.
+    while (edge_tail != edge_head) {
+        const raw_edge_t *e = &edge_queue[edge_tail % INPUT_EDGE_QUEUE_LEN];
+        input_debounce_edge(&inputs[e->input], e->pressed, e->time_ms);
+        edge_tail = edge_tail + 1;
+    }
+    // Após perda de bordas, injeta o nível atual dos pinos como uma nova borda.
+    if (resync_needed) {
+        resync_needed = false;
+        for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+            input_debounce_edge(&inputs[i], !hal_gpio_get(button_pins[i]), now);
+        }
+    }
+    sample_joystick(now);
+
+    for (uint8_t n = 0; n < INPUT_COUNT; n++) {
+        uint8_t i = next_input;
+        next_input = (uint8_t)((next_input + 1) % INPUT_COUNT);
+        if (input_debounce_poll(&inputs[i], now, evt)) {
+            evt->input = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool input_events_pending(void) {
+    return edge_tail != edge_head;
+}
+
+uint32_t input_events_dropped_edges(void) {
+    return dropped_edges;
+}
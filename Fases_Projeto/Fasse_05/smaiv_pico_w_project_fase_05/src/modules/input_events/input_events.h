@@ -0,0 +1,47 @@
+/**
+ * @file input_events.h
+ * @brief Subsistema de entrada não bloqueante: botões por interrupção e joystick.
+ * @details As bordas dos botões são capturadas por interrupção de GPIO com carimbo de
+ *          tempo e filtradas por input_debounce. O eixo Y do joystick é tratado como
+ *          duas entradas virtuais (cima/baixo) a partir da leitura do serviço de ADC.
+ *          O loop principal apenas consome eventos, sem nunca dormir.
+ */
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include "input_debounce.h"
+
+/**
+ * @brief Entradas reconhecidas.
+ */
+typedef enum {
+    INPUT_BUTTON_A = 0,   ///< Botão A (salvar/silenciar alarme).
+    INPUT_JOY_SW,         ///< Botão do joystick (entrar no menu).
+    INPUT_JOY_UP,         ///< Eixo Y acima de INPUT_JOY_HIGH.
+    INPUT_JOY_DOWN,       ///< Eixo Y abaixo de INPUT_JOY_LOW.
+    INPUT_COUNT
+} input_id_t;
+
+/**
+ * @brief Configura os pinos dos botões e registra a interrupção de GPIO (Core 0).
+ */
+void input_events_init(void);
+
+/**
+ * @brief Processa as bordas pendentes e devolve o próximo evento filtrado.
+ * @param evt Evento de saída.
+ * @return true se um evento foi retornado; chamar até retornar false.
+ */
+bool input_events_get(input_event_t *evt);
+
+/**
+ * @brief Indica se a interrupção registrou bordas ainda não processadas.
+ */
+bool input_events_pending(void);
+
+/**
+ * @brief Bordas descartadas por estouro da fila da interrupção.
+ */
+uint32_t input_events_dropped_edges(void);
+
+#endif
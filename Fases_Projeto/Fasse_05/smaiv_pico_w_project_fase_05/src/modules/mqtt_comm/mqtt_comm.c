@@ -1,108 +1,249 @@
 /**
  * @file mqtt_comm.c
  * @brief Gerencia a conectividade de rede e a comunicação via protocolo MQTT.
- * @details Este módulo encapsula a lógica de conexão Wi-Fi, resolução de DNS assíncrona
- *          e a publicação de mensagens MQTT para o broker.
+ * @details Este módulo monta os payloads e decide quando publicar; a conexão Wi-Fi,
+ *          a resolução de DNS e o cliente MQTT ficam na HAL de rede (hal_net.h).
  */
 #include "mqtt_comm.h"
 #include "config.h"
-#include "lwip/apps/mqtt.h"
-#include "lwip/dns.h"
+#include "modules/sound_classifier/sound_classifier.h"
+#include "modules/profiler/profiler.h"
+#include "modules/fmt/fmt.h"
+#include "hal/hal_net.h"
+#include <stdio.h>
 #include <string.h>
 
+#if SMAIV_FREERTOS
+#include "FreeRTOS.h"
+#include "queue.h"
+#endif
+
+/**
+ * @brief Status da conexão, escrito apenas pelo callback da pilha de rede.
+ * @details O módulo não escreve no estado global da aplicação: as tarefas consultam
+ *          mqtt_is_connected() no seu próprio contexto.
+ */
+static volatile bool connected = false;
+
+static sup_client_t lwip_client = SUP_INVALID_CLIENT;  ///< Heartbeat do contexto da LwIP.
+
+#if SMAIV_FREERTOS
 /**
- * @brief Estrutura interna para manter o estado do cliente LwIP MQTT.
+ * @brief Mensagem enfileirada para a tarefa de rede.
  */
-typedef struct MQTT_STATE_T {
-    ip_addr_t remote_addr;      ///< Endereço IP resolvido do broker.
-    mqtt_client_t *mqtt_client; ///< Ponteiro para a instância do cliente MQTT da LwIP.
-} MQTT_STATE_T;
-static MQTT_STATE_T internal_state; ///< Instância estática interna do estado MQTT.
+typedef struct {
+    const char *topic;              ///< Tópico (literal de config.h).
+    uint16_t len;
+    uint8_t qos;
+    uint8_t payload[MQTT_QUEUE_MSG_MAX];
+} mqtt_msg_t;
+
+static QueueHandle_t publish_queue;
+#endif
 
 /**
- * @brief Ponteiro para a estrutura de estado global do sistema.
- * @details Usado para atualizar o status da conexão MQTT no estado principal da aplicação.
+ * @brief Publica (bare-metal) ou enfileira para a tarefa de rede (FreeRTOS).
+ * @details Na variante FreeRTOS, mensagens são descartadas se a fila estiver cheia,
+ *          para que nenhuma tarefa de tempo real bloqueie esperando a rede.
  */
-static system_state_t *global_state_ptr = NULL;
+static void publish(const char *topic, const void *payload, uint16_t len, uint8_t qos) {
+#if SMAIV_FREERTOS
+    mqtt_msg_t msg = { .topic = topic, .len = len, .qos = qos };
+    if (len > sizeof(msg.payload)) { return; }
+    memcpy(msg.payload, payload, len);
+    xQueueSend(publish_queue, &msg, 0);
+#else
+    hal_net_lock();
+    hal_mqtt_publish(topic, payload, len, qos);
+    hal_net_unlock();
+#endif
+}
 
 /**
- * @brief Callback invocado pela LwIP quando o estado da conexão MQTT muda.
- * @param client Instância do cliente MQTT.
- * @param arg Argumento opcional passado durante a conexão (não utilizado aqui).
- * @param status Novo status da conexão (ex: MQTT_CONNECT_ACCEPTED).
+ * @brief Callback invocado pela pilha de rede quando o estado da conexão MQTT muda.
+ * @param ok true se o broker aceitou a conexão.
+ * @param code Código de status (ex: MQTT_CONNECT_ACCEPTED; negativo = falha de DNS).
  */
-static void mqtt_connection_cb(mqtt_client_t *client, void *arg, mqtt_connection_status_t status) {
-    if (status == MQTT_CONNECT_ACCEPTED) {
+static void mqtt_status_cb(bool ok, int code) {
+    PROF_START(cb_t0);
+    if (ok) {
         printf("MQTT: Conectado com sucesso!\n");
-        if(global_state_ptr) global_state_ptr->mqtt_connected = true;
     } else {
-        printf("MQTT: Falha na conexao, codigo: %d\n", status);
-        if(global_state_ptr) global_state_ptr->mqtt_connected = false;
+        printf("MQTT: Falha na conexao, codigo: %d\n", code);
     }
+    connected = ok;
+    PROF_STOP(PROF_MQTT_CB, cb_t0);
 }
 
 /**
- * @brief Callback invocado pela LwIP quando a resolução de DNS é concluída.
- * @details Esta abordagem assíncrona garante que a tentativa de conexão MQTT só ocorra
- *          após o endereço IP do broker ser obtido com sucesso.
- * @param name Nome do host que foi resolvido.
- * @param ipaddr Ponteiro para o endereço IP encontrado.
- * @param arg Argumento opcional (não utilizado).
+ * @brief Prepara os recursos do módulo (fila de publicação na variante FreeRTOS).
  */
-static void dns_found_cb(const char *name, const ip_addr_t *ipaddr, void *arg) {
-    // Aborta se a resolução de DNS falhar.
-    if (ipaddr == NULL) { 
-        printf("DNS: Falha ao resolver o hostname '%s'.\n", MQTT_BROKER_HOST);
-        return; 
-    }
-    
-    // Armazena o IP resolvido e inicia a conexão MQTT.
-    internal_state.remote_addr = *ipaddr;
-    struct mqtt_connect_client_info_t client_info;
-    memset(&client_info, 0, sizeof(client_info));
-    client_info.client_id = MQTT_CLIENT_ID;
-    client_info.keep_alive = 60;
-    
-    mqtt_client_connect(internal_state.mqtt_client, &internal_state.remote_addr, MQTT_BROKER_PORT, mqtt_connection_cb, NULL, &client_info);
+void mqtt_comm_init(void) {
+#if SMAIV_FREERTOS
+    publish_queue = xQueueCreate(MQTT_QUEUE_LEN, sizeof(mqtt_msg_t));
+#endif
+}
+
+/**
+ * @brief Temporizador da pilha de rede que prova ao supervisor que ela continua processando.
+ * @details Executa no contexto da LwIP (background ou tarefa tcpip) e se rearma.
+ */
+static void lwip_heartbeat_cb(void *arg) {
+    (void)arg;
+    supervisor_checkin(lwip_client);
+    hal_net_timeout(SUP_LWIP_HEARTBEAT_MS, lwip_heartbeat_cb, NULL);
 }
 
 /**
  * @brief Inicia o processo de conexão MQTT.
- * @details Cria o cliente MQTT e dispara a resolução de nome DNS. A conexão
- *          real é estabelecida dentro do callback `dns_found_cb`.
- * @param state Ponteiro para o estado global do sistema.
+ * @details Dispara a resolução do nome do broker; a sessão é aberta de forma
+ *          assíncrona e o resultado chega por mqtt_status_cb.
  */
-void mqtt_connect(system_state_t *state) {
-    global_state_ptr = state; // Salva o ponteiro para o estado global para uso nos callbacks.
-    internal_state.mqtt_client = mqtt_client_new();
-    if (internal_state.mqtt_client == NULL) { return; }
-    
-    // Dispara a requisição de DNS. É uma operação não-bloqueante.
-    dns_gethostbyname(MQTT_BROKER_HOST, &internal_state.remote_addr, dns_found_cb, NULL);
+void mqtt_connect(void) {
+    if (lwip_client == SUP_INVALID_CLIENT) {
+        lwip_client = supervisor_register("lwip", SUP_LWIP_TIMEOUT_MS);
+    }
+
+    hal_net_lock();
+    hal_net_timeout(SUP_LWIP_HEARTBEAT_MS, lwip_heartbeat_cb, NULL);
+    if (!hal_mqtt_connect(MQTT_BROKER_HOST, MQTT_BROKER_PORT, MQTT_CLIENT_ID, mqtt_status_cb)) {
+        printf("MQTT: Falha ao iniciar a conexao.\n");
+    }
+    hal_net_unlock();
 }
 
+#if SMAIV_FREERTOS
 /**
- * @brief Publica uma mensagem de alerta no tópico MQTT configurado.
- * @param state Ponteiro para o estado do sistema, de onde o nível de som é lido.
+ * @brief Laço da tarefa de rede: publica as mensagens enfileiradas pelas demais tarefas.
  */
-void mqtt_publish_alert(const system_state_t *state) {
-    if (!state->mqtt_connected) { return; }
-    
-    char payload[128];
-    snprintf(payload, sizeof(payload), "{\"message\":\"ALERTA DE SOM ALTO DETECTADO!\", \"sound_level\":%.1f, \"threshold\":%.1f}", 
-             state->current_sound_level, 
-             state->sound_threshold);
+void mqtt_publisher_loop(void) {
+    mqtt_msg_t msg;
+    while (true) {
+        xQueueReceive(publish_queue, &msg, portMAX_DELAY);
+        if (!connected) { continue; }
+
+        hal_net_lock();
+        hal_mqtt_publish(msg.topic, msg.payload, msg.len, msg.qos);
+        hal_net_unlock();
+    }
+}
+#endif
+
+/**
+ * @brief Publica o registro de um evento sonoro completo no tópico MQTT configurado.
+ * @param state Ponteiro para o estado do sistema, de onde o limiar é lido.
+ * @param event Evento encerrado pelo segmentador (início, duração, pico, Leq, banda, classe).
+ */
+void mqtt_publish_alert(const system_state_t *state, const sound_event_t *event) {
+    if (!mqtt_is_connected()) { return; }
+
+    char payload[256];
+    fmt_t f;
+    fmt_init(&f, payload, sizeof(payload));
+    fmt_str(&f, "{\"message\":\"ALERTA DE SOM ALTO DETECTADO!\", \"start_ms\":");
+    fmt_u32(&f, event->start_ms);
+    fmt_str(&f, ", \"end_ms\":");
+    fmt_u32(&f, event->end_ms);
+    fmt_str(&f, ", \"duration_ms\":");
+    fmt_u32(&f, event->duration_ms);
+    fmt_str(&f, ", \"peak\":");
+    fmt_float(&f, event->peak_level, 1);
+    fmt_str(&f, ", \"leq_db\":");
+    fmt_float(&f, event->leq_db, 1);
+    fmt_str(&f, ", \"band_hz\":[");
+    fmt_u32(&f, audio_band_edges_hz[event->dominant_band]);
+    fmt_char(&f, ',');
+    fmt_u32(&f, audio_band_edges_hz[event->dominant_band + 1]);
+    fmt_str(&f, "], \"threshold\":");
+    fmt_float(&f, state->sound_threshold, 1);
+    fmt_str(&f, ", \"class\":\"");
+    fmt_str(&f, sound_class_name(event->sound_class));
+    fmt_str(&f, "\", \"partial\":");
+    fmt_str(&f, event->truncated ? "true}" : "false}");
     
     // Publica a mensagem com QoS 1 para garantir pelo menos uma entrega.
-    mqtt_publish(internal_state.mqtt_client, MQTT_TOPIC_ALERT, payload, strlen(payload), 1, 0, NULL, NULL);
+    publish(MQTT_TOPIC_ALERT, payload, f.len, 1);
     printf("MQTT: Alerta publicado.\n");
 }
 
+/**
+ * @brief Publica um pacote binário de características (ver feature_upload.h).
+ * @details Usa QoS 0: um vetor perdido é menos custoso do que retransmissões
+ *          acumulando na pilha durante um evento longo.
+ * @param packet Pacote já serializado.
+ * @param len Tamanho do pacote em bytes.
+ */
+void mqtt_publish_features(const uint8_t *packet, uint16_t len) {
+    if (!mqtt_is_connected()) { return; }
+
+    publish(MQTT_TOPIC_FEATURES, packet, len, 0);
+}
+
+/**
+ * @brief Publica o resumo da dose de ruído da jornada corrente.
+ * @param status Dose, TWA e tempo de exposição calculados pelo módulo noise_dose.
+ */
+void mqtt_publish_dose(const noise_dose_status_t *status) {
+    if (!mqtt_is_connected()) { return; }
+
+    char payload[160];
+    fmt_t f;
+    fmt_init(&f, payload, sizeof(payload));
+    fmt_str(&f, "{\"dose_pct\":");
+    fmt_float(&f, status->dose_percent, 2);
+    fmt_str(&f, ", \"projected_pct\":");
+    fmt_float(&f, status->projected_percent, 1);
+    fmt_str(&f, ", \"twa_db\":");
+    fmt_float(&f, status->twa_db, 1);
+    fmt_str(&f, ", \"projected_twa_db\":");
+    fmt_float(&f, status->projected_twa_db, 1);
+    fmt_str(&f, ", \"exposure_min\":");
+    fmt_u32(&f, status->exposure_ms / 60000);
+    fmt_char(&f, '}');
+
+    publish(MQTT_TOPIC_DOSE, payload, f.len, 1);
+}
+
+/**
+ * @brief Publica uma linha JSON do relatório de desempenho (QoS 0).
+ * @param json Texto terminado em zero (ver profiler.h).
+ */
+void mqtt_publish_profile(const char *json) {
+    if (!mqtt_is_connected()) { return; }
+
+    publish(MQTT_TOPIC_PROFILE, json, strlen(json), 0);
+}
+
+/**
+ * @brief Publica a causa da reinicialização anterior (uma vez por boot, QoS 1).
+ * @param info Breadcrumbs recuperados pelo supervisor.
+ * @param task_name Nome da última tarefa do Core 0 ou "-".
+ */
+void mqtt_publish_reset(const sup_reset_info_t *info, const char *task_name) {
+    if (!mqtt_is_connected()) { return; }
+
+    char payload[160];
+    fmt_t f;
+    fmt_init(&f, payload, sizeof(payload));
+    fmt_str(&f, "{\"cause\":\"");
+    fmt_str(&f, supervisor_cause_name(info->cause));
+    fmt_str(&f, "\", \"client\":\"");
+    fmt_str(&f, supervisor_client_name(info->client));
+    fmt_str(&f, "\", \"last_task\":\"");
+    fmt_str(&f, task_name);
+    fmt_str(&f, "\", \"loop\":");
+    fmt_u32(&f, info->loop_count);
+    fmt_str(&f, ", \"uptime_s\":");
+    fmt_u32(&f, info->uptime_s);
+    fmt_char(&f, '}');
+
+    publish(MQTT_TOPIC_RESET, payload, f.len, 1);
+}
+
 /**
  * @brief Retorna o status atual da conexão MQTT.
  * @return true se o cliente MQTT estiver conectado, false caso contrário.
  */
 bool mqtt_is_connected(void){
-    // Verifica se o ponteiro global é válido antes de acessá-lo.
-    return global_state_ptr ? global_state_ptr->mqtt_connected : false;
+    return connected;
 }
\ No newline at end of file
@@ -2,9 +2,22 @@
 #define MQTT_COMM_H
 
 #include "common.h"
+#include "config.h"
+#include "modules/event_segmenter/event_segmenter.h"
+#include "modules/noise_dose/noise_dose.h"
+#include "modules/supervisor/supervisor.h"
 
-void mqtt_connect(system_state_t *state);
-void mqtt_publish_alert(const system_state_t *state);
+void mqtt_comm_init(void);
+void mqtt_connect(void);
+void mqtt_publish_alert(const system_state_t *state, const sound_event_t *event);
+void mqtt_publish_features(const uint8_t *packet, uint16_t len);
+void mqtt_publish_dose(const noise_dose_status_t *status);
+void mqtt_publish_profile(const char *json);
+void mqtt_publish_reset(const sup_reset_info_t *info, const char *task_name);
 bool mqtt_is_connected(void);
 
+#if SMAIV_FREERTOS
+void mqtt_publisher_loop(void);
+#endif
+
 #endif
\ No newline at end of file
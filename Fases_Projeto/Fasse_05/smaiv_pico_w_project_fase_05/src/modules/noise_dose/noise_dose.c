@@ -0,0 +1,161 @@
+/**
+ * @file noise_dose.c
+ * @brief Implementação do dosímetro de ruído e da sua persistência em flash.
+ * @details A dose é acumulada em ponto fixo (ms * 2^16 ponderados) para não perder
+ *          precisão com incrementos pequenos. A persistência usa os dois últimos
+ *          setores da flash como um log circular de páginas: cada gravação ocupa
+ *          uma página nova e um setor só é apagado quando o log volta a ele.
+ */
+#include "noise_dose.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "modules/fmt/fmt.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DOSE_SHIFT_MS        ((uint32_t)DOSE_SHIFT_HOURS * 3600u * 1000u)
+#define DOSE_FIXED_ONE       65536.0f    ///< Escala do acumulador de ponto fixo.
+#define DOSE_FULL_ACC        ((uint64_t)DOSE_SHIFT_MS << 16) ///< Acumulado equivalente a 100%.
+
+#define DOSE_SLOTS           (HAL_STORAGE_SIZE / HAL_STORAGE_PAGE_SIZE)
+#define DOSE_SLOTS_PER_SECTOR (HAL_STORAGE_SECTOR_SIZE / HAL_STORAGE_PAGE_SIZE)
+#define DOSE_RECORD_MAGIC    0x45534F44u  // "DOSE"
+
+/**
+ * @brief Registro gravado no início de cada página do log.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    uint64_t dose_acc;
+    uint32_t exposure_ms;
+    uint32_t crc;
+} dose_record_t;
+
+static uint64_t dose_acc = 0;          ///< Dose acumulada em ms * 2^16 ponderados.
+static uint32_t exposure_ms = 0;       ///< Tempo de medição da jornada.
+static uint32_t sequence = 0;          ///< Sequência do último registro gravado.
+static uint32_t next_slot = 0;         ///< Próxima página do log a ser gravada.
+static uint32_t next_persist_ms;      ///< Instante (hal_time_ms) da próxima gravação.
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static const dose_record_t *slot_record(uint32_t slot) {
+    return (const dose_record_t *)hal_storage_read(slot * HAL_STORAGE_PAGE_SIZE);
+}
+
+static bool record_valid(const dose_record_t *r) {
+    return r->magic == DOSE_RECORD_MAGIC &&
+           r->crc == crc32((const uint8_t *)r, offsetof(dose_record_t, crc));
+}
+
+static void persist(void) {
+    static uint8_t page[HAL_STORAGE_PAGE_SIZE];
+    dose_record_t rec = {
+        .magic = DOSE_RECORD_MAGIC,
+        .sequence = sequence + 1,
+        .dose_acc = dose_acc,
+        .exposure_ms = exposure_ms,
+    };
+    rec.crc = crc32((const uint8_t *)&rec, offsetof(dose_record_t, crc));
+
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &rec, sizeof(rec));
+
+    // O setor só é apagado quando o log chega à sua primeira página.
+    if (!hal_storage_program_page(next_slot * HAL_STORAGE_PAGE_SIZE, page,
+                                  (next_slot % DOSE_SLOTS_PER_SECTOR) == 0)) {
+        printf("Dose: falha ao gravar na flash.\n");
+        return;
+    }
+    sequence = rec.sequence;
+    next_slot = (next_slot + 1) % DOSE_SLOTS;
+}
+
+void noise_dose_init(void) {
+    const dose_record_t *latest = NULL;
+    uint32_t latest_slot = 0;
+
+    for (uint32_t slot = 0; slot < DOSE_SLOTS; slot++) {
+        const dose_record_t *r = slot_record(slot);
+        if (record_valid(r) && (latest == NULL || (int32_t)(r->sequence - latest->sequence) > 0)) {
+            latest = r;
+            latest_slot = slot;
+        }
+    }
+
+    if (latest) {
+        dose_acc = latest->dose_acc;
+        exposure_ms = latest->exposure_ms;
+        sequence = latest->sequence;
+        next_slot = (latest_slot + 1) % DOSE_SLOTS;
+        char pct[24];
+        fmt_t f;
+        fmt_init(&f, pct, sizeof(pct));
+        fmt_fixed(&f, (int64_t)((dose_acc * 1000u + DOSE_FULL_ACC / 2) / DOSE_FULL_ACC), 1);  // Décimos de %.
+        printf("Dose: jornada restaurada (%s%%, %lu min).\n", pct, (unsigned long)(exposure_ms / 60000));
+    } else {
+        dose_acc = 0;
+        exposure_ms = 0;
+        sequence = 0;
+        next_slot = 0;
+    }
+    next_persist_ms = hal_time_ms() + DOSE_PERSIST_INTERVAL_MS;
+}
+
+void noise_dose_update(float la_spl_db, uint32_t dt_ms) {
+    exposure_ms += dt_ms;
+    if (la_spl_db < DOSE_THRESHOLD_DB) return;
+
+    float weight = exp2f((la_spl_db - DOSE_CRITERION_DB) / DOSE_EXCHANGE_RATE_DB);
+    dose_acc += (uint64_t)(dt_ms * DOSE_FIXED_ONE * weight);
+}
+
+void noise_dose_get_status(noise_dose_status_t *status) {
+    status->exposure_ms = exposure_ms;
+    status->dose_percent = (float)((double)dose_acc * 100.0 / DOSE_FULL_ACC);
+    status->projected_percent = exposure_ms ? status->dose_percent * ((float)DOSE_SHIFT_MS / exposure_ms) : 0.0f;
+
+    // Sem dose acumulada o TWA é indefinido; reporta-se o limiar de integração.
+    status->twa_db = status->dose_percent > 0.0f ?
+        DOSE_CRITERION_DB + DOSE_EXCHANGE_RATE_DB * log2f(status->dose_percent / 100.0f) : DOSE_THRESHOLD_DB;
+    status->projected_twa_db = status->projected_percent > 0.0f ?
+        DOSE_CRITERION_DB + DOSE_EXCHANGE_RATE_DB * log2f(status->projected_percent / 100.0f) : DOSE_THRESHOLD_DB;
+}
+
+void noise_dose_reset(void) {
+    dose_acc = 0;
+    exposure_ms = 0;
+    persist();
+    next_persist_ms = hal_time_ms() + DOSE_PERSIST_INTERVAL_MS;
+}
+
+bool noise_dose_service(noise_dose_status_t *report) {
+    if (exposure_ms >= DOSE_SHIFT_MS) {
+        noise_dose_get_status(report);
+        char pct[16], twa[16];
+        fmt_t f;
+        fmt_init(&f, pct, sizeof(pct));
+        fmt_float(&f, report->dose_percent, 1);
+        fmt_init(&f, twa, sizeof(twa));
+        fmt_float(&f, report->twa_db, 1);
+        printf("Dose: jornada encerrada com %s%% (TWA %s dB(A)).\n", pct, twa);
+        noise_dose_reset();
+        return true;
+    }
+    if ((int32_t)(hal_time_ms() - next_persist_ms) < 0) return false;
+
+    persist();
+    next_persist_ms = hal_time_ms() + DOSE_PERSIST_INTERVAL_MS;
+    noise_dose_get_status(report);
+    return true;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file noise_dose.h
+ * @brief Dosimetria de ruído ocupacional (dose e TWA, estilo NR-15 / OSHA).
+ * @details Acumula a dose de forma incremental a partir do nível com ponderação A
+ *          de cada quadro, com nível critério, fator de troca e nível limiar
+ *          configuráveis em config.h. O acumulado é gravado periodicamente na flash
+ *          (com nivelamento de desgaste) e restaurado após reinicializações.
+ *
+ * Fórmulas (q = fator de troca, Lc = nível critério, T = jornada de 8 h):
+ * - Dose (%) = 100 * sum(dt_i * 2^((L_i - Lc) / q)) / T, para L_i >= limiar.
+ * - TWA = Lc + q * log2(D / 100)  (equivalente a 16,61*log10(D/100) + 90 na OSHA).
+ * - TWA projetado = Lc + q * log2(D * T / (100 * t_exposição)).
+ */
+#ifndef NOISE_DOSE_H
+#define NOISE_DOSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Resumo da exposição da jornada corrente.
+ */
+typedef struct {
+    float dose_percent;        ///< Dose acumulada (% da dose diária permitida).
+    float projected_percent;   ///< Dose projetada para a jornada completa.
+    float twa_db;              ///< TWA de 8 h correspondente à dose acumulada.
+    float projected_twa_db;    ///< TWA de 8 h se o ritmo atual se mantiver.
+    uint32_t exposure_ms;      ///< Tempo de medição acumulado na jornada.
+} noise_dose_status_t;
+
+/**
+ * @brief Restaura o acumulado gravado na flash (ou inicia uma jornada nova).
+ */
+void noise_dose_init(void);
+
+/**
+ * @brief Acumula a contribuição de um registro de medição.
+ * @details Custo constante: uma exponenciação e uma soma inteira por quadro.
+ * @param la_spl_db Nível com ponderação A em dB SPL.
+ * @param dt_ms Duração do registro em ms.
+ */
+void noise_dose_update(float la_spl_db, uint32_t dt_ms);
+
+/**
+ * @brief Preenche o resumo da jornada corrente.
+ */
+void noise_dose_get_status(noise_dose_status_t *status);
+
+/**
+ * @brief Grava o acumulado na flash quando o intervalo de persistência expira e
+ *        encerra a jornada ao completar DOSE_SHIFT_HOURS de medição.
+ * @param report Resumo a ser publicado (preenchido antes de zerar uma jornada encerrada).
+ * @return true se `report` foi preenchido nesta chamada.
+ */
+bool noise_dose_service(noise_dose_status_t *report);
+
+/**
+ * @brief Zera a jornada corrente e grava o estado na flash.
+ */
+void noise_dose_reset(void);
+
+#endif
@@ -0,0 +1,160 @@
+/**
+ * @file profiler.c
+ * @brief Implementação dos histogramas de tempo de execução e de jitter.
+ */
+#include "profiler.h"
+
+#if PROFILING_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+#include "modules/adc_service/adc_service.h"
+#if !SMAIV_FREERTOS
+#include "modules/scheduler/scheduler.h"
+#endif
+
+/**
+ * @brief Estatísticas acumuladas de um probe.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint32_t over_budget;   ///< Medições acima do orçamento do probe.
+    uint64_t total_us;
+    uint32_t hist[PROF_HIST_BUCKETS];
+} prof_stats_t;
+
+/**
+ * @brief Descrição estática de um probe.
+ */
+typedef struct {
+    const char *name;
+    uint8_t core;           ///< Núcleo que escreve o probe.
+    uint32_t budget_us;     ///< Orçamento por execução (0 = sem orçamento).
+} prof_info_t;
+
+static const prof_info_t HAL_RAM_DATA(probe_info)[PROF_COUNT] = {
+    [PROF_MEASUREMENTS]  = { "medicoes",      0, 50000 },
+    [PROF_INPUT]         = { "entrada",       0, 20000 },
+    [PROF_ALERTS]        = { "alertas",       0, 50000 },
+    [PROF_UI_DRAW]       = { "ui_draw",       0, 100000 },
+    [PROF_DISPLAY_TX]    = { "display_tx",    0, 1000000 / UI_MAX_FPS },
+    [PROF_DOSE]          = { "dose",          0, 1000000 },
+    [PROF_MQTT_CB]       = { "mqtt_cb",       0, 5000 },
+    [PROF_CORE0_LATENCY] = { "latencia_core0", 0, 0 },
+    [PROF_DSP_BLOCK]     = { "dsp_bloco",     1, AUDIO_FRAME_MS * 1000 },
+    [PROF_DSP_JITTER]    = { "jitter_core1",  1, 0 },
+};
+
+static prof_stats_t stats[PROF_COUNT];
+static uint64_t window_start_us = 0;
+
+static inline uint32_t bucket_of(uint32_t us) {
+    if (us < 2) {
+        return 0;
+    }
+    uint32_t b = 31u - (uint32_t)__builtin_clz(us);
+    return b < PROF_HIST_BUCKETS ? b : PROF_HIST_BUCKETS - 1;
+}
+
+void HAL_RAM_FUNC(profiler_record)(prof_probe_t id, uint32_t us) {
+    prof_stats_t *s = &stats[id];
+    s->count++;
+    s->total_us += us;
+    if (us > s->max_us) s->max_us = us;
+    if (probe_info[id].budget_us && us > probe_info[id].budget_us) s->over_budget++;
+    s->hist[bucket_of(us)]++;
+}
+
+void HAL_RAM_FUNC(profiler_mark_period)(prof_probe_t id, uint32_t *last_us, uint32_t nominal_us) {
+    uint32_t now = hal_time_us_32();
+    if (*last_us != 0) {
+        int32_t dev = (int32_t)(now - *last_us - nominal_us);
+        profiler_record(id, (uint32_t)(dev < 0 ? -dev : dev));
+    }
+    *last_us = now;
+}
+
+void profiler_reset(void) {
+    memset(stats, 0, sizeof(stats));
+    hal_xip_stats_reset();
+    window_start_us = hal_time_us();
+}
+
+int profiler_format_summary(char *buf, size_t len) {
+    uint64_t elapsed = hal_time_us() - window_start_us;
+    uint32_t over = 0;
+    for (int i = 0; i < PROF_COUNT; i++) {
+        over += stats[i].over_budget;
+    }
+
+    // Core 1: tudo que não é processamento de bloco é espera pelo DMA.
+    uint32_t core1_busy_pm = elapsed ? (uint32_t)(stats[PROF_DSP_BLOCK].total_us * 1000u / elapsed) : 0;
+    if (core1_busy_pm > 1000) core1_busy_pm = 1000;
+    uint32_t core1_idle_pm = 1000 - core1_busy_pm;
+
+    adc_service_stats_t adc;
+    adc_service_get_stats(&adc);
+
+    // Acertos no cache do XIP por mil acessos (-1 sem XIP, como na simulação).
+    hal_xip_stats_t xip;
+    int xip_hit_pm = -1;
+    if (hal_xip_stats(&xip) && xip.accesses) {
+        xip_hit_pm = (int)((uint64_t)xip.hits * 1000u / xip.accesses);
+    }
+
+#if SMAIV_FREERTOS
+    // Sem estatísticas de execução do kernel: ociosidade do Core 0 indisponível (-1).
+    int core0_idle_pm = -1;
+    uint32_t sched_misses = 0;
+#else
+    sched_stats_t sched;
+    sched_get_stats(&sched);
+    int core0_idle_pm = sched.idle_permille;
+    uint32_t sched_misses = sched.deadline_misses;
+#endif
+
+    return snprintf(buf, len,
+                    "{\"uptime_s\":%lu, \"window_s\":%lu, \"core0_idle_pm\":%d, \"core1_idle_pm\":%lu, "
+                    "\"deadline_misses\":%lu, \"over_budget\":%lu, \"adc_dropped\":%lu, "
+                    "\"xip_hit_pm\":%d, \"xip_miss\":%lu}",
+                    (unsigned long)(hal_time_us() / 1000000u), (unsigned long)(elapsed / 1000000u),
+                    core0_idle_pm, (unsigned long)core1_idle_pm,
+                    (unsigned long)sched_misses, (unsigned long)over,
+                    (unsigned long)adc.dropped_samples,
+                    xip_hit_pm, (unsigned long)(xip.accesses - xip.hits));
+}
+
+int profiler_format_probe(prof_probe_t id, char *buf, size_t len) {
+    const prof_stats_t *s = &stats[id];
+    if (s->count == 0) {
+        return 0;
+    }
+
+    int n = snprintf(buf, len,
+                     "{\"probe\":\"%s\", \"core\":%u, \"n\":%lu, \"avg_us\":%lu, \"max_us\":%lu, \"over\":%lu, \"hist\":[",
+                     probe_info[id].name, probe_info[id].core, (unsigned long)s->count,
+                     (unsigned long)(s->total_us / s->count), (unsigned long)s->max_us,
+                     (unsigned long)s->over_budget);
+    for (int b = 0; b < PROF_HIST_BUCKETS && n > 0 && (size_t)n < len; b++) {
+        n += snprintf(buf + n, len - n, b ? ",%lu" : "%lu", (unsigned long)s->hist[b]);
+    }
+    if (n > 0 && (size_t)n < len) {
+        n += snprintf(buf + n, len - n, "]}");
+    }
+    return n;
+}
+
+void profiler_print(void) {
+    char line[PROFILER_LINE_MAX];
+
+    profiler_format_summary(line, sizeof(line));
+    printf("%s\n", line);
+    for (int i = 0; i < PROF_COUNT; i++) {
+        if (profiler_format_probe((prof_probe_t)i, line, sizeof(line)) > 0) {
+            printf("%s\n", line);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file recorder.c
+ * @brief Codificação dos registros e gravação do fluxo do Core 0.
+ */
+#include <string.h>
+#include "recorder.h"
+#include "hal/hal.h"
+
+_Static_assert(REC_FRAME_MAX <= HAL_RECORD_FRAME_MAX, "registro maior que o aceito pela HAL");
+
+// =================================================================================
+// CODIFICAÇÃO
+// =================================================================================
+
+static uint8_t *put_varint(uint8_t *p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+static uint8_t *put_float(uint8_t *p, float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    return put_u32(p, v);
+}
+
+size_t recorder_encode(const rec_record_t *r, uint32_t *clock_ms, uint8_t *out) {
+    uint8_t *p = out;
+    *p++ = r->type;
+    if (r->type == REC_HEADER) {
+        p = put_u32(p, r->time_ms);
+    } else {
+        p = put_varint(p, r->time_ms - *clock_ms);
+    }
+    *clock_ms = r->time_ms;
+
+    switch (r->type) {
+    case REC_HEADER:
+        p = put_u32(p, REC_MAGIC);
+        *p++ = r->header.version;
+        *p++ = r->header.feature_count;
+        *p++ = r->header.frame_ms;
+        break;
+    case REC_MEASUREMENT: {
+        const measurement_t *m = &r->measurement;
+        p = put_varint(p, r->time_ms - m->timestamp_ms);  // Atraso desde o fim do quadro.
+        p = put_float(p, m->rms_level);
+        p = put_float(p, m->event_level);
+        p = put_float(p, m->la_db);
+        *p++ = m->sound_class;
+        *p++ = (uint8_t)m->class_score;
+        memcpy(p, m->features, AUDIO_FEATURE_COUNT);
+        p += AUDIO_FEATURE_COUNT;
+        break;
+    }
+    case REC_INPUT:
+        *p++ = r->input.input;
+        *p++ = r->input.type;
+        p = put_varint(p, r->time_ms - r->input.time_ms);
+        p = put_varint(p, r->input.held_ms);
+        break;
+    case REC_DECISION:
+        *p++ = r->decision.kind;
+        *p++ = r->decision.arg;
+        break;
+    default:
+        break;
+    }
+    return (size_t)(p - out);
+}
+
+// =================================================================================
+// DECODIFICAÇÃO
+// =================================================================================
+
+/**
+ * @brief Cursor de leitura com verificação de limites.
+ */
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool ok;
+} rec_reader_t;
+
+static uint8_t get_u8(rec_reader_t *rd) {
+    if (rd->p >= rd->end) {
+        rd->ok = false;
+        return 0;
+    }
+    return *rd->p++;
+}
+
+static uint32_t get_u32(rec_reader_t *rd) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v |= (uint32_t)get_u8(rd) << (8 * i);
+    }
+    return v;
+}
+
+static uint32_t get_varint(rec_reader_t *rd) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t b = get_u8(rd);
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return v;
+        }
+    }
+    rd->ok = false;
+    return 0;
+}
+
+static float get_float(rec_reader_t *rd) {
+    uint32_t v = get_u32(rd);
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+bool recorder_decode(const uint8_t *frame, size_t len, uint32_t *clock_ms, rec_record_t *r) {
+    rec_reader_t rd = { frame, frame + len, true };
+    memset(r, 0, sizeof(*r));
+
+    r->type = get_u8(&rd);
+    r->time_ms = (r->type == REC_HEADER) ? get_u32(&rd) : *clock_ms + get_varint(&rd);
+
+    switch (r->type) {
+    case REC_HEADER:
+        if (get_u32(&rd) != REC_MAGIC) {
+            return false;
+        }
+        r->header.version = get_u8(&rd);
+        r->header.feature_count = get_u8(&rd);
+        r->header.frame_ms = get_u8(&rd);
+        break;
+    case REC_MEASUREMENT: {
+        measurement_t *m = &r->measurement;
+        m->timestamp_ms = r->time_ms - get_varint(&rd);
+        m->rms_level = get_float(&rd);
+        m->event_level = get_float(&rd);
+        m->la_db = get_float(&rd);
+        m->sound_class = get_u8(&rd);
+        m->class_score = (int8_t)get_u8(&rd);
+        for (int i = 0; i < AUDIO_FEATURE_COUNT; i++) {
+            m->features[i] = (int8_t)get_u8(&rd);
+        }
+        break;
+    }
+    case REC_BATCH_END:
+        break;
+    case REC_INPUT:
+        r->input.input = get_u8(&rd);
+        r->input.type = get_u8(&rd);
+        r->input.time_ms = r->time_ms - get_varint(&rd);
+        r->input.held_ms = get_varint(&rd);
+        break;
+    case REC_DECISION:
+        r->decision.kind = get_u8(&rd);
+        r->decision.arg = get_u8(&rd);
+        break;
+    default:
+        return false;
+    }
+    if (!rd.ok) {
+        return false;
+    }
+    *clock_ms = r->time_ms;
+    return true;
+}
+
+const char *recorder_decision_name(uint8_t kind) {
+    switch (kind) {
+    case REC_DEC_ALARM_ON:          return "alarme";
+    case REC_DEC_SILENCED:          return "silenciado";
+    case REC_DEC_REARMED:           return "rearmado";
+    case REC_DEC_EVENT_ESCALATED:   return "evento_escalado";
+    case REC_DEC_EVENT_IGNORED:     return "evento_ignorado";
+    default:                        return "?";
+    }
+}
+
+#if RECORDER_ENABLED
+// =================================================================================
+// GRAVAÇÃO (CORE 0)
+// =================================================================================
+
+static uint32_t clock_ms;           ///< Instante do último registro emitido.
+static bool batch_open = false;     ///< Medições gravadas desde o último REC_BATCH_END.
+
+static void emit(const rec_record_t *r) {
+    uint8_t frame[REC_FRAME_MAX];
+    size_t len = recorder_encode(r, &clock_ms, frame);
+    hal_record_write(frame, len);
+}
+
+void recorder_init(void) {
+    rec_record_t r = {
+        .type = REC_HEADER,
+        .time_ms = hal_time_ms(),
+        .header = { REC_VERSION, AUDIO_FEATURE_COUNT, AUDIO_FRAME_MS }
+    };
+    emit(&r);
+}
+
+void recorder_measurement(const measurement_t *m) {
+    rec_record_t r = { .type = REC_MEASUREMENT, .time_ms = hal_time_ms(), .measurement = *m };
+    emit(&r);
+    batch_open = true;
+}
+
+void recorder_batch_end(void) {
+    if (batch_open) {
+        rec_record_t r = { .type = REC_BATCH_END, .time_ms = hal_time_ms() };
+        emit(&r);
+        batch_open = false;
+    }
+}
+
+void recorder_input(const input_event_t *evt) {
+    rec_record_t r = { .type = REC_INPUT, .time_ms = hal_time_ms(), .input = *evt };
+    emit(&r);
+}
+
+void recorder_decision(rec_decision_t kind, uint8_t arg) {
+    rec_record_t r = { .type = REC_DECISION, .time_ms = hal_time_ms(), .decision = { kind, arg } };
+    emit(&r);
+}
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file recorder.h
+ * @brief Gravação determinística do que o Core 0 consome e decide, para reprodução.
+ * @details Com RECORDER_ENABLED, cada medição recebida do Core 1, cada evento de
+ *          entrada e cada decisão de alarme do main.c vira um registro binário
+ *          compacto, na ordem exata em que o Core 0 os tratou. O fim de cada lote
+ *          de medições também é registrado, para que a reprodução drene a fila nos
+ *          mesmos pontos que o dispositivo. O transporte é da HAL (hal_record_write):
+ *          no RP2040, linhas "REC <hex>" no USB; no host, um arquivo. A ferramenta smaiv_replay (host/) reinjeta as
+ *          medições e entradas no mesmo main.c em tempo virtual e compara as
+ *          decisões obtidas com as gravadas.
+ *
+ *          Formato de um registro: tipo (1 byte), instante (ms absolutos no
+ *          cabeçalho; diferença para o registro anterior em varint nos demais) e a
+ *          carga do tipo. Floats são gravados em IEEE 754 little-endian.
+ */
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "common.h"
+#include "config.h"
+#include "modules/input_events/input_debounce.h"
+
+#define REC_MAGIC           0x4C524D53u   ///< "SMRL" em little-endian.
+#define REC_VERSION         1
+#define REC_FRAME_MAX       (1 + 5 + 5 + 12 + 2 + AUDIO_FEATURE_COUNT)  ///< Maior registro codificado.
+
+/**
+ * @brief Tipos de registro.
+ */
+typedef enum {
+    REC_HEADER = 1,         ///< Início da gravação (versão e parâmetros do fluxo).
+    REC_MEASUREMENT,        ///< Medição consumida pelo Core 0.
+    REC_BATCH_END,          ///< Fim de um lote de medições drenado da fila.
+    REC_INPUT,              ///< Evento de entrada consumido pelo Core 0.
+    REC_DECISION            ///< Decisão tomada pelo main.c.
+} rec_type_t;
+
+/**
+ * @brief Decisões registradas (comparadas na reprodução).
+ */
+typedef enum {
+    REC_DEC_ALARM_ON = 1,       ///< Alarme local disparado.
+    REC_DEC_SILENCED,           ///< Alarme silenciado pelo usuário.
+    REC_DEC_REARMED,            ///< Fim do período de silêncio.
+    REC_DEC_EVENT_ESCALATED,    ///< Evento encerrado e enviado via MQTT (arg = classe).
+    REC_DEC_EVENT_IGNORED       ///< Evento encerrado e não escalado (arg = classe).
+} rec_decision_t;
+
+/**
+ * @brief Registro decodificado.
+ */
+typedef struct {
+    uint8_t type;               ///< rec_type_t.
+    uint32_t time_ms;           ///< Instante em que o Core 0 o tratou (ms desde o boot).
+    union {
+        struct {
+            uint8_t version;
+            uint8_t feature_count;
+            uint8_t frame_ms;
+        } header;
+        measurement_t measurement;
+        input_event_t input;
+        struct {
+            uint8_t kind;       ///< rec_decision_t.
+            uint8_t arg;
+        } decision;
+    };
+} rec_record_t;
+
+/**
+ * @brief Codifica um registro.
+ * @param clock_ms Instante do registro anterior; atualizado para r->time_ms.
+ * @param out Buffer de pelo menos REC_FRAME_MAX bytes.
+ * @return Bytes escritos.
+ */
+size_t recorder_encode(const rec_record_t *r, uint32_t *clock_ms, uint8_t *out);
+
+/**
+ * @brief Decodifica um registro completo.
+ * @param clock_ms Instante do registro anterior; atualizado para r->time_ms.
+ * @return false se o registro estiver truncado ou for de tipo desconhecido.
+ */
+bool recorder_decode(const uint8_t *frame, size_t len, uint32_t *clock_ms, rec_record_t *r);
+
+/**
+ * @brief Nome de uma decisão para relatórios.
+ */
+const char *recorder_decision_name(uint8_t kind);
+
+#if RECORDER_ENABLED
+/**
+ * @brief Emite o cabeçalho; deve preceder qualquer outro registro.
+ */
+void recorder_init(void);
+
+void recorder_measurement(const measurement_t *m);
+void recorder_batch_end(void);
+void recorder_input(const input_event_t *evt);
+void recorder_decision(rec_decision_t kind, uint8_t arg);
+
+#define REC_LOG_MEASUREMENT(m)      recorder_measurement(m)
+#define REC_LOG_BATCH_END()         recorder_batch_end()
+#define REC_LOG_INPUT(evt)          recorder_input(evt)
+#define REC_LOG_DECISION(kind, arg) recorder_decision((kind), (arg))
+
+#else
+
+#define REC_LOG_MEASUREMENT(m)      do { } while (0)
+#define REC_LOG_BATCH_END()         do { } while (0)
+#define REC_LOG_INPUT(evt)          do { } while (0)
+#define REC_LOG_DECISION(kind, arg) do { } while (0)
+
+#endif
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file scheduler.c
+ * @brief Implementação do escalonador cooperativo com roda de temporizadores.
+ */
+#include "scheduler.h"
+#include "config.h"
+#include "hal/hal.h"
+#include "modules/profiler/profiler.h"
+#include "modules/supervisor/supervisor.h"
+
+#define TICK_US        ((uint64_t)SCHED_TICK_MS * 1000u)
+#define NO_TASK        (-1)
+
+/**
+ * @brief Descritor interno de uma tarefa.
+ */
+typedef struct {
+    sched_task_fn_t fn;
+    void *ctx;
+    sched_event_fn_t pending;   ///< Fonte de eventos opcional.
+    uint32_t deadline_us;
+    uint32_t period_ticks;      ///< 0 = disparo único.
+    uint32_t expiry_tick;       ///< Tick de expiração do temporizador armado.
+    int8_t next_in_slot;        ///< Próxima tarefa na mesma posição da roda.
+    bool timer_armed;
+    volatile bool notified;     ///< Escrito por sched_notify (inclusive em ISR).
+    bool ready;
+    uint64_t release_us;        ///< Instante em que a tarefa ficou pronta.
+    sched_task_stats_t stats;
+} task_t;
+
+static task_t tasks[SCHED_MAX_TASKS];
+static uint8_t num_tasks = 0;
+
+/**
+ * @brief Roda de temporizadores: cada posição é uma lista encadeada de tarefas
+ *        cujo tick de expiração é congruente ao índice (módulo SCHED_WHEEL_SLOTS).
+ */
+static int8_t wheel[SCHED_WHEEL_SLOTS];
+static uint32_t current_tick = 0;   ///< Último tick processado.
+
+static uint64_t idle_us = 0;
+static uint64_t busy_us = 0;
+static uint64_t window_start_us = 0;
+static uint64_t window_idle_start_us = 0;
+static uint16_t idle_permille = 0;
+
+static inline uint32_t tick_of(uint64_t us) {
+    return (uint32_t)(us / TICK_US);
+}
+
+static inline bool valid_id(sched_task_id_t id) {
+    return id >= 0 && id < num_tasks;
+}
+
+static void wheel_insert(sched_task_id_t id) {
+    uint32_t slot = tasks[id].expiry_tick % SCHED_WHEEL_SLOTS;
+    tasks[id].next_in_slot = wheel[slot];
+    wheel[slot] = id;
+    tasks[id].timer_armed = true;
+}
+
+static void wheel_remove(sched_task_id_t id) {
+    int8_t *link = &wheel[tasks[id].expiry_tick % SCHED_WHEEL_SLOTS];
+    while (*link != NO_TASK) {
+        if (*link == id) {
+            *link = tasks[id].next_in_slot;
+            break;
+        }
+        link = &tasks[*link].next_in_slot;
+    }
+    tasks[id].timer_armed = false;
+}
+
+static void arm_timer(sched_task_id_t id, uint32_t delay_ms, uint32_t period_ms) {
+    if (tasks[id].timer_armed) {
+        wheel_remove(id);
+    }
+    uint32_t delay_ticks = (delay_ms + SCHED_TICK_MS - 1) / SCHED_TICK_MS;
+    tasks[id].period_ticks = period_ms / SCHED_TICK_MS;
+    tasks[id].expiry_tick = tick_of(hal_time_us()) + (delay_ticks ? delay_ticks : 1);
+    wheel_insert(id);
+}
+
+static void release(task_t *t, uint64_t when_us) {
+    if (!t->ready) {
+        t->ready = true;
+        t->release_us = when_us;
+    }
+}
+
+/**
+ * @brief Avança a roda até now_tick, liberando as tarefas cujos temporizadores expiraram.
+ * @details Após um atraso maior que uma volta completa, cada posição é visitada uma
+ *          única vez; a comparação por "expirou até agora" cobre os ticks pulados.
+ */
+static void advance_wheel(uint32_t now_tick) {
+    uint32_t steps = now_tick - current_tick;
+    if (steps > SCHED_WHEEL_SLOTS) {
+        steps = SCHED_WHEEL_SLOTS;
+    }
+
+    for (uint32_t k = 1; k <= steps; k++) {
+        sched_task_id_t rearm[SCHED_MAX_TASKS];
+        uint8_t num_rearm = 0;
+
+        int8_t *link = &wheel[(current_tick + k) % SCHED_WHEEL_SLOTS];
+        while (*link != NO_TASK) {
+            sched_task_id_t id = *link;
+            task_t *t = &tasks[id];
+            if ((int32_t)(now_tick - t->expiry_tick) < 0) {
+                link = &t->next_in_slot;   // Expira em uma volta futura.
+                continue;
+            }
+            *link = t->next_in_slot;
+            t->timer_armed = false;
+            release(t, (uint64_t)t->expiry_tick * TICK_US);
+
+            if (t->period_ticks) {
+                // Reagenda sem deriva; liberações perdidas não se acumulam.
+                t->expiry_tick += t->period_ticks;
+                if ((int32_t)(now_tick - t->expiry_tick) >= 0) {
+                    t->expiry_tick = now_tick + t->period_ticks;
+                }
+                rearm[num_rearm++] = id;
+            }
+        }
+        // Reinserção após percorrer a posição (o período pode cair nela mesma).
+        for (uint8_t i = 0; i < num_rearm; i++) {
+            wheel_insert(rearm[i]);
+        }
+    }
+    current_tick = now_tick;
+}
+
+/**
+ * @brief Executa uma tarefa e atualiza suas estatísticas e prazos.
+ */
+static void run_task(task_t *t) {
+    uint64_t start = hal_time_us();
+    uint32_t latency = (uint32_t)(start - t->release_us);
+
+    t->ready = false;
+    // Breadcrumb: se o núcleo travar, o próximo boot sabe qual tarefa executava.
+    supervisor_note_task((int8_t)(t - tasks));
+    t->fn(t->ctx);
+
+    uint64_t end = hal_time_us();
+    uint32_t run_us = (uint32_t)(end - start);
+
+    t->stats.runs++;
+    if (run_us > t->stats.max_run_us) t->stats.max_run_us = run_us;
+    if (latency > t->stats.max_latency_us) t->stats.max_latency_us = latency;
+    PROF_RECORD(PROF_CORE0_LATENCY, latency);
+    if (end - t->release_us > t->deadline_us) t->stats.deadline_misses++;
+    busy_us += run_us;
+}
+
+/**
+ * @brief Coleta liberações e executa a tarefa pronta de maior prioridade.
+ * @return true se alguma tarefa executou.
+ */
+static bool run_highest_ready(void) {
+    uint64_t now = hal_time_us();
+    advance_wheel(tick_of(now));
+
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        task_t *t = &tasks[i];
+        if (t->notified) {
+            t->notified = false;
+            release(t, now);
+        }
+        if (t->pending && t->pending()) {
+            release(t, now);
+        }
+    }
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        if (tasks[i].ready) {
+            run_task(&tasks[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Dorme até o próximo temporizador ou até um evento (IRQ ou SEV do Core 1).
+ * @details Uma interrupção ocorrida entre a verificação e o WFE deixa o registrador
+ *          de eventos sinalizado, de modo que o WFE retorna imediatamente.
+ */
+static void idle_until_next_timer(void) {
+    uint64_t now = hal_time_us();
+    uint32_t next_tick = current_tick + SCHED_WHEEL_SLOTS;
+
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        if (tasks[i].timer_armed && (int32_t)(tasks[i].expiry_tick - next_tick) < 0) {
+            next_tick = tasks[i].expiry_tick;
+        }
+    }
+
+    hal_wait_event_until((uint64_t)next_tick * TICK_US);
+    idle_us += hal_time_us() - now;
+}
+
+static void update_window(void) {
+    uint64_t now = hal_time_us();
+    uint64_t elapsed = now - window_start_us;
+    if (elapsed >= (uint64_t)SCHED_STATS_WINDOW_MS * 1000u) {
+        idle_permille = (uint16_t)((idle_us - window_idle_start_us) * 1000u / elapsed);
+        window_start_us = now;
+        window_idle_start_us = idle_us;
+    }
+}
+
+void sched_init(void) {
+    num_tasks = 0;
+    for (uint32_t i = 0; i < SCHED_WHEEL_SLOTS; i++) {
+        wheel[i] = NO_TASK;
+    }
+    current_tick = tick_of(hal_time_us());
+    window_start_us = hal_time_us();
+}
+
+sched_task_id_t sched_add_task(const char *name, sched_task_fn_t fn, void *ctx, uint32_t deadline_ms) {
+    if (num_tasks >= SCHED_MAX_TASKS) {
+        return SCHED_INVALID_TASK;
+    }
+    task_t *t = &tasks[num_tasks];
+    *t = (task_t){
+        .fn = fn,
+        .ctx = ctx,
+        .deadline_us = deadline_ms * 1000u,
+        .next_in_slot = NO_TASK,
+        .stats = { .name = name }
+    };
+    return (sched_task_id_t)num_tasks++;
+}
+
+void sched_set_period(sched_task_id_t id, uint32_t period_ms) {
+    if (!valid_id(id)) return;
+    if (period_ms == 0) {
+        if (tasks[id].timer_armed) wheel_remove(id);
+        return;
+    }
+    arm_timer(id, period_ms, period_ms);
+}
+
+void sched_start_oneshot(sched_task_id_t id, uint32_t delay_ms) {
+    if (!valid_id(id)) return;
+    arm_timer(id, delay_ms, 0);
+}
+
+void sched_set_event_source(sched_task_id_t id, sched_event_fn_t pending) {
+    if (!valid_id(id)) return;
+    tasks[id].pending = pending;
+}
+
+void sched_notify(sched_task_id_t id) {
+    if (!valid_id(id)) return;
+    tasks[id].notified = true;
+}
+
+void sched_run(void) {
+    while (true) {
+        if (!run_highest_ready()) {
+            idle_until_next_timer();
+        }
+        update_window();
+    }
+}
+
+void sched_get_stats(sched_stats_t *out) {
+    out->idle_us = idle_us;
+    out->busy_us = busy_us;
+    out->idle_permille = idle_permille;
+    out->deadline_misses = 0;
+    for (uint8_t i = 0; i < num_tasks; i++) {
+        out->deadline_misses += tasks[i].stats.deadline_misses;
+    }
+}
+
+bool sched_get_task_stats(sched_task_id_t id, sched_task_stats_t *out) {
+    if (!valid_id(id)) return false;
+    *out = tasks[id].stats;
+    return true;
+}
+
+uint8_t sched_task_count(void) {
+    return num_tasks;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file scheduler.h
+ * @brief Escalonador cooperativo do Core 0 com roda de temporizadores (timer wheel).
+ * @details Cada subsistema é registrado como uma tarefa que executa até o fim
+ *          (run-to-completion) e é liberada por:
+ *          - um temporizador periódico ou de disparo único (roda de SCHED_WHEEL_SLOTS
+ *            posições com resolução de SCHED_TICK_MS);
+ *          - uma fonte de eventos consultada a cada passo (ex.: fila de medições);
+ *          - uma notificação explícita (sched_notify, segura em interrupção).
+ *          Tarefas prontas executam em ordem de registro (prioridade). Sem nada pronto,
+ *          o núcleo dorme em WFE até o próximo temporizador ou evento, e esse tempo é
+ *          contabilizado como ocioso.
+ */
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef void (*sched_task_fn_t)(void *ctx);
+typedef bool (*sched_event_fn_t)(void);
+typedef int8_t sched_task_id_t;
+
+#define SCHED_INVALID_TASK (-1)
+
+/**
+ * @brief Estatísticas de uma tarefa.
+ */
+typedef struct {
+    const char *name;
+    uint32_t runs;              ///< Execuções desde o boot.
+    uint32_t deadline_misses;   ///< Execuções concluídas após o prazo.
+    uint32_t max_run_us;        ///< Maior tempo de execução observado.
+    uint32_t max_latency_us;    ///< Maior atraso entre liberação e início.
+} sched_task_stats_t;
+
+/**
+ * @brief Estatísticas globais do escalonador.
+ */
+typedef struct {
+    uint64_t idle_us;             ///< Tempo total dormindo desde o boot.
+    uint64_t busy_us;             ///< Tempo total executando tarefas desde o boot.
+    uint16_t idle_permille;       ///< Fração ociosa na última janela de SCHED_STATS_WINDOW_MS.
+    uint32_t deadline_misses;     ///< Soma das perdas de prazo de todas as tarefas.
+} sched_stats_t;
+
+/**
+ * @brief Inicializa o escalonador (antes de registrar tarefas).
+ */
+void sched_init(void);
+
+/**
+ * @brief Registra uma tarefa.
+ * @param name Nome (para estatísticas).
+ * @param fn Função da tarefa.
+ * @param ctx Contexto repassado à função.
+ * @param deadline_ms Prazo, a partir da liberação, para concluir a execução.
+ * @return Identificador ou SCHED_INVALID_TASK se a tabela estiver cheia.
+ */
+sched_task_id_t sched_add_task(const char *name, sched_task_fn_t fn, void *ctx, uint32_t deadline_ms);
+
+/**
+ * @brief Libera a tarefa a cada period_ms (0 cancela o temporizador).
+ */
+void sched_set_period(sched_task_id_t id, uint32_t period_ms);
+
+/**
+ * @brief Libera a tarefa uma única vez após delay_ms (substitui o temporizador atual).
+ */
+void sched_start_oneshot(sched_task_id_t id, uint32_t delay_ms);
+
+/**
+ * @brief Associa uma fonte de eventos: a tarefa fica pronta enquanto pending() retornar true.
+ */
+void sched_set_event_source(sched_task_id_t id, sched_event_fn_t pending);
+
+/**
+ * @brief Marca a tarefa como pronta (pode ser chamada de interrupções).
+ */
+void sched_notify(sched_task_id_t id);
+
+/**
+ * @brief Executa o escalonador indefinidamente.
+ */
+void sched_run(void);
+
+/**
+ * @brief Copia as estatísticas globais.
+ */
+void sched_get_stats(sched_stats_t *stats);
+
+/**
+ * @brief Copia as estatísticas de uma tarefa.
+ * @return false se o identificador for inválido.
+ */
+bool sched_get_task_stats(sched_task_id_t id, sched_task_stats_t *stats);
+
+/**
+ * @brief Número de tarefas registradas.
+ */
+uint8_t sched_task_count(void);
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file nn_int8.c
+ * @brief Implementação do runtime de inferência int8 (kernels dense e depthwise conv1d).
+ * @details Os kernels foram escritos para o Cortex-M0+: sem SIMD e sem instrução de
+ *          multiplicação 64 bits, o laço interno usa apenas MULS 32x32 com operandos
+ *          int8 e acumulação em int32, desenrolado de 4 em 4. A multiplicação 64 bits
+ *          da requantização ocorre uma única vez por saída.
+ */
+#include "nn_int8.h"
+#include "hal/hal.h"
+#include <string.h>
+
+// --- Leitura little-endian independente de alinhamento ---
+
+static inline uint16_t rd16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rd32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline int8_t clamp_int8(int32_t v) {
+    if (v > 127) return 127;
+    if (v < -128) return -128;
+    return (int8_t)v;
+}
+
+/**
+ * @brief Aplica requantização, zero-point e ativação a um acumulador.
+ */
+static inline int8_t finish_output(const nn_layer_t *l, int32_t acc) {
+    int32_t v = nn_requantize(acc, l->multiplier, l->shift);
+    // Limita antes de somar o zero-point, que estouraria um valor saturado em INT32.
+    if (v > 255) v = 255;
+    if (v < -256) v = -256;
+    v += l->out_zp;
+    if (l->activation == NN_ACT_RELU && v < l->out_zp) {
+        v = l->out_zp;
+    }
+    return clamp_int8(v);
+}
+
+/**
+ * @brief Camada densa: y[o] = bias[o] + sum_i x[i] * W[o][i].
+ */
+static void HAL_RAM_FUNC(kernel_dense)(const nn_layer_t *l, const int8_t *in, int8_t *out) {
+    const uint32_t n = (uint32_t)l->in_len * l->in_ch;
+    const int8_t *w = l->weights;
+
+    for (uint32_t o = 0; o < l->out_ch; ++o, w += n) {
+        int32_t acc = l->bias[o];
+        uint32_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            acc += in[i] * w[i];
+            acc += in[i + 1] * w[i + 1];
+            acc += in[i + 2] * w[i + 2];
+            acc += in[i + 3] * w[i + 3];
+        }
+        for (; i < n; ++i) {
+            acc += in[i] * w[i];
+        }
+        out[o] = finish_output(l, acc);
+    }
+}
+
+/**
+ * @brief Convolução 1D depthwise: tensores [tempo][canal], pesos [k][canal].
+ */
+static void HAL_RAM_FUNC(kernel_dwconv1d)(const nn_layer_t *l, const int8_t *in, int8_t *out) {
+    const uint32_t ch = l->in_ch;
+
+    for (uint32_t t = 0; t < l->out_len; ++t) {
+        const int8_t *x0 = in + (uint32_t)t * l->stride * ch;
+        for (uint32_t c = 0; c < ch; ++c) {
+            int32_t acc = l->bias[c];
+            const int8_t *x = x0 + c;
+            const int8_t *w = l->weights + c;
+            for (uint32_t k = 0; k < l->kernel; ++k, x += ch, w += ch) {
+                acc += *x * *w;
+            }
+            *out++ = finish_output(l, acc);
+        }
+    }
+}
+
+nn_status_t nn_model_load(nn_model_t *model, const uint8_t *blob, uint32_t len) {
+    memset(model, 0, sizeof(*model));
+    if (blob == NULL || len < NN_HEADER_SIZE || memcmp(blob, "SMNN", 4) != 0) return NN_ERR_FORMAT;
+    if (blob[4] != NN_MODEL_VERSION) return NN_ERR_FORMAT;
+    if (((uintptr_t)blob & 3) != 0) return NN_ERR_FORMAT;
+
+    model->num_layers = blob[5];
+    model->num_classes = blob[6];
+    model->input_zp = (int8_t)blob[7];
+    model->input_len = rd16(blob + 8);
+    model->input_ch = rd16(blob + 10);
+
+    if (model->num_layers == 0 || model->num_layers > NN_MAX_LAYERS) return NN_ERR_FORMAT;
+    if (len < NN_HEADER_SIZE + (uint32_t)model->num_layers * NN_LAYER_DESC_SIZE) return NN_ERR_FORMAT;
+
+    uint16_t cur_len = model->input_len;
+    uint16_t cur_ch = model->input_ch;
+    uint32_t max_intermediate = 0;
+
+    for (uint8_t i = 0; i < model->num_layers; ++i) {
+        const uint8_t *d = blob + NN_HEADER_SIZE + i * NN_LAYER_DESC_SIZE;
+        nn_layer_t *l = &model->layers[i];
+
+        l->type = d[0];
+        l->activation = d[1];
+        l->kernel = d[2];
+        l->stride = d[3];
+        l->in_len = rd16(d + 4);
+        l->in_ch = rd16(d + 6);
+        l->out_len = rd16(d + 8);
+        l->out_ch = rd16(d + 10);
+        l->out_zp = (int8_t)d[12];
+        l->shift = (int8_t)d[13];
+        l->multiplier = (int32_t)rd32(d + 16);
+        uint32_t w_off = rd32(d + 20);
+        uint32_t b_off = rd32(d + 24);
+
+        if (l->in_len != cur_len || l->in_ch != cur_ch) return NN_ERR_SHAPE;
+        if (l->shift < -30 || l->shift > 31) return NN_ERR_FORMAT;
+        if (l->activation > NN_ACT_RELU) return NN_ERR_FORMAT;
+
+        uint32_t w_count, b_count;
+        if (l->type == NN_LAYER_DENSE) {
+            if (l->out_len != 1) return NN_ERR_SHAPE;
+            w_count = (uint32_t)l->out_ch * l->in_len * l->in_ch;
+            b_count = l->out_ch;
+        } else if (l->type == NN_LAYER_DWCONV1D) {
+            if (l->kernel == 0 || l->stride == 0 || l->kernel > l->in_len) return NN_ERR_SHAPE;
+            if (l->out_ch != l->in_ch) return NN_ERR_SHAPE;
+            if (l->out_len != (l->in_len - l->kernel) / l->stride + 1) return NN_ERR_SHAPE;
+            w_count = (uint32_t)l->kernel * l->in_ch;
+            b_count = l->in_ch;
+        } else {
+            return NN_ERR_FORMAT;
+        }
+
+        if ((b_off & 3) != 0 || w_off > len || w_count > len - w_off ||
+            b_off > len || b_count * 4 > len - b_off) {
+            return NN_ERR_FORMAT;
+        }
+        l->weights = (const int8_t *)(blob + w_off);
+        l->bias = (const int32_t *)(blob + b_off);
+
+        cur_len = l->out_len;
+        cur_ch = l->out_ch;
+        uint32_t out_size = (uint32_t)cur_len * cur_ch;
+        if (i + 1 < model->num_layers && out_size > max_intermediate) {
+            max_intermediate = out_size;
+        }
+    }
+
+    if (cur_len != 1 || cur_ch != model->num_classes) return NN_ERR_SHAPE;
+
+    // Plano ping-pong: duas metades alinhadas, cada uma com o maior tensor intermediário.
+    model->arena_required = 2 * ((max_intermediate + 3) & ~3u);
+    return NN_OK;
+}
+
+nn_status_t HAL_RAM_FUNC(nn_model_invoke)(const nn_model_t *model, const int8_t *input,
+                            int8_t *arena, uint32_t arena_size, int8_t *output) {
+    if (arena_size < model->arena_required) return NN_ERR_ARENA;
+
+    const uint32_t half = model->arena_required / 2;
+    const int8_t *src = input;
+
+    for (uint8_t i = 0; i < model->num_layers; ++i) {
+        const nn_layer_t *l = &model->layers[i];
+        int8_t *dst = (i + 1 == model->num_layers) ? output : arena + (i & 1) * half;
+
+        if (l->type == NN_LAYER_DENSE) {
+            kernel_dense(l, src, dst);
+        } else {
+            kernel_dwconv1d(l, src, dst);
+        }
+        src = dst;
+    }
+    return NN_OK;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file nn_int8.h
+ * @brief Runtime mínimo de inferência int8 (sem malloc) para o classificador de eventos.
+ * @details O modelo é um blob binário armazenado na flash (ver formato abaixo) e
+ *          executado sobre uma arena estática fornecida pelo chamador. Todo o
+ *          cálculo é inteiro, portanto o resultado é idêntico no RP2040 e no host.
+ *
+ * ### Formato do blob (little-endian, alinhado em 4 bytes)
+ * | Offset | Tamanho | Campo                                   |
+ * |--------|---------|-----------------------------------------|
+ * | 0      | 4       | Assinatura "SMNN"                       |
+ * | 4      | 1       | Versão (NN_MODEL_VERSION)               |
+ * | 5      | 1       | Número de camadas                       |
+ * | 6      | 1       | Número de classes (saídas)              |
+ * | 7      | 1       | Zero-point da entrada (int8)            |
+ * | 8      | 2       | Comprimento temporal da entrada         |
+ * | 10     | 2       | Canais da entrada                       |
+ * | 12     | 4       | Reservado                               |
+ * | 16     | 32 * N  | Descritores de camada (nn_layer_t)      |
+ *
+ * Cada descritor de 32 bytes: tipo, ativação, kernel, stride (u8); in_len, in_ch,
+ * out_len, out_ch (u16); out_zp, shift (i8); reservado (u16); multiplier (i32);
+ * offset dos pesos (u32); offset do bias (u32, múltiplo de 4); reservado (u32).
+ *
+ * Os pesos são simétricos (zero-point 0) e o zero-point da entrada de cada camada
+ * já vem incorporado ao bias pela ferramenta de exportação, de modo que os kernels
+ * fazem apenas `acc = bias + sum(x * w)`.
+ */
+#ifndef NN_INT8_H
+#define NN_INT8_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define NN_MODEL_VERSION   1
+#define NN_MAX_LAYERS      8
+#define NN_HEADER_SIZE     16
+#define NN_LAYER_DESC_SIZE 32
+
+/**
+ * @brief Códigos de retorno do runtime.
+ */
+typedef enum {
+    NN_OK = 0,
+    NN_ERR_FORMAT = -1,   ///< Assinatura, versão ou offsets inválidos.
+    NN_ERR_SHAPE = -2,    ///< Dimensões inconsistentes entre camadas.
+    NN_ERR_ARENA = -3     ///< Arena insuficiente para o modelo.
+} nn_status_t;
+
+typedef enum {
+    NN_LAYER_DENSE = 1,    ///< Totalmente conectada (entrada achatada [len][ch]).
+    NN_LAYER_DWCONV1D = 2  ///< Convolução 1D depthwise ao longo do tempo (multiplicador 1).
+} nn_layer_type_t;
+
+typedef enum {
+    NN_ACT_NONE = 0,
+    NN_ACT_RELU = 1
+} nn_activation_t;
+
+/**
+ * @brief Descritor de camada já decodificado do blob.
+ */
+typedef struct {
+    uint8_t type;          ///< nn_layer_type_t.
+    uint8_t activation;    ///< nn_activation_t.
+    uint8_t kernel;        ///< Tamanho do kernel temporal (DWCONV1D).
+    uint8_t stride;        ///< Passo temporal (DWCONV1D).
+    uint16_t in_len;       ///< Comprimento temporal da entrada.
+    uint16_t in_ch;        ///< Canais da entrada.
+    uint16_t out_len;      ///< Comprimento temporal da saída.
+    uint16_t out_ch;       ///< Canais da saída.
+    int8_t out_zp;         ///< Zero-point da saída.
+    int8_t shift;          ///< Expoente extra da requantização (ver nn_requantize).
+    int32_t multiplier;    ///< Multiplicador Q31 da requantização.
+    const int8_t *weights; ///< Pesos na flash.
+    const int32_t *bias;   ///< Bias (int32) na flash.
+} nn_layer_t;
+
+/**
+ * @brief Modelo carregado: aponta diretamente para os dados na flash.
+ */
+typedef struct {
+    uint8_t num_layers;
+    uint8_t num_classes;
+    int8_t input_zp;
+    uint16_t input_len;
+    uint16_t input_ch;
+    uint32_t arena_required;   ///< Bytes de arena exigidos pelo plano ping-pong.
+    nn_layer_t layers[NN_MAX_LAYERS];
+} nn_model_t;
+
+/**
+ * @brief Requantiza um acumulador int32 para a escala da saída.
+ * @details Calcula round(acc * multiplier / 2^(31 + shift)) com arredondamento
+ *          "meio para cima", saturado na faixa do int32 (com shift negativo o
+ *          resultado pode passar de 32 bits). Executado uma vez por saída, fora do
+ *          laço de MACs.
+ */
+static inline int32_t nn_requantize(int32_t acc, int32_t multiplier, int8_t shift) {
+    int total = 31 + shift;
+    int64_t prod = (int64_t)acc * multiplier + ((int64_t)1 << (total - 1));
+    int64_t q = prod >> total;
+    if (q > INT32_MAX) return INT32_MAX;
+    if (q < INT32_MIN) return INT32_MIN;
+    return (int32_t)q;
+}
+
+/**
+ * @brief Decodifica e valida um blob de modelo.
+ * @param model Estrutura de saída.
+ * @param blob Ponteiro para o blob (alinhado em 4 bytes).
+ * @param len Tamanho do blob em bytes.
+ * @return NN_OK ou um código de erro negativo.
+ */
+nn_status_t nn_model_load(nn_model_t *model, const uint8_t *blob, uint32_t len);
+
+/**
+ * @brief Executa o modelo sobre uma entrada int8 [input_len][input_ch].
+ * @param model Modelo carregado.
+ * @param input Tensor de entrada.
+ * @param arena Arena de trabalho (alinhada em 4 bytes).
+ * @param arena_size Tamanho da arena.
+ * @param output Saída com num_classes valores int8.
+ * @return NN_OK ou NN_ERR_ARENA.
+ */
+nn_status_t nn_model_invoke(const nn_model_t *model, const int8_t *input,
+                            int8_t *arena, uint32_t arena_size, int8_t *output);
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file sound_classifier.c
+ * @brief Classificador de eventos sonoros embarcado (executado no Core 1).
+ * @details Mantém uma janela deslizante dos últimos quadros de características e,
+ *          a cada SOUND_CLASSIFIER_HOP_FRAMES quadros, executa o modelo int8 lido da
+ *          flash. Toda a memória é estática: janela, tensor de entrada e arena.
+ *
+ *          O modelo é fornecido pelo símbolo `sound_model_blob`, gerado por
+ *          `tools/pack_sound_model.py` e adicionado ao build via a opção CMake
+ *          `SMAIV_SOUND_MODEL`. Sem ele, as definições fracas de sound_model_default.c
+ *          deixam o classificador desativado.
+ */
+#include "sound_classifier.h"
+#include "config.h"
+#include "nn_int8.h"
+#include "hal/hal.h"
+#include "modules/audio_processing/audio_features.h"
+#include <stdio.h>
+#include <string.h>
+
+// Definidos pelo arquivo gerado ou, sem modelo, por sound_model_default.c. Ficam em
+// outra unidade de compilação para que o compilador não propague o tamanho zero.
+extern const uint8_t sound_model_blob[];
+extern const uint32_t sound_model_blob_size;
+
+static nn_model_t model;
+static bool model_ready = false;
+
+/**
+ * @brief Janela circular de quadros quantizados e contadores associados.
+ */
+static int8_t window[SOUND_CLASSIFIER_MAX_FRAMES][AUDIO_FEATURE_COUNT];
+static uint32_t window_head = 0;   ///< Próxima posição de escrita.
+static uint32_t window_count = 0;  ///< Quadros válidos na janela.
+
+static int8_t input_tensor[SOUND_CLASSIFIER_MAX_FRAMES * AUDIO_FEATURE_COUNT];
+static int8_t arena[SOUND_CLASSIFIER_ARENA_SIZE] __attribute__((aligned(4)));
+static int8_t logits[SOUND_CLASS_COUNT];
+#if SMAIV_RAM_HOT_PATH
+static uint8_t model_ram[SOUND_CLASSIFIER_MODEL_RAM_SIZE] __attribute__((aligned(4)));  ///< Cópia do modelo fora do XIP.
+#endif
+
+static const char *const class_names[SOUND_CLASS_COUNT] = {
+    [SOUND_CLASS_SPEECH]    = "speech",
+    [SOUND_CLASS_MUSIC]     = "music",
+    [SOUND_CLASS_ALARM]     = "alarm",
+    [SOUND_CLASS_IMPACT]    = "impact",
+    [SOUND_CLASS_MACHINERY] = "machinery",
+    [SOUND_CLASS_GLASS]     = "glass",
+};
+
+bool sound_classifier_init(void) {
+    model_ready = false;
+    window_head = 0;
+    window_count = 0;
+
+    if (sound_model_blob_size == 0) {
+        printf("Classificador: nenhum modelo embarcado, todos os eventos serao escalados.\n");
+        return false;
+    }
+
+    // Os pesos são lidos a cada inferência: na SRAM não disputam o cache do XIP.
+    const uint8_t *blob = sound_model_blob;
+#if SMAIV_RAM_HOT_PATH
+    if (sound_model_blob_size <= sizeof(model_ram)) {
+        memcpy(model_ram, sound_model_blob, sound_model_blob_size);
+        blob = model_ram;
+    }
+#endif
+    nn_status_t status = nn_model_load(&model, blob, sound_model_blob_size);
+    if (status != NN_OK) {
+        printf("Classificador: modelo invalido (erro %d).\n", status);
+        return false;
+    }
+    if (model.input_ch != AUDIO_FEATURE_COUNT || model.input_len > SOUND_CLASSIFIER_MAX_FRAMES ||
+        model.num_classes != SOUND_CLASS_COUNT) {
+        printf("Classificador: modelo incompativel com as caracteristicas do firmware.\n");
+        return false;
+    }
+    if (model.arena_required > sizeof(arena)) {
+        printf("Classificador: arena insuficiente (%lu > %u bytes).\n",
+               (unsigned long)model.arena_required, (unsigned)sizeof(arena));
+        return false;
+    }
+
+    model_ready = true;
+    printf("Classificador: modelo carregado (%u camadas, arena %lu bytes, pesos na %s).\n",
+           model.num_layers, (unsigned long)model.arena_required,
+           blob == sound_model_blob ? "flash" : "SRAM");
+    return true;
+}
+
+bool sound_classifier_ready(void) {
+    return model_ready;
+}
+
+void HAL_RAM_FUNC(sound_classifier_push_frame)(const int8_t *features) {
+    memcpy(window[window_head], features, AUDIO_FEATURE_COUNT);
+    window_head = (window_head + 1) % SOUND_CLASSIFIER_MAX_FRAMES;
+    if (window_count < SOUND_CLASSIFIER_MAX_FRAMES) window_count++;
+}
+
+bool HAL_RAM_FUNC(sound_classifier_run)(uint8_t *sound_class, int8_t *score) {
+    if (!model_ready || window_count < model.input_len) return false;
+
+    // Lineariza os últimos input_len quadros, do mais antigo para o mais recente.
+    uint32_t idx = (window_head + SOUND_CLASSIFIER_MAX_FRAMES - model.input_len) % SOUND_CLASSIFIER_MAX_FRAMES;
+    int8_t *dst = input_tensor;
+    for (uint32_t t = 0; t < model.input_len; t++) {
+        memcpy(dst, window[idx], AUDIO_FEATURE_COUNT);
+        dst += AUDIO_FEATURE_COUNT;
+        idx = (idx + 1) % SOUND_CLASSIFIER_MAX_FRAMES;
+    }
+
+    if (nn_model_invoke(&model, input_tensor, arena, sizeof(arena), logits) != NN_OK) return false;
+
+    uint8_t best = 0;
+    for (uint8_t c = 1; c < SOUND_CLASS_COUNT; c++) {
+        if (logits[c] > logits[best]) best = c;
+    }
+    *sound_class = best;
+    *score = logits[best];
+    return true;
+}
+
+bool sound_classifier_should_escalate(uint8_t sound_class) {
+    if (!model_ready || sound_class >= SOUND_CLASS_COUNT) return true;
+    return (SOUND_CLASS_ESCALATE_MASK & (1u << sound_class)) != 0;
+}
+
+const char *sound_class_name(uint8_t sound_class) {
+    return (sound_class < SOUND_CLASS_COUNT) ? class_names[sound_class] : "unknown";
+}
@@ -0,0 +1,53 @@
+/**
+ * @file sound_classifier.h
+ * @brief Interface do classificador de eventos sonoros (modelo int8, Core 1).
+ * @details Os quadros de características quantizadas entram em uma janela deslizante
+ *          e a inferência roda sobre ela a cada SOUND_CLASSIFIER_HOP_FRAMES quadros.
+ *          Sem modelo no build, o classificador fica desativado e todo evento acima do
+ *          limiar continua sendo escalado.
+ */
+#ifndef SOUND_CLASSIFIER_H
+#define SOUND_CLASSIFIER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "common.h"
+
+/**
+ * @brief Carrega o modelo da flash e valida-o contra as características e a arena.
+ * @return true se o classificador estiver pronto para uso.
+ */
+bool sound_classifier_init(void);
+
+/**
+ * @brief Indica se há um modelo válido carregado.
+ */
+bool sound_classifier_ready(void);
+
+/**
+ * @brief Adiciona um quadro de características quantizadas à janela deslizante.
+ * @param features Vetor com AUDIO_FEATURE_COUNT valores int8.
+ */
+void sound_classifier_push_frame(const int8_t *features);
+
+/**
+ * @brief Executa a inferência sobre a janela atual.
+ * @param sound_class Saída: classe vencedora (sound_class_t).
+ * @param score Saída: logit quantizado da classe vencedora.
+ * @return false se não houver modelo ou a janela ainda estiver incompleta.
+ */
+bool sound_classifier_run(uint8_t *sound_class, int8_t *score);
+
+/**
+ * @brief Decide se um evento da classe informada deve ser escalado (alerta remoto).
+ * @details Sem modelo carregado ou sem classificação, retorna sempre true para
+ *          preservar o comportamento de alertar todo evento acima do limiar.
+ */
+bool sound_classifier_should_escalate(uint8_t sound_class);
+
+/**
+ * @brief Retorna o nome textual de uma classe (para logs e payloads).
+ */
+const char *sound_class_name(uint8_t sound_class);
+
+#endif
@@ -0,0 +1,12 @@
+/**
+ * @file sound_model_default.c
+ * @brief Modelo vazio do classificador (definições fracas).
+ * @details Substituídas pelo arquivo gerado por tools/pack_sound_model.py quando a
+ *          opção CMake SMAIV_SOUND_MODEL é usada. Precisam ficar fora de
+ *          sound_classifier.c: um `const` fraco inicializado na mesma unidade é
+ *          propagado como constante pelo GCC, e o modelo real nunca seria lido.
+ */
+#include <stdint.h>
+
+__attribute__((weak, aligned(4))) const uint8_t sound_model_blob[4] = {0};
+__attribute__((weak)) const uint32_t sound_model_blob_size = 0;
@@ -0,0 +1,136 @@
+/**
+ * @file supervisor.c
+ * @brief Implementação do supervisor do watchdog e dos breadcrumbs de falha.
+ */
+#include <stdio.h>
+#include "supervisor.h"
+#include "config.h"
+#include "hal/hal.h"
+
+// --- Layout dos breadcrumbs nos registradores de scratch ---
+// scratch[0]: SUP_MAGIC (16 bits altos) | motivo (8 bits) | cliente em falta (8 bits)
+// scratch[1]: última tarefa despachada no Core 0 (+1; 0 = desconhecida)
+// scratch[2]: contador de laço do Core 0
+// scratch[3]: tempo de operação em segundos
+#define SUP_MAGIC           0x5A1D0000u
+#define SUP_MAGIC_MASK      0xFFFF0000u
+#define CRUMB_REASON        0
+#define CRUMB_TASK          1
+#define CRUMB_LOOP          2
+#define CRUMB_UPTIME        3
+
+/**
+ * @brief Cliente supervisionado.
+ */
+typedef struct {
+    const char *name;
+    uint32_t timeout_ms;
+    volatile uint32_t last_ms;  ///< Último check-in (escrita atômica de 32 bits).
+} sup_entry_t;
+
+static sup_entry_t clients[SUP_MAX_CLIENTS];
+static uint8_t num_clients = 0;
+static bool started = false;
+static bool faulted = false;
+static uint32_t loop_count = 0;
+static sup_reset_info_t last_reset;
+
+static void write_reason(uint8_t cause, int8_t client) {
+    hal_watchdog_scratch_set(CRUMB_REASON, SUP_MAGIC | ((uint32_t)cause << 8) | (uint8_t)client);
+}
+
+void supervisor_init(void) {
+    uint32_t reason = hal_watchdog_scratch_get(CRUMB_REASON);
+
+    last_reset = (sup_reset_info_t){ .cause = SUP_RESET_POWER_ON, .client = -1, .last_task = -1 };
+    if (hal_watchdog_caused_reboot()) {
+        last_reset.cause = SUP_RESET_WATCHDOG_HANG;
+        if ((reason & SUP_MAGIC_MASK) == SUP_MAGIC) {
+            last_reset.cause = (uint8_t)(reason >> 8);
+            last_reset.client = (int8_t)(reason & 0xFF);
+            last_reset.last_task = (int8_t)(hal_watchdog_scratch_get(CRUMB_TASK) - 1);
+            last_reset.loop_count = hal_watchdog_scratch_get(CRUMB_LOOP);
+            last_reset.uptime_s = hal_watchdog_scratch_get(CRUMB_UPTIME);
+        }
+    }
+
+    for (uint8_t i = 0; i < HAL_WATCHDOG_SCRATCH_COUNT; i++) {
+        hal_watchdog_scratch_set(i, 0);
+    }
+}
+
+void supervisor_start(void) {
+    uint32_t now = hal_time_ms();
+    for (uint8_t i = 0; i < num_clients; i++) {
+        clients[i].last_ms = now;
+    }
+    // Enquanto nada for detectado, um reset pelo watchdog significa Core 0 travado.
+    write_reason(SUP_RESET_WATCHDOG_HANG, -1);
+    hal_watchdog_enable(SUP_WATCHDOG_MS);
+    started = true;
+}
+
+sup_client_t supervisor_register(const char *name, uint32_t timeout_ms) {
+    if (num_clients >= SUP_MAX_CLIENTS) {
+        return SUP_INVALID_CLIENT;
+    }
+    clients[num_clients] = (sup_entry_t){ .name = name, .timeout_ms = timeout_ms, .last_ms = hal_time_ms() };
+    return (sup_client_t)num_clients++;
+}
+
+void supervisor_checkin(sup_client_t id) {
+    if (id >= 0 && id < num_clients) {
+        clients[id].last_ms = hal_time_ms();
+    }
+}
+
+void supervisor_note_task(int8_t task) {
+    hal_watchdog_scratch_set(CRUMB_TASK, (uint32_t)(task + 1));
+    hal_watchdog_scratch_set(CRUMB_LOOP, ++loop_count);
+}
+
+bool supervisor_service(void) {
+    if (!started || faulted) {
+        return !faulted;
+    }
+
+    uint32_t now = hal_time_ms();
+    hal_watchdog_scratch_set(CRUMB_UPTIME, now / 1000u);
+
+    for (uint8_t i = 0; i < num_clients; i++) {
+        if (now - clients[i].last_ms > clients[i].timeout_ms) {
+            // Registra a causa e deixa o watchdog expirar.
+            write_reason(SUP_RESET_TASK_TIMEOUT, (int8_t)i);
+            faulted = true;
+            printf("SUPERVISOR: '%s' sem heartbeat ha %lu ms. Reiniciando em %u ms.\n",
+                   clients[i].name, (unsigned long)(now - clients[i].last_ms), SUP_WATCHDOG_MS);
+            return false;
+        }
+    }
+    hal_watchdog_feed();
+    return true;
+}
+
+void supervisor_reboot(void) {
+    write_reason(SUP_RESET_REQUESTED, -1);
+    hal_watchdog_scratch_set(CRUMB_UPTIME, hal_time_ms() / 1000u);
+    hal_reboot();
+}
+
+const sup_reset_info_t *supervisor_last_reset(void) {
+    return &last_reset;
+}
+
+const char *supervisor_client_name(sup_client_t id) {
+    return (id >= 0 && id < num_clients) ? clients[id].name : "-";
+}
+
+const char *supervisor_cause_name(uint8_t cause) {
+    switch (cause) {
+    case SUP_RESET_POWER_ON:      return "power_on";
+    case SUP_RESET_WATCHDOG_HANG: return "watchdog";
+    case SUP_RESET_TASK_TIMEOUT:  return "task_timeout";
+    case SUP_RESET_REQUESTED:     return "requested";
+    default:                      return "unknown";
+    }
+}
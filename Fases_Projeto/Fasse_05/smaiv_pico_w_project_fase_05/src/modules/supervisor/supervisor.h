@@ -0,0 +1,90 @@
+/**
+ * @file supervisor.h
+ * @brief Supervisor do watchdog com heartbeats por tarefa e breadcrumbs de falha.
+ * @details Cada cliente registrado (tarefas dos dois núcleos, pilha LwIP) deve fazer
+ *          check-in dentro do seu prazo; o watchdog do RP2040 só é alimentado enquanto
+ *          todos estiverem em dia. Os registradores de scratch 0-3 do watchdog (os
+ *          4-7 são usados pela SDK) guardam o motivo, o cliente em falta, a última
+ *          tarefa despachada no Core 0 e um contador de laço, de modo que a causa do
+ *          reset sobreviva à reinicialização e seja publicada no boot seguinte.
+ */
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int8_t sup_client_t;
+
+#define SUP_INVALID_CLIENT (-1)
+
+/**
+ * @brief Causas de reinicialização reconhecidas.
+ */
+typedef enum {
+    SUP_RESET_POWER_ON = 0,     ///< Energização ou botão de reset.
+    SUP_RESET_WATCHDOG_HANG,    ///< Watchdog expirou sem o supervisor detectar (Core 0 travado).
+    SUP_RESET_TASK_TIMEOUT,     ///< Um cliente deixou de fazer check-in.
+    SUP_RESET_REQUESTED         ///< Reinicialização solicitada (console).
+} sup_reset_cause_t;
+
+/**
+ * @brief Informações da reinicialização anterior, recuperadas dos breadcrumbs.
+ */
+typedef struct {
+    uint8_t cause;          ///< sup_reset_cause_t.
+    int8_t client;          ///< Cliente em falta (TASK_TIMEOUT) ou -1.
+    int8_t last_task;       ///< Última tarefa despachada no Core 0 ou -1.
+    uint32_t loop_count;    ///< Contador de laço do Core 0 no momento da falha.
+    uint32_t uptime_s;      ///< Tempo de operação até a falha.
+} sup_reset_info_t;
+
+/**
+ * @brief Lê e limpa os breadcrumbs da execução anterior (primeira chamada no boot).
+ */
+void supervisor_init(void);
+
+/**
+ * @brief Habilita o watchdog (após as inicializações bloqueantes, como o Wi-Fi).
+ */
+void supervisor_start(void);
+
+/**
+ * @brief Registra um cliente supervisionado.
+ * @param name Nome (literal) usado nos relatórios.
+ * @param timeout_ms Prazo máximo entre check-ins.
+ * @return Identificador ou SUP_INVALID_CLIENT se a tabela estiver cheia.
+ */
+sup_client_t supervisor_register(const char *name, uint32_t timeout_ms);
+
+/**
+ * @brief Heartbeat de um cliente (pode ser chamado de qualquer núcleo).
+ */
+void supervisor_checkin(sup_client_t id);
+
+/**
+ * @brief Breadcrumb: tarefa do Core 0 prestes a executar (-1 = desconhecida).
+ * @details Também incrementa o contador de laço. Custa duas escritas em registrador.
+ */
+void supervisor_note_task(int8_t task);
+
+/**
+ * @brief Verifica os clientes e alimenta o watchdog se todos estiverem em dia.
+ * @return false se algum cliente expirou (o watchdog deixa de ser alimentado).
+ */
+bool supervisor_service(void);
+
+/**
+ * @brief Grava o breadcrumb de reinicialização solicitada e reinicia o sistema.
+ */
+void supervisor_reboot(void);
+
+/**
+ * @brief Informações da reinicialização anterior.
+ */
+const sup_reset_info_t *supervisor_last_reset(void);
+
+const char *supervisor_client_name(sup_client_t id);
+const char *supervisor_cause_name(uint8_t cause);
+
+#endif
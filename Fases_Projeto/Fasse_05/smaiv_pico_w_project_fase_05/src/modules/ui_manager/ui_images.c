@@ -0,0 +1,16 @@
+/* Gerado por tools/pack_image.py - nao editar. */
+#include <stdint.h>
+
+/* alert.pbm: 16x16 */
+const uint8_t img_alert[34] = {
+    16, 16,
+    0x00, 0x00, 0x00, 0x00, 0xc0, 0x30, 0x0c, 0xf7, 0xf7, 0x0c, 0x30, 0xc0, 0x00, 0x00, 0x00, 0x00,
+    0xc0, 0xf0, 0xcc, 0xc3, 0xc0, 0xc0, 0xc0, 0xdb, 0xdb, 0xc0, 0xc0, 0xc0, 0xc3, 0xcc, 0xf0, 0xc0,
+};
+
+/* speaker.pbm: 16x16 */
+const uint8_t img_speaker[34] = {
+    16, 16,
+    0xe0, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0x1e, 0xe0, 0x00, 0x08, 0x30, 0xc0, 0x04, 0x08, 0x70, 0x80,
+    0x07, 0x07, 0x07, 0x0f, 0x1f, 0x3f, 0x78, 0x07, 0x00, 0x10, 0x0c, 0x03, 0x20, 0x10, 0x0e, 0x01,
+};
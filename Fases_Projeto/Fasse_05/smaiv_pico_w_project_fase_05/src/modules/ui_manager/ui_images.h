@@ -0,0 +1,17 @@
+/**
+ * @file ui_images.h
+ * @brief Ícones da UI no formato de páginas do SSD1306 (ssd1306_draw_image()).
+ * @details ui_images.c é gerado a partir de assets/icons/ com:
+ *          @code
+ *          python3 tools/pack_image.py assets/icons/alert.pbm assets/icons/speaker.pbm -o src/modules/ui_manager/ui_images.c
+ *          @endcode
+ */
+#ifndef UI_IMAGES_H
+#define UI_IMAGES_H
+
+#include <stdint.h>
+
+extern const uint8_t img_alert[];      ///< Triângulo de alerta, 16x16.
+extern const uint8_t img_speaker[];    ///< Alto-falante, 16x16 (tela de inicialização).
+
+#endif
@@ -2,14 +2,17 @@
  * @file ui_manager.c
  * @brief Implementação do módulo de Interface com o Usuário (UI).
  * @details Gerencia o display OLED, a leitura de botões/joystick e a navegação
- *          entre as telas de monitoramento e configuração.
+ *          entre as telas de monitoramento, histórico e configuração.
  */
 #include "ui_manager.h"
+#include "ui_images.h"
 #include "config.h"
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
-#include "hardware/adc.h"
+#include "hal/hal.h"
+#include "modules/fmt/fmt.h"
+#include "modules/profiler/profiler.h"
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 
 #include "ssd1306/ssd1306.h"
 
@@ -19,49 +22,195 @@
  */
 static ssd1306_t disp;
 
+// Geometria da tela de histórico: cabeçalho na página 0, gráfico nas páginas 1-5 e
+// barras das bandas nas páginas 6-7.
+#define GRAPH_COLUMNS       128                     ///< Colunas do histórico (largura do display).
+#define GRAPH_FIRST_PAGE    1
+#define GRAPH_LAST_PAGE     5
+#define GRAPH_BOTTOM_Y      ((GRAPH_LAST_PAGE + 1) * 8)
+#define GRAPH_HEIGHT        ((GRAPH_LAST_PAGE - GRAPH_FIRST_PAGE + 1) * 8)
+#define BARS_TOP_Y          GRAPH_BOTTOM_Y
+#define BARS_HEIGHT         (64 - BARS_TOP_Y)
+#define BAR_PITCH           (128 / AUDIO_NUM_BANDS)
+#define LEVEL_FULL_SCALE    128     ///< Topo do gráfico e das barras: 64 dB (unidades de 0,5 dB).
+
+/**
+ * @brief Histórico do nível: uma coluna (pico do intervalo, em 0,5 dB) por
+ *        UI_HISTORY_COLUMN_MS, em anel.
+ */
+static struct {
+    uint8_t columns[GRAPH_COLUMNS];
+    uint8_t head;           ///< Próxima coluna a escrever (a mais antiga).
+    uint32_t seq;           ///< Colunas concluídas desde o boot.
+    uint8_t peak;           ///< Pico da coluna em formação.
+    uint32_t column_start_ms;
+    uint8_t bands[AUDIO_NUM_BANDS]; ///< Última medição das bandas (0,5 dB).
+    uint8_t level;          ///< Última medição do nível (0,5 dB).
+} history;
+
+/**
+ * @brief Modelo compacto do que está na tela: apenas os valores visíveis, já
+ *        arredondados como são impressos. Campos que a tela ativa não mostra ficam zerados.
+ */
+typedef struct {
+    uint8_t screen;         ///< screen_t.
+    uint8_t alert;          ///< Alerta exibido (tela principal).
+    uint8_t mqtt;           ///< Status MQTT exibido (tela principal sem alerta).
+    int16_t level;          ///< Nível exibido (tela principal; dB na tela de histórico).
+    int16_t threshold;      ///< Limiar exibido.
+    uint32_t history_seq;   ///< Colunas do histórico já exibidas (tela de histórico).
+    uint8_t bars[AUDIO_NUM_BANDS]; ///< Altura das barras em pixels (tela de histórico).
+} ui_view_t;
+
+static ui_view_t last_view;         ///< Último modelo enviado ao display.
+static bool last_view_valid;        ///< false até o primeiro quadro (a tela mostra o splash).
+static uint32_t last_frame_ms;      ///< Instante do último quadro enviado.
+static uint32_t graph_seq;          ///< Colunas do histórico presentes no framebuffer.
+static bool tx_pending;             ///< Quadro enviado cujo tempo de barramento ainda não foi lido.
+static ui_stats_t stats;
+
 /**
  * @brief Inicializa os periféricos da UI e exibe a tela de inicialização (splash screen).
  */
 void ui_init(void) {
-    // Configura o barramento I2C e os pinos para o display OLED.
-    i2c_init(OLED_I2C_PORT, 400 * 1000);
-    gpio_set_function(OLED_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(OLED_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(OLED_SDA_PIN);
-    gpio_pull_up(OLED_SCL_PIN);
+    // Configura o barramento I2C e os pinos para o display OLED. Acima de 400 kHz
+    // (Fast-mode Plus) nem todo painel responde: sem ACK, volta ao Fast-mode.
+    hal_i2c_t *i2c = hal_i2c_init(OLED_I2C_BUS, OLED_SDA_PIN, OLED_SCL_PIN, OLED_I2C_HZ);
+    stats.i2c_hz = OLED_I2C_HZ;
+    if (OLED_I2C_HZ > OLED_I2C_FALLBACK_HZ && !ssd1306_probe(i2c, OLED_I2C_ADDR)) {
+        printf("UI: display sem resposta a %lu kHz; usando %lu kHz.\n",
+               (unsigned long)(OLED_I2C_HZ / 1000), (unsigned long)(OLED_I2C_FALLBACK_HZ / 1000));
+        i2c = hal_i2c_init(OLED_I2C_BUS, OLED_SDA_PIN, OLED_SCL_PIN, OLED_I2C_FALLBACK_HZ);
+        stats.i2c_hz = OLED_I2C_FALLBACK_HZ;
+    }
     disp.external_vcc = false;
-    ssd1306_init(&disp, 128, 64, 0x3C, OLED_I2C_PORT);
-
-    // Configura os pinos de entrada para o joystick e botões.
-    adc_gpio_init(JOYSTICK_Y_PIN);
-    gpio_init(JOYSTICK_SW_PIN);
-    gpio_set_dir(JOYSTICK_SW_PIN, GPIO_IN);
-    gpio_pull_up(JOYSTICK_SW_PIN);
-    gpio_init(BUTTON_A_PIN);
-    gpio_set_dir(BUTTON_A_PIN, GPIO_IN);
-    gpio_pull_up(BUTTON_A_PIN);
-    
+    ssd1306_init(&disp, 128, 64, OLED_I2C_ADDR, i2c);
+
+    // Os botões e o joystick são configurados pelos módulos input_events e adc_service.
+
     // Exibe a tela de inicialização para uma experiência de boot limpa.
     ssd1306_clear(&disp);
     ssd1306_draw_string(&disp, 20, 16, 2, "SMAIV");
+    ssd1306_draw_image(&disp, 88, 16, img_speaker, true);
     ssd1306_draw_string(&disp, 16, 40, 1, "Inicializando...");
     ssd1306_show(&disp);
 }
 
+/**
+ * @brief Extrai do estado o modelo da tela ativa.
+ */
+static void build_view(const system_state_t *state, ui_view_t *view) {
+    memset(view, 0, sizeof(*view));
+    view->screen = (uint8_t)state->current_screen;
+    view->threshold = (int16_t)lrintf(state->sound_threshold);
+    if (state->current_screen == SCREEN_MAIN) {
+        view->level = (int16_t)lrintf(state->current_sound_level);
+        view->alert = state->alert_active;
+        view->mqtt = !state->alert_active && state->mqtt_connected;
+    } else if (state->current_screen == SCREEN_GRAPH) {
+        view->level = history.level / 2;
+        view->alert = state->alert_active;
+        view->history_seq = history.seq;
+        for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+            view->bars[b] = (uint8_t)((history.bands[b] >= LEVEL_FULL_SCALE ? LEVEL_FULL_SCALE : history.bands[b]) *
+                                      BARS_HEIGHT / LEVEL_FULL_SCALE);
+        }
+    }
+}
+
+/**
+ * @brief Registra uma medição no histórico do nível e nas barras das bandas.
+ * @details Usa as características quantizadas (0,5 dB por passo), o que mantém o
+ *          histórico em um byte por coluna.
+ */
+void ui_push_measurement(const measurement_t *m) {
+    history.level = (uint8_t)(m->features[AUDIO_FEATURE_LEVEL_DB] + 128);
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+        history.bands[b] = (uint8_t)(m->features[AUDIO_FEATURE_BAND_0 + b] + 128);
+    }
+
+    if (m->timestamp_ms - history.column_start_ms >= UI_HISTORY_COLUMN_MS) {
+        history.columns[history.head] = history.peak;
+        history.head = (uint8_t)((history.head + 1) % GRAPH_COLUMNS);
+        history.seq++;
+        history.peak = 0;
+        history.column_start_ms = m->timestamp_ms;
+    }
+    if (history.level > history.peak) {
+        history.peak = history.level;
+    }
+}
+
+/**
+ * @brief Desenha uma coluna do gráfico (barra vertical a partir da base).
+ */
+static void draw_history_column(uint32_t x, uint8_t value) {
+    uint32_t h = (value >= LEVEL_FULL_SCALE ? LEVEL_FULL_SCALE : value) * GRAPH_HEIGHT / LEVEL_FULL_SCALE;
+    ssd1306_draw_vline(&disp, x, GRAPH_BOTTOM_Y - h, h);
+}
+
+/**
+ * @brief Desenha a tela de histórico, de forma incremental quando possível.
+ * @details Ao entrar na tela, todas as colunas são desenhadas. Depois, o gráfico não é
+ *          redesenhado: a cada coluna nova, as páginas do gráfico são deslocadas uma
+ *          coluna para a esquerda no framebuffer e apenas a coluna da direita é desenhada.
+ *          O cabeçalho e as barras (3 páginas) são refeitos por máscaras de byte. O
+ *          deslocamento muda as 5 páginas do gráfico, que o driver reenvia uma vez por
+ *          coluna (~650 bytes por segundo); nos demais quadros só as barras e o número
+ *          vão para o barramento. O scroll horizontal do próprio SSD1306 não é usado: ele
+ *          é contínuo, cadenciado pelo oscilador do painel, e exige reescrever a RAM ao
+ *          ser interrompido, o que não se sincroniza com as colunas de 1 s.
+ */
+static void draw_graph_screen(const ui_view_t *view, bool full) {
+    uint32_t added = view->history_seq - graph_seq;
+    if (full || added >= GRAPH_COLUMNS) {
+        ssd1306_clear(&disp);
+        for (uint32_t x = 0; x < GRAPH_COLUMNS; x++) {
+            draw_history_column(x, history.columns[(history.head + x) % GRAPH_COLUMNS]);
+        }
+    } else if (added) {
+        ssd1306_scroll_left(&disp, GRAPH_FIRST_PAGE, GRAPH_LAST_PAGE, added);
+        for (uint32_t i = 0; i < added; i++) {
+            uint32_t x = GRAPH_COLUMNS - added + i;
+            draw_history_column(x, history.columns[(history.head + x) % GRAPH_COLUMNS]);
+        }
+    }
+    graph_seq = view->history_seq;
+
+    char buf[22];
+    fmt_t f;
+    ssd1306_clear_square(&disp, 0, 0, 128, 8);
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_i32_pad(&f, view->level, 3, ' ');
+    fmt_str(&f, " dB");
+    ssd1306_draw_string(&disp, 0, 0, 1, buf);
+    ssd1306_draw_string(&disp, 60, 0, 1, view->alert ? "ALERTA!" : "ultimos 2min");
+
+    ssd1306_clear_square(&disp, 0, BARS_TOP_Y, 128, BARS_HEIGHT);
+    for (int b = 0; b < AUDIO_NUM_BANDS; b++) {
+        ssd1306_draw_square(&disp, b * BAR_PITCH + 1, 64 - view->bars[b], BAR_PITCH - 2, view->bars[b]);
+    }
+}
+
 /**
  * @brief Desenha o conteúdo da tela principal de monitoramento.
  * @param state Ponteiro para o estado atual do sistema.
  */
 static void draw_main_screen(const system_state_t *state) {
     char buf[22];
-    sprintf(buf, "Nivel:%.0f Lim:%.0f", state->current_sound_level, state->sound_threshold);
+    fmt_t f;
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_str(&f, "Nivel:");
+    fmt_float(&f, state->current_sound_level, 0);
+    fmt_str(&f, " Lim:");
+    fmt_float(&f, state->sound_threshold, 0);
     ssd1306_draw_string(&disp, 0, 24, 1, buf);
 
     if (state->alert_active) {
         ssd1306_draw_string(&disp, 0, 48, 2, "ALERTA!");
+        ssd1306_draw_image(&disp, 100, 48, img_alert, true);
     } else {
-        sprintf(buf, "MQTT: %s", state->mqtt_connected ? "OK" : "---");
-        ssd1306_draw_string(&disp, 0, 48, 1, buf);
+        ssd1306_draw_string(&disp, 0, 48, 1, state->mqtt_connected ? "MQTT: OK" : "MQTT: ---");
     }
 }
 
@@ -71,70 +220,130 @@ static void draw_main_screen(const system_state_t *state) {
  */
 static void draw_settings_screen(const system_state_t *state) {
     char buf[20];
-    sprintf(buf, "Limiar: %.0f", state->sound_threshold);
+    fmt_t f;
+    fmt_init(&f, buf, sizeof(buf));
+    fmt_str(&f, "Limiar: ");
+    fmt_float(&f, state->sound_threshold, 0);
     ssd1306_draw_string(&disp, 0, 24, 2, buf);
     ssd1306_draw_string(&disp, 0, 48, 1, "Joy:Muda | BtnA:Salva");
 }
 
 /**
- * @brief Renderiza a tela completa no display OLED.
- * @details Esta função é chamada a cada ciclo do loop principal para manter a UI atualizada.
- *          Ela limpa o buffer, desenha o conteúdo da tela ativa e o envia para o display.
+ * @brief Renderiza a tela no display OLED quando algo visível mudou.
+ * @details Chamada a cada período da tarefa de UI e quando o estado muda. O modelo da tela
+ *          é comparado com o do último quadro: sem mudança, nada é desenhado nem enviado.
+ *          Uma mudança é adiada (e reavaliada na próxima chamada) se o último quadro foi
+ *          enviado há menos de 1/UI_MAX_FPS s ou ainda está no barramento, pois o envio é
+ *          assíncrono (DMA).
  * @param state Ponteiro para o estado do sistema, usado para decidir qual tela desenhar.
  */
 void ui_draw(const system_state_t *state) {
-    ssd1306_clear(&disp);
-    
-    // Desenha um título comum a ambas as telas.
-    const char* title = (state->current_screen == SCREEN_MAIN) ? "SMAIV" : "Ajustes";
-    ssd1306_draw_string(&disp, 0, 0, 2, title);
+    // Tempo de barramento do quadro anterior, assim que o envio termina.
+    if (tx_pending && !ssd1306_busy(&disp)) {
+        tx_pending = false;
+        if (disp.tx_us) {
+            PROF_RECORD(PROF_DISPLAY_TX, disp.tx_us);
+            stats.tx_frames++;
+            stats.tx_us_total += disp.tx_us;
+            if (disp.tx_us > stats.tx_us_max) {
+                stats.tx_us_max = disp.tx_us;
+            }
+        }
+    }
 
-    // Chama a função de desenho específica para a tela atual.
-    if (state->current_screen == SCREEN_MAIN) {
-        draw_main_screen(state);
+    ui_view_t view;
+    build_view(state, &view);
+    if (last_view_valid && memcmp(&view, &last_view, sizeof(view)) == 0) {
+        stats.frames_unchanged++;
+        return;
+    }
+
+    uint32_t now = hal_time_ms();
+    if ((last_view_valid && now - last_frame_ms < 1000u / UI_MAX_FPS) || ssd1306_busy(&disp)) {
+        stats.frames_deferred++;
+        return;
+    }
+
+    uint32_t t0 = hal_time_us_32();
+    if (state->current_screen == SCREEN_GRAPH) {
+        draw_graph_screen(&view, !last_view_valid || last_view.screen != SCREEN_GRAPH);
     } else {
-        draw_settings_screen(state);
+        ssd1306_clear(&disp);
+
+        // Desenha um título comum às telas de texto.
+        const char* title = (state->current_screen == SCREEN_MAIN) ? "SMAIV" : "Ajustes";
+        ssd1306_draw_string(&disp, 0, 0, 2, title);
+
+        // Chama a função de desenho específica para a tela atual.
+        if (state->current_screen == SCREEN_MAIN) {
+            draw_main_screen(state);
+        } else {
+            draw_settings_screen(state);
+        }
     }
     
-    // Envia o conteúdo do buffer de vídeo para o hardware do display.
-    ssd1306_show(&disp);
+    // Inicia o envio das áreas alteradas; o buffer já pode ser redesenhado no próximo quadro.
+    tx_pending = ssd1306_show_async(&disp);
+    uint32_t draw_us = hal_time_us_32() - t0;
+
+    last_view = view;
+    last_view_valid = true;
+    last_frame_ms = now;
+    stats.frames_sent++;
+    stats.draw_us_total += draw_us;
+    if (draw_us > stats.draw_us_max) {
+        stats.draw_us_max = draw_us;
+    }
+    stats.i2c_bytes += disp.tx_bytes;
+}
+
+void ui_get_stats(ui_stats_t *out) {
+    *out = stats;
 }
 
 /**
- * @brief Processa as entradas do usuário e atualiza o estado do sistema.
- * @details Lida com a navegação entre telas (via botão do joystick) e o ajuste de
- *          parâmetros (via eixo do joystick).
+ * @brief Aplica um evento de entrada ao estado do sistema.
+ * @details Lida com a navegação entre telas (botão do joystick para os ajustes, eixo
+ *          para baixo/cima entre a tela principal e o histórico) e o ajuste de
+ *          parâmetros (via eixo do joystick: um passo ao empurrar e passos repetidos
+ *          enquanto mantido). O debounce já foi feito pelo módulo input_events.
  * @param state Ponteiro para a estrutura de estado, que será modificada pela função.
+ * @param evt Evento de entrada filtrado.
  */
-void ui_update_input(system_state_t *state) {
-    // Lê o estado dos botões (pinos são pull-up, 'false' significa pressionado).
-    bool joy_sw_pressed = !gpio_get(JOYSTICK_SW_PIN);
-    bool btn_a_pressed = !gpio_get(BUTTON_A_PIN);
+void ui_handle_input(system_state_t *state, const input_event_t *evt) {
+    bool step = (evt->type == INPUT_EVT_PRESS || evt->type == INPUT_EVT_LONG_PRESS ||
+                 evt->type == INPUT_EVT_REPEAT);
 
     // Lógica de navegação de tela.
-    if (state->current_screen == SCREEN_MAIN && joy_sw_pressed) {
-        state->current_screen = SCREEN_SETTINGS;
-        sleep_ms(200); // Debounce para evitar trocas múltiplas.
-        return;
-    }
-    if (state->current_screen == SCREEN_SETTINGS && btn_a_pressed) {
-        state->current_screen = SCREEN_MAIN;
-        sleep_ms(200);
-        return;
+    if (evt->type == INPUT_EVT_PRESS) {
+        if (state->current_screen == SCREEN_MAIN && evt->input == INPUT_JOY_SW) {
+            state->current_screen = SCREEN_SETTINGS;
+            return;
+        }
+        if (state->current_screen == SCREEN_SETTINGS && evt->input == INPUT_BUTTON_A) {
+            state->current_screen = SCREEN_MAIN;
+            return;
+        }
+        if (state->current_screen == SCREEN_MAIN && evt->input == INPUT_JOY_DOWN) {
+            state->current_screen = SCREEN_GRAPH;
+            return;
+        }
+        if (state->current_screen == SCREEN_GRAPH &&
+            (evt->input == INPUT_JOY_UP || evt->input == INPUT_BUTTON_A)) {
+            state->current_screen = SCREEN_MAIN;
+            return;
+        }
     }
 
     // Lógica de ajuste de valor, apenas na tela de configurações.
-    if (state->current_screen == SCREEN_SETTINGS) {
-        adc_select_input(0); // Canal ADC para o eixo Y do Joystick.
-        uint16_t joy_y = adc_read();
-        
-        // Altera o limiar com base na posição do joystick.
-        if (joy_y > 3000) { 
+    if (state->current_screen == SCREEN_SETTINGS && step) {
+        // Altera o limiar com base na direção do joystick.
+        if (evt->input == INPUT_JOY_UP) {
             state->sound_threshold += 5.0f;
-        } else if (joy_y < 1000) { 
+        } else if (evt->input == INPUT_JOY_DOWN) {
             state->sound_threshold -= 5.0f;
         }
-        
+
         // Garante que o valor do limiar permaneça dentro de limites seguros.
         if (state->sound_threshold < 10.0f) state->sound_threshold = 10.0f;
         if (state->sound_threshold > 999.0f) state->sound_threshold = 999.0f;
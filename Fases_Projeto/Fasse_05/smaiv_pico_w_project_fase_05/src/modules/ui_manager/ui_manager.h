@@ -2,9 +2,32 @@
 #define UI_MANAGER_H
 
 #include "common.h"
+#include "modules/input_events/input_events.h"
+
+/**
+ * @brief Contadores de renderização do display.
+ */
+typedef struct {
+    uint32_t frames_sent;       ///< Quadros desenhados e enviados ao display.
+    uint32_t frames_unchanged;  ///< Chamadas de ui_draw() sem mudança visível.
+    uint32_t frames_deferred;   ///< Mudanças adiadas pelo limite UI_MAX_FPS ou pelo I2C ocupado.
+    uint32_t draw_us_total;     ///< Tempo de CPU somado dos quadros enviados (desenho e início do envio).
+    uint32_t draw_us_max;       ///< Maior tempo de CPU de um quadro.
+    uint32_t i2c_bytes;         ///< Bytes enviados ao display (comandos e dados).
+    uint32_t i2c_hz;            ///< Frequência do barramento do display (após a sondagem).
+    uint32_t tx_frames;         ///< Envios concluídos com tempo de barramento medido.
+    uint32_t tx_us_total;       ///< Tempo de barramento somado desses envios.
+    uint32_t tx_us_max;         ///< Maior tempo de barramento de um quadro.
+} ui_stats_t;
 
 void ui_init(void);
-void ui_update_input(system_state_t *state);
+void ui_handle_input(system_state_t *state, const input_event_t *evt);
 void ui_draw(const system_state_t *state);
 
+/**
+ * @brief Alimenta o histórico da tela de gráfico (chamada a cada medição do Core 1).
+ */
+void ui_push_measurement(const measurement_t *m);
+void ui_get_stats(ui_stats_t *out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Compara duas execuções do benchmark de DSP (smaiv_bench) e acusa regressões.
+
+Entrada: as linhas JSON impressas pelo benchmark (src/bench/dsp_bench.c), no host
+(`./build-host/smaiv_bench > atual.jsonl`) ou capturadas da serial USB do firmware
+smaiv_bench. Linhas que não são JSON (log de inicialização) são ignoradas, de modo
+que a captura da serial pode ser usada sem edição.
+
+Para cada kernel presente nas duas execuções e na mesma plataforma, compara a
+mediana dos ciclos (menos sensível que a média a interrupções e, no host, ao
+escalonador do sistema). É regressão:
+  - mediana maior que a de referência além da tolerância (--tolerance, em %) e
+    de um mínimo absoluto (--min-delta, em ciclos), pois kernels muito curtos
+    ficam abaixo da resolução do relógio no host;
+  - quadro completo no pior caso acima do orçamento de AUDIO_FRAME_MS.
+Mudança de checksum (saída do kernel diferente) é apenas avisada, pois alterações
+intencionais no DSP também a provocam.
+
+Saída 0 sem regressões, 1 com regressões e 2 em caso de entrada inválida.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                entry = json.loads(line)
+            except ValueError:
+                continue
+            if "bench" in entry:
+                results[(entry.get("platform", "?"), entry["bench"])] = entry
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="execucao de referencia (.jsonl)")
+    parser.add_argument("current", help="execucao a avaliar (.jsonl)")
+    parser.add_argument("--tolerance", type=float, default=10.0,
+                        help="aumento maximo da mediana de ciclos, em %% (padrao: 10)")
+    parser.add_argument("--min-delta", type=int, default=50,
+                        help="aumento minimo, em ciclos, para acusar regressao (padrao: 50)")
+    args = parser.parse_args()
+
+    base, cur = load(args.baseline), load(args.current)
+    if not cur:
+        print("nenhum resultado em %s" % args.current, file=sys.stderr)
+        sys.exit(2)
+
+    regressions = 0
+    print("%-8s %-18s %10s %10s %8s" % ("plat", "kernel", "ref", "atual", "delta"))
+    for key in sorted(cur):
+        platform, name = key
+        entry = cur[key]
+        if name == "summary":
+            continue
+        if "skipped" in entry:
+            print("%-8s %-18s %10s %10s %8s" % (platform, name, "-", "-", "pulado"))
+            continue
+        ref = base.get(key)
+        if ref is None or "median" not in ref:
+            print("%-8s %-18s %10s %10d %8s" % (platform, name, "-", entry["median"], "novo"))
+            continue
+        delta = 100.0 * (entry["median"] - ref["median"]) / max(ref["median"], 1)
+        flag = ""
+        if delta > args.tolerance and entry["median"] - ref["median"] >= args.min_delta:
+            flag = "  REGRESSAO"
+            regressions += 1
+        if entry.get("checksum") != ref.get("checksum"):
+            flag += "  (saida mudou)"
+        print("%-8s %-18s %10d %10d %+7.1f%%%s" % (platform, name, ref["median"], entry["median"], delta, flag))
+
+    for (platform, name), entry in sorted(cur.items()):
+        if name != "summary":
+            continue
+        print("%s: quadro medio %.1f us, pior %.1f us de %.0f us (%.1f%% / %.1f%%)" % (
+            platform, entry["frame_mean_us"], entry["frame_max_us"], entry["frame_budget_us"],
+            entry["load_pct"], entry["worst_pct"]))
+        if entry["worst_pct"] >= 100.0:
+            print("%s: pior caso do quadro excede o orcamento  REGRESSAO" % platform)
+            regressions += 1
+
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Decodifica os vetores de características publicados em smaiv/features.
+
+Aceita arquivos binários com um ou mais pacotes concatenados, ou linhas em
+hexadecimal na entrada padrão (ex.: `mosquitto_sub -t smaiv/features -F %x`).
+
+Além de imprimir os valores em unidades físicas, verifica a coerência de cada
+fatia com o cálculo do firmware (audio_features.c): a energia somada das bandas
+não pode passar do nível RMS e o centroide deve cair dentro da faixa analisada.
+
+Cada fatia traz a média em dB dos seus quadros, ou seja, a média geométrica das
+potências. Como ela é superaditiva, a energia das bandas de uma fatia fica abaixo
+do nível quando o espectro muda de banda dentro da fatia (varredura, estalos) e
+só o reproduz em fatias estacionárias; por isso a verificação é de um lado só.
+Com --check, só as inconsistências e um resumo são impressos.
+"""
+import argparse
+import math
+import struct
+import sys
+
+MAGIC = 0x46  # 'F'
+VERSION = 1
+HEADER = struct.Struct("<BBHIBBBB")
+NUM_BANDS = 8
+BAND_EDGES_HZ = [31, 62, 125, 250, 500, 1000, 2000, 3000, 4000]
+CLASSES = ["speech", "music", "alarm", "impact", "machinery", "glass"]
+
+# Mesma ordem e escalas de audio_feature_t / audio_feature_scale.
+FEATURES = [("level_db", 0.5), ("zcr", 1.0 / 255.0), ("crest_db", 0.25),
+            ("centroid_hz", 16.0), ("flux_db", 0.5)] + \
+           [("band%d_db" % i, 0.5) for i in range(NUM_BANDS)]
+
+# Tolerância da verificação de energia: quantização (0,5 dB) e vazamento da janela.
+ENERGY_TOLERANCE_DB = 3.0
+
+
+def dequantize(raw):
+    return {name: (q + 128) * scale for (name, scale), q in zip(FEATURES, raw)}
+
+
+def check_slot(slot):
+    problems = []
+    band_power = sum(10 ** (slot["band%d_db" % i] / 10.0) for i in range(NUM_BANDS))
+    band_db = 10 * math.log10(band_power) if band_power > 0 else 0.0
+    if slot["level_db"] > 6.0 and band_db - slot["level_db"] > ENERGY_TOLERANCE_DB:
+        problems.append("energia das bandas %.1f dB acima do nivel %.1f dB" % (band_db, slot["level_db"]))
+    if slot["level_db"] > 6.0 and not BAND_EDGES_HZ[0] - 16 <= slot["centroid_hz"] <= BAND_EDGES_HZ[-1]:
+        problems.append("centroide %.0f Hz fora da faixa" % slot["centroid_hz"])
+    if not 0.0 <= slot["zcr"] <= 1.0:
+        problems.append("zcr fora de [0, 1]")
+    return problems
+
+
+def decode(data, last_seq):
+    """Decodifica todos os pacotes de `data`; retorna (pacotes, erros, última sequência)."""
+    packets, errors, off = [], 0, 0
+    while off + HEADER.size <= len(data):
+        magic, version, seq, ts, slots, nfeat, frames, cls = HEADER.unpack_from(data, off)
+        if magic != MAGIC or version != VERSION:
+            print("offset %d: cabecalho invalido" % off, file=sys.stderr)
+            return packets, errors + 1, last_seq
+        if nfeat != len(FEATURES):
+            print("seq %d: %d caracteristicas (esperado %d)" % (seq, nfeat, len(FEATURES)), file=sys.stderr)
+            return packets, errors + 1, last_seq
+        body = data[off + HEADER.size: off + HEADER.size + slots * nfeat]
+        if len(body) != slots * nfeat:
+            print("seq %d: pacote truncado" % seq, file=sys.stderr)
+            return packets, errors + 1, last_seq
+        if last_seq is not None and seq != (last_seq + 1) & 0xFFFF:
+            print("seq %d: %d pacote(s) perdido(s)" % (seq, (seq - last_seq - 1) & 0xFFFF), file=sys.stderr)
+        last_seq = seq
+
+        raw = struct.unpack("<%db" % len(body), body)
+        slot_list = []
+        for s in range(slots):
+            slot = dequantize(raw[s * nfeat:(s + 1) * nfeat])
+            for p in check_slot(slot):
+                print("seq %d fatia %d: %s" % (seq, s, p), file=sys.stderr)
+                errors += 1
+            slot_list.append(slot)
+
+        packets.append({"seq": seq, "timestamp_ms": ts, "frames_per_slot": frames,
+                        "class": CLASSES[cls] if cls < len(CLASSES) else "unknown",
+                        "slots": slot_list})
+        off += HEADER.size + len(body)
+    return packets, errors, last_seq
+
+
+def print_packet(pkt):
+    print("seq=%d t=%d ms classe=%s" % (pkt["seq"], pkt["timestamp_ms"], pkt["class"]))
+    for i, slot in enumerate(pkt["slots"]):
+        bands = " ".join("%5.1f" % slot["band%d_db" % b] for b in range(NUM_BANDS))
+        print("  [%d] nivel=%5.1f dB zcr=%.3f crista=%5.2f dB centroide=%6.0f Hz fluxo=%5.1f dB | %s" % (
+            i, slot["level_db"], slot["zcr"], slot["crest_db"], slot["centroid_hz"], slot["flux_db"], bands))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("files", nargs="*", help="arquivos binarios (padrao: hex na entrada padrao)")
+    parser.add_argument("--check", action="store_true",
+                        help="so verifica: imprime as inconsistencias e um resumo")
+    args = parser.parse_args()
+
+    chunks = [open(f, "rb").read() for f in args.files] if args.files else \
+        [bytes.fromhex(line.strip()) for line in sys.stdin if line.strip()]
+
+    total_errors, total_packets, total_slots, last_seq = 0, 0, 0, None
+    for chunk in chunks:
+        packets, errors, last_seq = decode(chunk, last_seq)
+        total_errors += errors
+        total_packets += len(packets)
+        total_slots += sum(len(pkt["slots"]) for pkt in packets)
+        if not args.check:
+            for pkt in packets:
+                print_packet(pkt)
+    if args.check:
+        print("%d pacotes, %d fatias, %d inconsistencias" % (total_packets, total_slots, total_errors))
+
+    sys.exit(1 if total_errors else 0)
+
+
+if __name__ == "__main__":
+    main()
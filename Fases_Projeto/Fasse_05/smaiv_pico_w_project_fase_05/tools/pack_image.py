@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""Converte imagens monocromáticas para o formato de páginas do SSD1306.
+
+Formatos de entrada: PBM/PGM (P1, P2, P4, P5) e BMP sem compressão (1, 4, 8, 24 ou
+32 bits). Com o Pillow instalado, qualquer formato que ele abra também é aceito.
+
+Pixels escuros acendem no display (luminância abaixo de --threshold), como no PBM,
+em que 1 é preto; --invert troca a convenção. Assim as telas gravadas pela
+simulação de host (display.pbm) podem ser convertidas de volta sem alterações.
+
+Saída: arquivo C com um `const uint8_t <prefixo><nome>[]` por imagem, no layout da
+memória do controlador, desenhado por ssd1306_draw_image():
+
+    largura, altura,
+    página 0: `largura` bytes (coluna a coluna, bit 0 = linha de cima),
+    página 1: ...                   ((altura + 7) / 8 páginas)
+
+Os bits abaixo da altura na última página ficam zerados.
+
+    python3 tools/pack_image.py assets/icons/*.pbm -o src/modules/ui_manager/ui_images.c
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAX_SIZE = 255  # Largura e altura são gravadas em um byte.
+
+
+def read_netpbm(data):
+    """Lê PBM/PGM; devolve (largura, altura, linhas de luminância 0-255)."""
+    tokens = []
+    pos = 0
+
+    def next_token():
+        nonlocal pos
+        while True:
+            while pos < len(data) and data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b"#":
+                while pos < len(data) and data[pos:pos + 1] not in (b"\n", b"\r"):
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos]
+
+    magic = next_token()
+    width = int(next_token())
+    height = int(next_token())
+    maxval = 1 if magic in (b"P1", b"P4") else int(next_token())
+    pos += 1  # Um único espaço antes dos dados binários.
+
+    if magic == b"P1":
+        bits = re.findall(rb"[01]", data[pos:])
+        if len(bits) < width * height:
+            raise ValueError("PBM incompleto")
+        return width, height, [[0 if bits[y * width + x] == b"1" else 255
+                                for x in range(width)] for y in range(height)]
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            row = data[pos + y * stride:pos + (y + 1) * stride]
+            if len(row) < stride:
+                raise ValueError("PBM incompleto")
+            rows.append([0 if (row[x >> 3] >> (7 - (x & 7))) & 1 else 255 for x in range(width)])
+        return width, height, rows
+    if magic == b"P2":
+        values = [int(v) for v in data[pos:].split()]
+    elif magic == b"P5":
+        if maxval > 255:
+            raise ValueError("PGM de 16 bits não suportado")
+        values = list(data[pos:pos + width * height])
+    else:
+        raise ValueError("formato Netpbm não suportado: %r" % magic)
+    if len(values) < width * height:
+        raise ValueError("PGM incompleto")
+    return width, height, [[values[y * width + x] * 255 // maxval for x in range(width)]
+                           for y in range(height)]
+
+
+def read_bmp(data):
+    """Lê BMP sem compressão; devolve (largura, altura, linhas de luminância 0-255)."""
+    off_bits, = struct.unpack_from("<I", data, 10)
+    header_size, width, height, _, bit_count, compression = struct.unpack_from("<IiiHHI", data, 14)
+    if compression != 0:
+        raise ValueError("BMP comprimido não suportado")
+    if bit_count not in (1, 4, 8, 24, 32):
+        raise ValueError("BMP de %d bits não suportado" % bit_count)
+    bottom_up = height > 0
+    height = abs(height)
+
+    palette = []
+    if bit_count <= 8:
+        colors, = struct.unpack_from("<I", data, 46)
+        colors = colors or (1 << bit_count)
+        table = 14 + header_size
+        for i in range(colors):
+            b, g, r = data[table + i * 4:table + i * 4 + 3]
+            palette.append((r * 299 + g * 587 + b * 114) // 1000)
+
+    stride = (width * bit_count + 31) // 32 * 4
+    rows = []
+    for y in range(height):
+        line = data[off_bits + (height - 1 - y if bottom_up else y) * stride:][:stride]
+        row = []
+        for x in range(width):
+            if bit_count <= 8:
+                bit = x * bit_count
+                index = (line[bit >> 3] >> (8 - bit_count - (bit & 7))) & ((1 << bit_count) - 1)
+                row.append(palette[index])
+            else:
+                b, g, r = line[x * bit_count // 8:x * bit_count // 8 + 3]
+                row.append((r * 299 + g * 587 + b * 114) // 1000)
+        rows.append(row)
+    return width, height, rows
+
+
+def read_pillow(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError("formato não reconhecido (instale o Pillow para outros formatos)")
+    image = Image.open(path).convert("L")
+    width, height = image.size
+    pixels = list(image.getdata())
+    return width, height, [pixels[y * width:(y + 1) * width] for y in range(height)]
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:2] in (b"P1", b"P2", b"P4", b"P5"):
+        return read_netpbm(data)
+    if data[:2] == b"BM":
+        return read_bmp(data)
+    return read_pillow(path)
+
+
+def pack(width, height, rows, threshold, invert):
+    """Gera os bytes no formato de ssd1306_draw_image()."""
+    if not 0 < width <= MAX_SIZE or not 0 < height <= MAX_SIZE:
+        raise ValueError("imagem de %dx%d fora do limite de %d pixels" % (width, height, MAX_SIZE))
+    out = bytearray([width, height])
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and (rows[y][x] < threshold) != invert:
+                    byte |= 1 << bit
+            out.append(byte)
+    return bytes(out)
+
+
+def c_name(prefix, path):
+    stem = os.path.splitext(os.path.basename(path))[0]
+    return prefix + re.sub(r"\W", "_", stem)
+
+
+def emit_c(images, out):
+    out.write("/* Gerado por tools/pack_image.py - nao editar. */\n")
+    out.write("#include <stdint.h>\n")
+    for name, source, blob in images:
+        out.write("\n/* %s: %dx%d */\n" % (source, blob[0], blob[1]))
+        out.write("const uint8_t %s[%d] = {\n" % (name, len(blob)))
+        out.write("    %d, %d,\n" % (blob[0], blob[1]))
+        for i in range(2, len(blob), blob[0]):
+            page = blob[i:i + blob[0]]
+            for j in range(0, len(page), 16):
+                out.write("    " + ", ".join("0x%02x" % b for b in page[j:j + 16]) + ",\n")
+        out.write("};\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("images", nargs="+")
+    parser.add_argument("-o", "--output", default="-")
+    parser.add_argument("--prefix", default="img_", help="prefixo dos nomes em C (padrão: img_)")
+    parser.add_argument("--threshold", type=int, default=128,
+                        help="luminância abaixo da qual o pixel acende (padrão: 128)")
+    parser.add_argument("--invert", action="store_true", help="acende os pixels claros")
+    args = parser.parse_args()
+
+    images = []
+    for path in args.images:
+        try:
+            width, height, rows = read_image(path)
+            blob = pack(width, height, rows, args.threshold, args.invert)
+        except (OSError, ValueError, struct.error) as e:
+            print("%s: %s" % (path, e), file=sys.stderr)
+            return 1
+        images.append((c_name(args.prefix, path), os.path.basename(path), blob))
+
+    if args.output == "-":
+        emit_c(images, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            emit_c(images, f)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
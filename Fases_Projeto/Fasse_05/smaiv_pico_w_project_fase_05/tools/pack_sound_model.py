@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Empacota um modelo int8 quantizado no formato "SMNN" lido pelo firmware.
+
+Entrada: JSON com os parâmetros já quantizados (pesos int8 simétricos, bias int32):
+
+    {
+      "input": {"len": 32, "ch": 3, "zero_point": -128},
+      "layers": [
+        {"type": "dwconv1d", "kernel": 5, "stride": 2, "activation": "relu",
+         "input_zero_point": -128, "output_zero_point": -128,
+         "scale": 0.0123,              # escala efetiva s_in * s_w / s_out
+         "weights": [[...], ...],      # [kernel][ch]
+         "bias": [...]},               # [ch]
+        {"type": "dense", "units": 6, ...,
+         "weights": [[...], ...],      # [units][in_len * in_ch]
+         "bias": [...]}
+      ]
+    }
+
+No lugar de "scale" é possível informar "multiplier" (Q31) e "shift" diretamente.
+O zero-point da entrada de cada camada é incorporado ao bias aqui, para que os
+kernels do firmware façam apenas acc = bias + sum(x * w).
+
+Saída: arquivo C com `sound_model_blob` e `sound_model_blob_size`, a ser passado
+ao CMake com -DSMAIV_SOUND_MODEL=<arquivo.c>.
+"""
+import argparse
+import json
+import math
+import struct
+import sys
+
+MAGIC = b"SMNN"
+VERSION = 1
+HEADER_SIZE = 16
+DESC_SIZE = 32
+LAYER_TYPES = {"dense": 1, "dwconv1d": 2}
+ACTIVATIONS = {"none": 0, "relu": 1}
+
+
+def quantize_scale(scale):
+    """Converte uma escala real em (multiplier Q31, shift) como em nn_requantize()."""
+    if scale <= 0:
+        raise ValueError("escala deve ser positiva")
+    mantissa, exponent = math.frexp(scale)  # scale = mantissa * 2^exponent, 0.5 <= m < 1
+    multiplier = int(round(mantissa * (1 << 31)))
+    if multiplier == (1 << 31):
+        multiplier //= 2
+        exponent += 1
+    shift = -exponent
+    if not -30 <= shift <= 31:
+        raise ValueError("escala fora do intervalo suportado: %g" % scale)
+    return multiplier, shift
+
+
+def check_int8(values, what):
+    for v in values:
+        if not -128 <= v <= 127:
+            raise ValueError("%s fora do intervalo int8: %d" % (what, v))
+
+
+def pack(spec):
+    in_len = spec["input"]["len"]
+    in_ch = spec["input"]["ch"]
+    layers = spec["layers"]
+    descs = []
+    payload = bytearray()
+    data_base = HEADER_SIZE + DESC_SIZE * len(layers)
+
+    for i, layer in enumerate(layers):
+        kind = LAYER_TYPES[layer["type"]]
+        act = ACTIVATIONS[layer.get("activation", "none")]
+        zp_in = layer.get("input_zero_point", 0)
+        w = layer["weights"]
+        bias = list(layer["bias"])
+
+        if kind == LAYER_TYPES["dense"]:
+            out_len, out_ch = 1, layer["units"]
+            kernel = stride = 0
+            if len(w) != out_ch or any(len(row) != in_len * in_ch for row in w):
+                raise ValueError("camada %d: pesos dense devem ser [units][in_len*in_ch]" % i)
+            flat = [v for row in w for v in row]
+            bias = [b - zp_in * sum(row) for b, row in zip(bias, w)]
+        else:
+            kernel, stride = layer["kernel"], layer.get("stride", 1)
+            out_len, out_ch = (in_len - kernel) // stride + 1, in_ch
+            if len(w) != kernel or any(len(row) != in_ch for row in w):
+                raise ValueError("camada %d: pesos dwconv1d devem ser [kernel][ch]" % i)
+            flat = [v for row in w for v in row]
+            bias = [b - zp_in * sum(w[k][c] for k in range(kernel)) for c, b in enumerate(bias)]
+
+        if len(bias) != out_ch:
+            raise ValueError("camada %d: bias deve ter %d valores" % (i, out_ch))
+        check_int8(flat, "peso")
+
+        if "scale" in layer:
+            multiplier, shift = quantize_scale(layer["scale"])
+        else:
+            multiplier, shift = layer["multiplier"], layer["shift"]
+
+        w_off = data_base + len(payload)
+        payload += struct.pack("<%db" % len(flat), *flat)
+        while (data_base + len(payload)) % 4:
+            payload += b"\0"
+        b_off = data_base + len(payload)
+        payload += struct.pack("<%di" % len(bias), *bias)
+
+        descs.append(struct.pack("<BBBBHHHHbbHiIII", kind, act, kernel, stride,
+                                 in_len, in_ch, out_len, out_ch,
+                                 layer.get("output_zero_point", 0), shift, 0,
+                                 multiplier, w_off, b_off, 0))
+        in_len, in_ch = out_len, out_ch
+
+    header = MAGIC + struct.pack("<BBBbHHI", VERSION, len(layers), in_ch,
+                                 spec["input"].get("zero_point", 0),
+                                 spec["input"]["len"], spec["input"]["ch"], 0)
+    return header + b"".join(descs) + bytes(payload)
+
+
+def emit_c(blob, out):
+    out.write("/* Gerado por tools/pack_sound_model.py - nao editar. */\n")
+    out.write("#include <stdint.h>\n\n")
+    out.write("__attribute__((aligned(4))) const uint8_t sound_model_blob[%d] = {\n" % len(blob))
+    for i in range(0, len(blob), 12):
+        out.write("    " + ", ".join("0x%02x" % b for b in blob[i:i + 12]) + ",\n")
+    out.write("};\n")
+    out.write("const uint32_t sound_model_blob_size = %d;\n" % len(blob))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("model_json")
+    parser.add_argument("-o", "--output", default="-")
+    args = parser.parse_args()
+
+    with open(args.model_json) as f:
+        blob = pack(json.load(f))
+
+    if args.output == "-":
+        emit_c(blob, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            emit_c(blob, f)
+
+
+if __name__ == "__main__":
+    main()